@@ -0,0 +1,84 @@
+#include "comp6771/compact_euclidean_vector.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+// Speed against accuracy for each compact storage format, with the double euclidean_vector as the
+// baseline. The data looks like a pair of similar embeddings: normally distributed magnitudes,
+// with y a noisy copy of x, so their dot product is well away from zero. relative_error is
+// measured against the dot product of the original double vectors. Bytes processed counts the
+// stored elements, so the larger sizes show how much of the speed-up is bandwidth.
+namespace {
+	auto make_embeddings(int dimensions)
+	   -> std::pair<comp6771::euclidean_vector, comp6771::euclidean_vector> {
+		auto engine = std::mt19937_64(6771);
+		auto normal = std::normal_distribution(0.0, 1.0);
+		auto x = comp6771::euclidean_vector(dimensions, [&](int) { return normal(engine); });
+		auto y = comp6771::euclidean_vector(dimensions, [&](int i) {
+			return x[i] + 0.5 * normal(engine);
+		});
+		return {std::move(x), std::move(y)};
+	}
+
+	auto size_range(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(64)->Range(1 << 10, 1 << 22);
+	}
+
+	auto set_counters(benchmark::State& state,
+	                  double result,
+	                  double reference,
+	                  std::size_t bytes_per_dimension) -> void {
+		state.counters["relative_error"] = std::fabs((result - reference) / reference);
+		state.SetBytesProcessed(state.iterations() * state.range(0)
+		                        * static_cast<std::int64_t>(bytes_per_dimension));
+	}
+
+	auto bm_dot_double(benchmark::State& state) -> void {
+		auto const [x, y] = make_embeddings(static_cast<int>(state.range(0)));
+		auto const xv = comp6771::const_euclidean_vector_view(x);
+		auto const yv = comp6771::const_euclidean_vector_view(y);
+		auto result = 0.0;
+		for (auto _ : state) {
+			result = comp6771::dot(xv, yv);
+			benchmark::DoNotOptimize(result);
+		}
+		set_counters(state, result, comp6771::dot(xv, yv, comp6771::reduction::compensated), 16);
+	}
+	BENCHMARK(bm_dot_double)->Apply(size_range);
+
+	template<typename T>
+	auto bm_dot(benchmark::State& state) -> void {
+		auto const [x, y] = make_embeddings(static_cast<int>(state.range(0)));
+		auto const cx = comp6771::compact_euclidean_vector<T>(x);
+		auto const cy = comp6771::compact_euclidean_vector<T>(y);
+		auto result = 0.0;
+		for (auto _ : state) {
+			result = comp6771::dot(cx, cy);
+			benchmark::DoNotOptimize(result);
+		}
+		auto const reference = comp6771::dot(x, y, comp6771::reduction::compensated);
+		set_counters(state, result, reference, 2 * sizeof(T));
+	}
+	BENCHMARK_TEMPLATE(bm_dot, float)->Apply(size_range);
+	BENCHMARK_TEMPLATE(bm_dot, comp6771::bfloat16)->Apply(size_range);
+	BENCHMARK_TEMPLATE(bm_dot, std::int8_t)->Apply(size_range);
+
+	template<typename T>
+	auto bm_euclidean_norm(benchmark::State& state) -> void {
+		auto const x = make_embeddings(static_cast<int>(state.range(0))).first;
+		auto const cx = comp6771::compact_euclidean_vector<T>(x);
+		auto result = 0.0;
+		for (auto _ : state) {
+			result = comp6771::euclidean_norm(cx);
+			benchmark::DoNotOptimize(result);
+		}
+		auto const reference = comp6771::euclidean_norm(x, comp6771::reduction::compensated);
+		set_counters(state, result, reference, sizeof(T));
+	}
+	BENCHMARK_TEMPLATE(bm_euclidean_norm, float)->Apply(size_range);
+	BENCHMARK_TEMPLATE(bm_euclidean_norm, comp6771::bfloat16)->Apply(size_range);
+	BENCHMARK_TEMPLATE(bm_euclidean_norm, std::int8_t)->Apply(size_range);
+} // namespace
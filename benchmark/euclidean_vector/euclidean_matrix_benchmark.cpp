@@ -0,0 +1,115 @@
+#include "comp6771/euclidean_matrix.hpp"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+// Batched dot, euclidean_norm and unit over rows vectors of a few dimensions, stored either as a
+// std::vector<euclidean_vector> (one allocation per vector) or in a euclidean_matrix.
+namespace {
+	auto constexpr rows = 1 << 16;
+
+	// dimensions from 4 (far below euclidean_vector::inline_capacity) to 256 (far above it)
+	auto dimension_range(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMicrosecond);
+	}
+
+	auto dimensions_of(benchmark::State const& state) -> int {
+		return static_cast<int>(state.range(0));
+	}
+
+	auto set_elements_processed(benchmark::State& state) -> void {
+		state.SetItemsProcessed(state.iterations() * rows * state.range(0));
+	}
+
+	// every vector is different, so nothing can be hoisted out of the loops
+	auto make_vectors(int dimensions) -> std::vector<comp6771::euclidean_vector> {
+		auto result = std::vector<comp6771::euclidean_vector>();
+		result.reserve(rows);
+		for (auto i = 0; i < rows; ++i) {
+			result.emplace_back(dimensions, [i](int j) { return 1.0 + (i + j) % 7; });
+		}
+		return result;
+	}
+
+	enum class storage { vector_of_vectors, row_major, column_major };
+
+	auto layout_of(storage s) -> comp6771::matrix_layout {
+		return s == storage::column_major ? comp6771::matrix_layout::column_major
+		                                  : comp6771::matrix_layout::row_major;
+	}
+
+	//---------------------------------------dot-----------------------------------------------
+	auto bm_dot(benchmark::State& state, storage s) -> void {
+		auto const vectors = make_vectors(dimensions_of(state));
+		auto const matrix = comp6771::euclidean_matrix(vectors, layout_of(s));
+		auto const query = comp6771::euclidean_vector(dimensions_of(state), 0.5);
+		for (auto _ : state) {
+			if (s == storage::vector_of_vectors) {
+				auto result = std::vector<double>(vectors.size());
+				for (auto i = std::size_t{0}; i < vectors.size(); ++i) {
+					result[i] = comp6771::dot(vectors[i], query);
+				}
+				benchmark::DoNotOptimize(result.data());
+			}
+			else {
+				benchmark::DoNotOptimize(comp6771::dot(matrix, query).data());
+			}
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK_CAPTURE(bm_dot, vector_of_vectors, storage::vector_of_vectors)->Apply(dimension_range);
+	BENCHMARK_CAPTURE(bm_dot, row_major, storage::row_major)->Apply(dimension_range);
+	BENCHMARK_CAPTURE(bm_dot, column_major, storage::column_major)->Apply(dimension_range);
+
+	//-----------------------------------euclidean_norm----------------------------------------
+	// euclidean_vector caches its norm, so the baseline goes through a view to measure the
+	// computation rather than the cache.
+	auto bm_euclidean_norm(benchmark::State& state, storage s) -> void {
+		auto const vectors = make_vectors(dimensions_of(state));
+		auto const matrix = comp6771::euclidean_matrix(vectors, layout_of(s));
+		for (auto _ : state) {
+			if (s == storage::vector_of_vectors) {
+				auto result = std::vector<double>(vectors.size());
+				for (auto i = std::size_t{0}; i < vectors.size(); ++i) {
+					result[i] =
+					   comp6771::euclidean_norm(comp6771::const_euclidean_vector_view(vectors[i]));
+				}
+				benchmark::DoNotOptimize(result.data());
+			}
+			else {
+				benchmark::DoNotOptimize(comp6771::euclidean_norm(matrix).data());
+			}
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK_CAPTURE(bm_euclidean_norm, vector_of_vectors, storage::vector_of_vectors)
+	   ->Apply(dimension_range);
+	BENCHMARK_CAPTURE(bm_euclidean_norm, row_major, storage::row_major)->Apply(dimension_range);
+	BENCHMARK_CAPTURE(bm_euclidean_norm, column_major, storage::column_major)
+	   ->Apply(dimension_range);
+
+	//----------------------------------------unit---------------------------------------------
+	auto bm_unit(benchmark::State& state, storage s) -> void {
+		auto const vectors = make_vectors(dimensions_of(state));
+		auto const matrix = comp6771::euclidean_matrix(vectors, layout_of(s));
+		for (auto _ : state) {
+			if (s == storage::vector_of_vectors) {
+				auto result = std::vector<comp6771::euclidean_vector>();
+				result.reserve(vectors.size());
+				for (auto const& v : vectors) {
+					result.push_back(comp6771::unit(comp6771::const_euclidean_vector_view(v)));
+				}
+				benchmark::DoNotOptimize(result.data());
+			}
+			else {
+				auto const result = comp6771::unit(matrix);
+				benchmark::DoNotOptimize(&result);
+			}
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK_CAPTURE(bm_unit, vector_of_vectors, storage::vector_of_vectors)
+	   ->Apply(dimension_range);
+	BENCHMARK_CAPTURE(bm_unit, row_major, storage::row_major)->Apply(dimension_range);
+	BENCHMARK_CAPTURE(bm_unit, column_major, storage::column_major)->Apply(dimension_range);
+} // namespace
@@ -0,0 +1,130 @@
+#include "comp6771/euclidean_matrix.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+// Scoring queries against a batch of candidates: a naive loop of dot calls over a
+// std::vector<euclidean_vector>, against the blocked euclidean_matrix kernels. Reported as
+// FLOP/s, counting a multiply and an add per magnitude of every pair.
+namespace {
+	auto constexpr candidates = 1 << 15;
+	auto constexpr queries = 64;
+
+	auto dimension_range(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMicrosecond);
+	}
+
+	auto dimensions_of(benchmark::State const& state) -> int {
+		return static_cast<int>(state.range(0));
+	}
+
+	auto set_flops(benchmark::State& state, int pairs_per_iteration) -> void {
+		auto const flops = 2.0 * static_cast<double>(pairs_per_iteration)
+		                   * static_cast<double>(state.range(0));
+		state.counters["FLOP/s"] = benchmark::Counter(flops,
+		                                              benchmark::Counter::kIsIterationInvariantRate);
+	}
+
+	auto make_vectors(int count, int dimensions, double phase)
+	   -> std::vector<comp6771::euclidean_vector> {
+		auto result = std::vector<comp6771::euclidean_vector>();
+		result.reserve(static_cast<std::size_t>(count));
+		for (auto i = 0; i < count; ++i) {
+			result.emplace_back(dimensions, [i, phase](int j) { return std::sin(phase + i + j); });
+		}
+		return result;
+	}
+
+	//-------------------------------------one-to-many-----------------------------------------
+	auto bm_dot_one_to_many_naive(benchmark::State& state) -> void {
+		auto const vectors = make_vectors(candidates, dimensions_of(state), 0.0);
+		auto const query = comp6771::euclidean_vector(dimensions_of(state), 0.5);
+		auto result = std::vector<double>(vectors.size());
+		for (auto _ : state) {
+			for (auto i = std::size_t{0}; i < vectors.size(); ++i) {
+				result[i] = comp6771::dot(query, vectors[i]);
+			}
+			benchmark::DoNotOptimize(result.data());
+		}
+		set_flops(state, candidates);
+	}
+	BENCHMARK(bm_dot_one_to_many_naive)->Apply(dimension_range);
+
+	auto bm_dot_one_to_many(benchmark::State& state, comp6771::matrix_layout layout) -> void {
+		auto const matrix =
+		   comp6771::euclidean_matrix(make_vectors(candidates, dimensions_of(state), 0.0), layout);
+		auto const query = comp6771::euclidean_vector(dimensions_of(state), 0.5);
+		auto result = std::vector<double>(static_cast<std::size_t>(candidates));
+		for (auto _ : state) {
+			comp6771::dot(matrix, query, result);
+			benchmark::DoNotOptimize(result.data());
+		}
+		set_flops(state, candidates);
+	}
+	BENCHMARK_CAPTURE(bm_dot_one_to_many, row_major, comp6771::matrix_layout::row_major)
+	   ->Apply(dimension_range);
+	BENCHMARK_CAPTURE(bm_dot_one_to_many, column_major, comp6771::matrix_layout::column_major)
+	   ->Apply(dimension_range);
+
+	//------------------------------------many-to-many-----------------------------------------
+	auto bm_dot_many_to_many_naive(benchmark::State& state) -> void {
+		auto const lhs = make_vectors(queries, dimensions_of(state), 1.0);
+		auto const rhs = make_vectors(candidates, dimensions_of(state), 0.0);
+		auto result = std::vector<double>(lhs.size() * rhs.size());
+		for (auto _ : state) {
+			for (auto i = std::size_t{0}; i < lhs.size(); ++i) {
+				for (auto j = std::size_t{0}; j < rhs.size(); ++j) {
+					result[i * rhs.size() + j] = comp6771::dot(lhs[i], rhs[j]);
+				}
+			}
+			benchmark::DoNotOptimize(result.data());
+		}
+		set_flops(state, queries * candidates);
+	}
+	BENCHMARK(bm_dot_many_to_many_naive)->Apply(dimension_range);
+
+	auto bm_dot_many_to_many(benchmark::State& state) -> void {
+		auto const lhs = comp6771::euclidean_matrix(make_vectors(queries, dimensions_of(state), 1.0));
+		auto const rhs =
+		   comp6771::euclidean_matrix(make_vectors(candidates, dimensions_of(state), 0.0));
+		for (auto _ : state) {
+			auto const result = comp6771::dot(lhs, rhs);
+			benchmark::DoNotOptimize(&result);
+		}
+		set_flops(state, queries * candidates);
+	}
+	BENCHMARK(bm_dot_many_to_many)->Apply(dimension_range);
+
+	//----------------------------------cosine similarity--------------------------------------
+	// both sides use cached norms: euclidean_vector's own cache, and norms computed once up front
+	auto bm_cosine_similarity_naive(benchmark::State& state) -> void {
+		auto const vectors = make_vectors(candidates, dimensions_of(state), 0.0);
+		auto const query = comp6771::euclidean_vector(dimensions_of(state), 0.5);
+		for (auto const& v : vectors) {
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(v));
+		}
+		auto result = std::vector<double>(vectors.size());
+		for (auto _ : state) {
+			for (auto i = std::size_t{0}; i < vectors.size(); ++i) {
+				result[i] = comp6771::dot(query, vectors[i])
+				            / (comp6771::euclidean_norm(query) * comp6771::euclidean_norm(vectors[i]));
+			}
+			benchmark::DoNotOptimize(result.data());
+		}
+		set_flops(state, candidates);
+	}
+	BENCHMARK(bm_cosine_similarity_naive)->Apply(dimension_range);
+
+	auto bm_cosine_similarity(benchmark::State& state) -> void {
+		auto const matrix =
+		   comp6771::euclidean_matrix(make_vectors(candidates, dimensions_of(state), 0.0));
+		auto const norms = comp6771::euclidean_norm(matrix);
+		auto const query = comp6771::euclidean_vector(dimensions_of(state), 0.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::cosine_similarity(matrix, norms, query).data());
+		}
+		set_flops(state, candidates);
+	}
+	BENCHMARK(bm_cosine_similarity)->Apply(dimension_range);
+} // namespace
@@ -0,0 +1,44 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+	// Repeated calls on an unmodified vector only read the cached norm, so this should be flat
+	// across dimensions.
+	auto bm_euclidean_norm_cached(benchmark::State& state) -> void {
+		auto const v = comp6771::euclidean_vector(static_cast<int>(state.range(0)), 1.5);
+		benchmark::DoNotOptimize(comp6771::euclidean_norm(v));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(v));
+		}
+		state.SetComplexityN(state.range(0));
+	}
+	BENCHMARK(bm_euclidean_norm_cached)
+	   ->RangeMultiplier(10)
+	   ->Range(1, 1'000'000)
+	   ->Complexity(benchmark::o1);
+
+	// Writing through the non-const subscript invalidates the cache, so every iteration pays for
+	// a full pass over the magnitudes.
+	auto bm_euclidean_norm_after_write(benchmark::State& state) -> void {
+		auto v = comp6771::euclidean_vector(static_cast<int>(state.range(0)), 1.5);
+		for (auto _ : state) {
+			v[0] = 1.5;
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(v));
+		}
+		state.SetComplexityN(state.range(0));
+	}
+	BENCHMARK(bm_euclidean_norm_after_write)
+	   ->RangeMultiplier(10)
+	   ->Range(1, 1'000'000)
+	   ->Complexity(benchmark::oN);
+
+	auto bm_unit_cached_norm(benchmark::State& state) -> void {
+		auto const v = comp6771::euclidean_vector(static_cast<int>(state.range(0)), 1.5);
+		benchmark::DoNotOptimize(comp6771::euclidean_norm(v));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::unit(v));
+		}
+	}
+	BENCHMARK(bm_unit_cached_norm)->RangeMultiplier(10)->Range(1, 1'000'000);
+} // namespace
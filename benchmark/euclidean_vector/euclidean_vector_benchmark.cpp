@@ -0,0 +1,311 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <ostream>
+#include <ranges>
+#include <streambuf>
+#include <utility>
+#include <vector>
+
+namespace {
+	auto constexpr max_dimensions = 100'000'000;
+
+	// 1, 10, 100, ..., 10^8
+	auto all_dimensions(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(10)->Range(1, max_dimensions)->Unit(benchmark::kMicrosecond);
+	}
+
+	auto dimensions_of(benchmark::State const& state) -> int {
+		return static_cast<int>(state.range(0));
+	}
+
+	auto set_elements_processed(benchmark::State& state) -> void {
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	// bytes of magnitudes each iteration produces
+	auto set_bytes_written(benchmark::State& state) -> void {
+		state.SetBytesProcessed(state.iterations() * state.range(0)
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	// swallows everything written to it, so operator<< is measured without any I/O
+	class null_buffer : public std::streambuf {
+	protected:
+		auto overflow(int_type c) -> int_type override {
+			return traits_type::not_eof(c);
+		}
+		auto xsputn(char const*, std::streamsize n) -> std::streamsize override {
+			return n;
+		}
+	};
+
+	//----------------------------------constructors-------------------------------------------
+	auto bm_default_constructor(benchmark::State& state) -> void {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector());
+		}
+	}
+	BENCHMARK(bm_default_constructor);
+
+	auto bm_size_constructor(benchmark::State& state) -> void {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector(dimensions_of(state)));
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_size_constructor)->Apply(all_dimensions);
+
+	auto bm_fill_constructor(benchmark::State& state) -> void {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector(dimensions_of(state), 1.5));
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_fill_constructor)->Apply(all_dimensions);
+
+	auto bm_range_constructor(benchmark::State& state) -> void {
+		auto const source = std::vector<double>(static_cast<std::size_t>(state.range(0)), 1.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector(source.begin(), source.end()));
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_range_constructor)->Apply(all_dimensions);
+
+	// The next four all produce a vector whose magnitude i is i * 0.5. The first writes the memory
+	// twice (zero fill, then the values); the others write it once, which shows up in
+	// bytes_per_second at large dimensions.
+	auto bm_size_constructor_then_overwrite(benchmark::State& state) -> void {
+		for (auto _ : state) {
+			auto v = comp6771::euclidean_vector(dimensions_of(state));
+			auto const magnitudes = v.magnitudes();
+			for (auto i = std::size_t{0}; i < magnitudes.size(); ++i) {
+				magnitudes[i] = static_cast<double>(i) * 0.5;
+			}
+			benchmark::DoNotOptimize(v);
+		}
+		set_elements_processed(state);
+		set_bytes_written(state);
+	}
+	BENCHMARK(bm_size_constructor_then_overwrite)->Apply(all_dimensions);
+
+	auto bm_uninitialized_constructor_then_overwrite(benchmark::State& state) -> void {
+		for (auto _ : state) {
+			auto v = comp6771::euclidean_vector(comp6771::uninitialized, dimensions_of(state));
+			auto const magnitudes = v.magnitudes();
+			for (auto i = std::size_t{0}; i < magnitudes.size(); ++i) {
+				magnitudes[i] = static_cast<double>(i) * 0.5;
+			}
+			benchmark::DoNotOptimize(v);
+		}
+		set_elements_processed(state);
+		set_bytes_written(state);
+	}
+	BENCHMARK(bm_uninitialized_constructor_then_overwrite)->Apply(all_dimensions);
+
+	auto bm_generator_constructor(benchmark::State& state) -> void {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(
+			   comp6771::euclidean_vector(dimensions_of(state), [](int i) { return i * 0.5; }));
+		}
+		set_elements_processed(state);
+		set_bytes_written(state);
+	}
+	BENCHMARK(bm_generator_constructor)->Apply(all_dimensions);
+
+	auto bm_sized_range_constructor(benchmark::State& state) -> void {
+		auto const values = std::views::iota(0, dimensions_of(state))
+		                    | std::views::transform([](int i) { return i * 0.5; });
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector(values));
+		}
+		set_elements_processed(state);
+		set_bytes_written(state);
+	}
+	BENCHMARK(bm_sized_range_constructor)->Apply(all_dimensions);
+
+	// a sized range that isn't a std::vector, which previously had to be copied into one first
+	auto bm_sized_range_constructor_from_deque(benchmark::State& state) -> void {
+		auto const source = std::deque<double>(static_cast<std::size_t>(state.range(0)), 1.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector(source));
+		}
+		set_elements_processed(state);
+		set_bytes_written(state);
+	}
+	BENCHMARK(bm_sized_range_constructor_from_deque)->Apply(all_dimensions);
+
+	auto bm_initializer_list_constructor(benchmark::State& state) -> void {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector{1.0, 2.0, 3.0, 4.0});
+		}
+	}
+	BENCHMARK(bm_initializer_list_constructor);
+
+	auto bm_copy_constructor(benchmark::State& state) -> void {
+		auto const source = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector(source));
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_copy_constructor)->Apply(all_dimensions);
+
+	auto bm_move_constructor(benchmark::State& state) -> void {
+		auto source = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		for (auto _ : state) {
+			auto moved = comp6771::euclidean_vector(std::move(source));
+			benchmark::DoNotOptimize(moved);
+			source = std::move(moved);
+		}
+	}
+	BENCHMARK(bm_move_constructor)->Apply(all_dimensions);
+
+	//-----------------------------------assignment--------------------------------------------
+	auto bm_copy_assignment(benchmark::State& state) -> void {
+		auto const source = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		auto target = comp6771::euclidean_vector(dimensions_of(state));
+		for (auto _ : state) {
+			target = source;
+			benchmark::DoNotOptimize(target);
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_copy_assignment)->Apply(all_dimensions);
+
+	auto bm_move_assignment(benchmark::State& state) -> void {
+		auto a = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		auto b = comp6771::euclidean_vector(dimensions_of(state), 2.5);
+		for (auto _ : state) {
+			a = std::move(b);
+			b = std::move(a);
+			benchmark::DoNotOptimize(b);
+		}
+	}
+	BENCHMARK(bm_move_assignment)->Apply(all_dimensions);
+
+	//------------------------------arithmetic operators---------------------------------------
+	// The operators return unevaluated expressions, so each benchmark converts the result to a
+	// euclidean_vector to measure the actual work.
+	auto bm_addition(benchmark::State& state) -> void {
+		auto const x = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		auto const y = comp6771::euclidean_vector(dimensions_of(state), 2.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector(x + y));
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_addition)->Apply(all_dimensions);
+
+	auto bm_subtraction(benchmark::State& state) -> void {
+		auto const x = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		auto const y = comp6771::euclidean_vector(dimensions_of(state), 2.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector(x - y));
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_subtraction)->Apply(all_dimensions);
+
+	auto bm_multiplication(benchmark::State& state) -> void {
+		auto const x = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector(x * 3.0));
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_multiplication)->Apply(all_dimensions);
+
+	auto bm_division(benchmark::State& state) -> void {
+		auto const x = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector(x / 3.0));
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_division)->Apply(all_dimensions);
+
+	// w = w + g * lr - m * decay, evaluated in place in a single pass
+	auto bm_fused_update(benchmark::State& state) -> void {
+		auto w = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		auto const g = comp6771::euclidean_vector(dimensions_of(state), 0.5);
+		auto const m = comp6771::euclidean_vector(dimensions_of(state), 0.25);
+		for (auto _ : state) {
+			w = w + g * 0.01 - m * 0.001;
+			benchmark::DoNotOptimize(w);
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_fused_update)->Apply(all_dimensions);
+
+	//-------------------------------utility functions-----------------------------------------
+	auto bm_dot(benchmark::State& state) -> void {
+		auto const x = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		auto const y = comp6771::euclidean_vector(dimensions_of(state), 2.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(x, y));
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_dot)->Apply(all_dimensions);
+
+	// The norm is cached, so a write through the non-const subscript is used to force the full
+	// computation every iteration. See euclidean_norm_benchmark for the cached case.
+	auto bm_euclidean_norm(benchmark::State& state) -> void {
+		auto x = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		for (auto _ : state) {
+			x[0] = 1.5;
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(x));
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_euclidean_norm)->Apply(all_dimensions);
+
+	auto bm_unit(benchmark::State& state) -> void {
+		auto x = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		for (auto _ : state) {
+			x[0] = 1.5;
+			benchmark::DoNotOptimize(comp6771::unit(x));
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_unit)->Apply(all_dimensions);
+
+	auto bm_output_stream(benchmark::State& state) -> void {
+		auto const x = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		auto buffer = null_buffer();
+		auto os = std::ostream(&buffer);
+		for (auto _ : state) {
+			os << x;
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_output_stream)->Apply(all_dimensions);
+
+	//----------------------------------conversions--------------------------------------------
+	auto bm_vector_conversion(benchmark::State& state) -> void {
+		auto const x = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(static_cast<std::vector<double>>(x));
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_vector_conversion)->Apply(all_dimensions);
+
+	// A 10^8-node std::list needs well over 3 GiB, so this one stops at 10^7.
+	auto bm_list_conversion(benchmark::State& state) -> void {
+		auto const x = comp6771::euclidean_vector(dimensions_of(state), 1.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(static_cast<std::list<double>>(x));
+		}
+		set_elements_processed(state);
+	}
+	BENCHMARK(bm_list_conversion)
+	   ->RangeMultiplier(10)
+	   ->Range(1, max_dimensions / 10)
+	   ->Unit(benchmark::kMicrosecond);
+} // namespace
@@ -0,0 +1,126 @@
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include "vector_factory.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+
+// The fused distance functions against the operator chains they replace. The chains go through
+// views so that euclidean_norm can't answer from a vector's cached norm.
+namespace {
+	using comp6771::bench::make_vector;
+
+	auto set_bytes_processed(benchmark::State& state, std::int64_t vectors_read) -> void {
+		state.SetBytesProcessed(state.iterations() * vectors_read * state.range(0)
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	auto bm_distance_by_operators(benchmark::State& state) -> void {
+		auto const a = make_vector(static_cast<int>(state.range(0)), 0.0);
+		auto const b = make_vector(static_cast<int>(state.range(0)), 1.0);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(comp6771::euclidean_vector(a - b)));
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(bm_distance_by_operators)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+	auto bm_distance(benchmark::State& state) -> void {
+		auto const a = make_vector(static_cast<int>(state.range(0)), 0.0);
+		auto const b = make_vector(static_cast<int>(state.range(0)), 1.0);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::distance(a, b));
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(bm_distance)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+	auto bm_manhattan_distance(benchmark::State& state) -> void {
+		auto const a = make_vector(static_cast<int>(state.range(0)), 0.0);
+		auto const b = make_vector(static_cast<int>(state.range(0)), 1.0);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::manhattan_distance(a, b));
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(bm_manhattan_distance)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+	// three passes: one dot product and two norms
+	auto bm_cosine_similarity_by_parts(benchmark::State& state) -> void {
+		auto const a = make_vector(static_cast<int>(state.range(0)), 0.0);
+		auto const b = make_vector(static_cast<int>(state.range(0)), 1.0);
+		auto const x = comp6771::const_euclidean_vector_view(a);
+		auto const y = comp6771::const_euclidean_vector_view(b);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(x, y)
+			                         / (comp6771::euclidean_norm(x) * comp6771::euclidean_norm(y)));
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(bm_cosine_similarity_by_parts)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+	auto bm_cosine_similarity(benchmark::State& state) -> void {
+		auto const a = make_vector(static_cast<int>(state.range(0)), 0.0);
+		auto const b = make_vector(static_cast<int>(state.range(0)), 1.0);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::cosine_similarity(a, b));
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(bm_cosine_similarity)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+	//---------------------------------batches---------------------------------
+	// a query against 4096 candidates of range(0) dimensions
+	auto constexpr candidate_count = 4096;
+
+	auto make_candidates(int dimensions) -> std::vector<comp6771::euclidean_vector> {
+		auto result = std::vector<comp6771::euclidean_vector>();
+		result.reserve(candidate_count);
+		for (auto i = 0; i < candidate_count; ++i) {
+			result.push_back(make_vector(dimensions, i));
+		}
+		return result;
+	}
+
+	auto bm_distance_batch_by_operators(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const query = make_vector(dimensions, 0.5);
+		auto const candidates = make_candidates(dimensions);
+		auto result = std::vector<double>(candidates.size());
+		for (auto _ : state) {
+			for (auto i = std::size_t{0}; i < candidates.size(); ++i) {
+				result[i] = comp6771::euclidean_norm(comp6771::euclidean_vector(query - candidates[i]));
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * candidate_count);
+	}
+	BENCHMARK(bm_distance_batch_by_operators)->Arg(16)->Arg(128)->Arg(1024);
+
+	auto bm_distance_batch(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const query = make_vector(dimensions, 0.5);
+		auto const candidates = make_candidates(dimensions);
+		auto result = std::vector<double>(candidates.size());
+		for (auto _ : state) {
+			comp6771::distance(query, candidates, result);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * candidate_count);
+	}
+	BENCHMARK(bm_distance_batch)->Arg(16)->Arg(128)->Arg(1024);
+
+	auto bm_cosine_similarity_batch(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const query = make_vector(dimensions, 0.5);
+		auto const candidates = make_candidates(dimensions);
+		auto result = std::vector<double>(candidates.size());
+		for (auto _ : state) {
+			comp6771::cosine_similarity(query, candidates, result);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * candidate_count);
+	}
+	BENCHMARK(bm_cosine_similarity_batch)->Arg(16)->Arg(128)->Arg(1024);
+} // namespace
@@ -0,0 +1,109 @@
+#include "comp6771/euclidean_vector_format.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <fmt/format.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Writing and reading a euclidean_vector as text: operator<< and a matching istream parser
+// against fmt::format, comp6771::to_chars and comp6771::from_chars. operator<< only writes six
+// significant digits, so its text is shorter than the round-trip text the others write; bytes
+// processed counts the text, so compare items (magnitudes) per second as well. fmt::format and
+// operator<< build a new string each time; to_chars writes into a buffer that's reused.
+namespace {
+	auto make_vector(std::int64_t dimensions) -> comp6771::euclidean_vector {
+		auto engine = std::mt19937_64(6771);
+		auto normal = std::normal_distribution(0.0, 1.0);
+		return comp6771::euclidean_vector(static_cast<int>(dimensions),
+		                                  [&](int) { return normal(engine); });
+	}
+
+	auto size_range(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+	}
+
+	auto set_counters(benchmark::State& state, std::size_t text_size) -> void {
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text_size));
+	}
+
+	auto bm_ostream(benchmark::State& state) -> void {
+		auto const v = make_vector(state.range(0));
+		auto size = std::size_t{0};
+		for (auto _ : state) {
+			auto out = std::ostringstream();
+			out << v;
+			auto const text = std::move(out).str();
+			size = text.size();
+			benchmark::DoNotOptimize(text.data());
+		}
+		set_counters(state, size);
+	}
+	BENCHMARK(bm_ostream)->Apply(size_range);
+
+	auto bm_fmt_format(benchmark::State& state) -> void {
+		auto const v = make_vector(state.range(0));
+		auto size = std::size_t{0};
+		for (auto _ : state) {
+			auto const text = fmt::format("{}", v);
+			size = text.size();
+			benchmark::DoNotOptimize(text.data());
+		}
+		set_counters(state, size);
+	}
+	BENCHMARK(bm_fmt_format)->Apply(size_range);
+
+	auto bm_to_chars(benchmark::State& state) -> void {
+		auto const v = make_vector(state.range(0));
+		// 24 characters is enough for any double, plus one for the separator
+		auto buffer = std::vector<char>(static_cast<std::size_t>(state.range(0)) * 25 + 2);
+		auto size = std::size_t{0};
+		for (auto _ : state) {
+			auto const result = comp6771::to_chars(buffer.data(), buffer.data() + buffer.size(), v);
+			size = static_cast<std::size_t>(result.ptr - buffer.data());
+			benchmark::DoNotOptimize(buffer.data());
+			benchmark::ClobberMemory();
+		}
+		set_counters(state, size);
+	}
+	BENCHMARK(bm_to_chars)->Apply(size_range);
+
+	// what an ingest job does without from_chars: read "[a b c]" through an istream into a
+	// std::vector, then copy it into a euclidean_vector
+	auto parse_istream(std::istream& is) -> comp6771::euclidean_vector {
+		auto magnitudes = std::vector<double>();
+		auto open = char();
+		is >> open;
+		auto m = 0.0;
+		while (is >> m) {
+			magnitudes.push_back(m);
+		}
+		return comp6771::euclidean_vector(magnitudes.begin(), magnitudes.end());
+	}
+
+	auto bm_istream(benchmark::State& state) -> void {
+		auto const text = fmt::format("{}", make_vector(state.range(0)));
+		for (auto _ : state) {
+			auto in = std::istringstream(text);
+			auto const v = parse_istream(in);
+			benchmark::DoNotOptimize(v.dimensions());
+		}
+		set_counters(state, text.size());
+	}
+	BENCHMARK(bm_istream)->Apply(size_range);
+
+	auto bm_from_chars(benchmark::State& state) -> void {
+		auto const text = fmt::format("{}", make_vector(state.range(0)));
+		auto v = comp6771::euclidean_vector();
+		for (auto _ : state) {
+			auto const result = comp6771::from_chars(text.data(), text.data() + text.size(), v);
+			benchmark::DoNotOptimize(result.ptr);
+		}
+		set_counters(state, text.size());
+	}
+	BENCHMARK(bm_from_chars)->Apply(size_range);
+} // namespace
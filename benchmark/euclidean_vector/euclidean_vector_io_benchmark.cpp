@@ -0,0 +1,139 @@
+#include "comp6771/euclidean_vector_io.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+// Time to load a batch of embeddings, three ways: parsing the text that operator<< writes,
+// reading the binary format from a stream, and memory mapping a binary file. The mapped store
+// only reads the header when it's opened, so bm_open_mapped should stay flat as the batch grows;
+// bm_open_and_verify_mapped adds a pass over every magnitude. Bytes processed counts the
+// magnitudes loaded, at eight bytes each, whatever the format.
+namespace {
+	auto constexpr dimensions = 128;
+
+	auto make_batch(std::int64_t count) -> std::vector<comp6771::euclidean_vector> {
+		auto engine = std::mt19937_64(6771);
+		auto normal = std::normal_distribution(0.0, 1.0);
+		auto result = std::vector<comp6771::euclidean_vector>();
+		result.reserve(static_cast<std::size_t>(count));
+		for (auto i = std::int64_t{0}; i < count; ++i) {
+			result.emplace_back(dimensions, [&](int) { return normal(engine); });
+		}
+		return result;
+	}
+
+	// the inverse of operator<<, for one vector per line
+	auto parse_text(std::istream& is) -> std::vector<comp6771::euclidean_vector> {
+		auto result = std::vector<comp6771::euclidean_vector>();
+		auto magnitudes = std::vector<double>();
+		auto open = char();
+		while (is >> open) {
+			magnitudes.clear();
+			auto m = 0.0;
+			while (is >> m) {
+				magnitudes.push_back(m);
+			}
+			is.clear();
+			is.ignore(); // ']'
+			result.emplace_back(static_cast<int>(magnitudes.size()), [&](int i) {
+				return magnitudes[static_cast<std::size_t>(i)];
+			});
+		}
+		return result;
+	}
+
+	auto count_range(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(16)->Range(1 << 10, 1 << 14);
+	}
+
+	auto set_bytes(benchmark::State& state) -> void {
+		state.SetBytesProcessed(state.iterations() * state.range(0) * dimensions
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	auto bm_parse_text(benchmark::State& state) -> void {
+		auto text = std::ostringstream();
+		// operator<< uses the stream's default precision, so this round trip isn't lossless
+		for (auto const& v : make_batch(state.range(0))) {
+			text << v << '\n';
+		}
+		auto const data = std::move(text).str();
+		for (auto _ : state) {
+			auto in = std::istringstream(data);
+			auto result = parse_text(in);
+			benchmark::DoNotOptimize(result.data());
+		}
+		set_bytes(state);
+	}
+	BENCHMARK(bm_parse_text)->Apply(count_range);
+
+	auto bm_read_binary(benchmark::State& state) -> void {
+		auto out = std::ostringstream(std::ios::binary);
+		comp6771::write_binary(out, make_batch(state.range(0)));
+		auto const data = std::move(out).str();
+		for (auto _ : state) {
+			auto in = std::istringstream(data, std::ios::binary);
+			auto result = comp6771::read_binary_batch(in);
+			benchmark::DoNotOptimize(result.data());
+		}
+		set_bytes(state);
+	}
+	BENCHMARK(bm_read_binary)->Apply(count_range);
+
+	// a binary file of state.range(0) vectors, removed when the benchmark finishes
+	class batch_file {
+	public:
+		explicit batch_file(std::int64_t count)
+		: path_{std::filesystem::temp_directory_path()
+		        / ("euclidean_vector_io_benchmark_" + std::to_string(count))} {
+			auto out = std::ofstream(path_, std::ios::binary);
+			comp6771::write_binary(out, make_batch(count));
+		}
+
+		batch_file(batch_file const&) = delete;
+		auto operator=(batch_file const&) -> batch_file& = delete;
+
+		~batch_file() {
+			auto error = std::error_code();
+			std::filesystem::remove(path_, error);
+		}
+
+		[[nodiscard]] auto path() const -> std::filesystem::path const& {
+			return path_;
+		}
+
+	private:
+		std::filesystem::path path_;
+	};
+
+	auto bm_open_mapped(benchmark::State& state) -> void {
+		auto const file = batch_file(state.range(0));
+		for (auto _ : state) {
+			auto const store = comp6771::mapped_euclidean_vectors(file.path());
+			auto const first = store[0];
+			benchmark::DoNotOptimize(first.magnitudes().data());
+		}
+		set_bytes(state);
+	}
+	BENCHMARK(bm_open_mapped)->Apply(count_range);
+
+	auto bm_open_and_verify_mapped(benchmark::State& state) -> void {
+		auto const file = batch_file(state.range(0));
+		for (auto _ : state) {
+			auto const store = comp6771::mapped_euclidean_vectors(file.path());
+			auto verified = store.verify();
+			benchmark::DoNotOptimize(verified);
+		}
+		set_bytes(state);
+	}
+	BENCHMARK(bm_open_and_verify_mapped)->Apply(count_range);
+} // namespace
@@ -0,0 +1,86 @@
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+	using comp6771::kernels::simd_width;
+
+	// Reports bytes/s so that the large sizes can be compared against memory bandwidth.
+	auto bm_dot(benchmark::State& state, simd_width width) -> void {
+		if (not comp6771::kernels::is_supported(width)) {
+			state.SkipWithError("instruction set not supported on this CPU");
+			return;
+		}
+		auto const& kernels = comp6771::kernels::kernels_for(width);
+		auto const n = static_cast<std::size_t>(state.range(0));
+		auto const x = std::vector<double>(n, 1.5);
+		auto const y = std::vector<double>(n, 0.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(kernels.dot(x, y));
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0) * 2
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	auto bm_squared_norm(benchmark::State& state, simd_width width) -> void {
+		if (not comp6771::kernels::is_supported(width)) {
+			state.SkipWithError("instruction set not supported on this CPU");
+			return;
+		}
+		auto const& kernels = comp6771::kernels::kernels_for(width);
+		auto const n = static_cast<std::size_t>(state.range(0));
+		auto const x = std::vector<double>(n, 1.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(kernels.squared_norm(x));
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0)
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	auto bm_axpy(benchmark::State& state, simd_width width) -> void {
+		if (not comp6771::kernels::is_supported(width)) {
+			state.SkipWithError("instruction set not supported on this CPU");
+			return;
+		}
+		auto const& kernels = comp6771::kernels::kernels_for(width);
+		auto const n = static_cast<std::size_t>(state.range(0));
+		auto const x = std::vector<double>(n, 1.5);
+		auto y = std::vector<double>(n, 0.5);
+		for (auto _ : state) {
+			kernels.axpy(1.0, x, y);
+			benchmark::ClobberMemory();
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0) * 3
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	auto bm_scale(benchmark::State& state, simd_width width) -> void {
+		if (not comp6771::kernels::is_supported(width)) {
+			state.SkipWithError("instruction set not supported on this CPU");
+			return;
+		}
+		auto const& kernels = comp6771::kernels::kernels_for(width);
+		auto const n = static_cast<std::size_t>(state.range(0));
+		auto x = std::vector<double>(n, 1.5);
+		for (auto _ : state) {
+			kernels.scale(1.0, x);
+			benchmark::ClobberMemory();
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0) * 2
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+#define COMP6771_KERNEL_BENCHMARK(kernel)                                                          \
+	BENCHMARK_CAPTURE(kernel, scalar, simd_width::scalar)->RangeMultiplier(16)->Range(16, 1 << 24); \
+	BENCHMARK_CAPTURE(kernel, sse2, simd_width::sse2)->RangeMultiplier(16)->Range(16, 1 << 24);     \
+	BENCHMARK_CAPTURE(kernel, avx2, simd_width::avx2)->RangeMultiplier(16)->Range(16, 1 << 24);     \
+	BENCHMARK_CAPTURE(kernel, avx512, simd_width::avx512)->RangeMultiplier(16)->Range(16, 1 << 24)
+
+	COMP6771_KERNEL_BENCHMARK(bm_dot);
+	COMP6771_KERNEL_BENCHMARK(bm_squared_norm);
+	COMP6771_KERNEL_BENCHMARK(bm_axpy);
+	COMP6771_KERNEL_BENCHMARK(bm_scale);
+} // namespace
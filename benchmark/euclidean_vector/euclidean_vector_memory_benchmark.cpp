@@ -0,0 +1,109 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_memory.hpp"
+
+#include <benchmark/benchmark.h>
+#include <memory_resource>
+#include <vector>
+
+// Compares the memory_resources a batch job could put its vectors in. Every benchmark builds
+// batch_size vectors per iteration, in two patterns:
+//   - short-lived: each vector is created, used and destroyed before the next one
+//   - batch: all of them are alive at once and destroyed together at the end of the iteration
+namespace {
+	auto constexpr batch_size = 1'000;
+
+	enum class resource_kind { default_resource, arena, pool, std_monotonic, std_pool };
+
+	// owns the resource under test and resets it between iterations where that's how it's meant
+	// to be used
+	class resource_under_test {
+	public:
+		explicit resource_under_test(resource_kind kind)
+		: kind_{kind} {}
+
+		auto get() -> std::pmr::memory_resource* {
+			switch (kind_) {
+			case resource_kind::default_resource: return std::pmr::get_default_resource();
+			case resource_kind::arena: return &arena_;
+			case resource_kind::pool: return &pool_;
+			case resource_kind::std_monotonic: return &std_monotonic_;
+			case resource_kind::std_pool: return &std_pool_;
+			}
+			return nullptr;
+		}
+
+		auto end_of_iteration() -> void {
+			if (kind_ == resource_kind::arena) {
+				arena_.rewind();
+			}
+			else if (kind_ == resource_kind::std_monotonic) {
+				std_monotonic_.release();
+			}
+		}
+
+	private:
+		resource_kind kind_;
+		comp6771::pmr::arena_resource arena_;
+		comp6771::pmr::pool_resource pool_;
+		std::pmr::monotonic_buffer_resource std_monotonic_;
+		std::pmr::unsynchronized_pool_resource std_pool_;
+	};
+
+	// one size under the inline capacity for reference, then sizes that need storage
+	auto vector_sizes(benchmark::internal::Benchmark* b) -> void {
+		b->Arg(comp6771::euclidean_vector::inline_capacity)
+		   ->Arg(comp6771::euclidean_vector::inline_capacity + 1)
+		   ->Arg(64)
+		   ->Arg(256)
+		   ->Arg(1024)
+		   ->Unit(benchmark::kMicrosecond);
+	}
+
+	auto set_vectors_processed(benchmark::State& state) -> void {
+		state.SetItemsProcessed(state.iterations() * batch_size);
+	}
+
+	auto bm_short_lived(benchmark::State& state, resource_kind kind) -> void {
+		auto resource = resource_under_test(kind);
+		auto const dimensions = static_cast<int>(state.range(0));
+		for (auto _ : state) {
+			auto sum = 0.0;
+			for (auto i = 0; i < batch_size; ++i) {
+				auto const v = comp6771::euclidean_vector(dimensions, 1.5, resource.get());
+				sum += v[0];
+			}
+			benchmark::DoNotOptimize(sum);
+			resource.end_of_iteration();
+		}
+		set_vectors_processed(state);
+	}
+
+	auto bm_batch(benchmark::State& state, resource_kind kind) -> void {
+		auto resource = resource_under_test(kind);
+		auto const dimensions = static_cast<int>(state.range(0));
+		for (auto _ : state) {
+			{
+				auto batch = std::pmr::vector<comp6771::euclidean_vector>(resource.get());
+				batch.reserve(batch_size);
+				for (auto i = 0; i < batch_size; ++i) {
+					batch.emplace_back(dimensions, 1.5);
+				}
+				benchmark::DoNotOptimize(batch.data());
+			}
+			resource.end_of_iteration();
+		}
+		set_vectors_processed(state);
+	}
+
+#define COMP6771_MEMORY_BENCHMARKS(kind)                                                           \
+	BENCHMARK_CAPTURE(bm_short_lived, kind, resource_kind::kind)->Apply(vector_sizes);              \
+	BENCHMARK_CAPTURE(bm_batch, kind, resource_kind::kind)->Apply(vector_sizes)
+
+	COMP6771_MEMORY_BENCHMARKS(default_resource);
+	COMP6771_MEMORY_BENCHMARKS(arena);
+	COMP6771_MEMORY_BENCHMARKS(pool);
+	COMP6771_MEMORY_BENCHMARKS(std_monotonic);
+	COMP6771_MEMORY_BENCHMARKS(std_pool);
+
+#undef COMP6771_MEMORY_BENCHMARKS
+} // namespace
@@ -0,0 +1,70 @@
+#include "comp6771/euclidean_vector_parallel.hpp"
+#include "comp6771/thread_pool.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <thread>
+
+// Scaling of the parallel overloads from one thread up to every hardware thread, on vectors of
+// 2^24 magnitudes (128 MiB each), far larger than any cache.
+namespace {
+	auto constexpr dimensions = 1 << 24;
+
+	auto thread_range(benchmark::internal::Benchmark* b) -> void {
+		auto const max_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+		for (auto threads = 1; threads < max_threads; threads *= 2) {
+			b->Arg(threads);
+		}
+		b->Arg(max_threads)->ArgName("threads")->Unit(benchmark::kMillisecond)->UseRealTime();
+	}
+
+	auto set_bytes_processed(benchmark::State& state, int vectors_touched) -> void {
+		state.SetBytesProcessed(state.iterations() * vectors_touched * dimensions
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	auto bm_dot(benchmark::State& state) -> void {
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		auto const a = comp6771::euclidean_vector(dimensions, 1.0);
+		auto const b = comp6771::euclidean_vector(dimensions, 2.0);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(pool, a, b));
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(bm_dot)->Apply(thread_range);
+
+	auto bm_euclidean_norm(benchmark::State& state) -> void {
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		auto const a = comp6771::euclidean_vector(dimensions, 1.0);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(pool, a));
+		}
+		set_bytes_processed(state, 1);
+	}
+	BENCHMARK(bm_euclidean_norm)->Apply(thread_range);
+
+	auto bm_add_assign(benchmark::State& state) -> void {
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		auto a = comp6771::euclidean_vector(dimensions, 1.0);
+		auto const b = comp6771::euclidean_vector(dimensions, 2.0);
+		for (auto _ : state) {
+			comp6771::add_assign(pool, a, b);
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(bm_add_assign)->Apply(thread_range);
+
+	auto bm_multiply_assign(benchmark::State& state) -> void {
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		auto a = comp6771::euclidean_vector(dimensions, 1.0);
+		for (auto _ : state) {
+			comp6771::multiply_assign(pool, a, 1.0000001);
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(bm_multiply_assign)->Apply(thread_range);
+} // namespace
@@ -0,0 +1,61 @@
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Speed against accuracy for each reduction mode. The data is ill-conditioned on purpose:
+// magnitudes from 1e-8 to 1e8 with random signs, so that a lot of the sum cancels. The
+// relative_error counter is measured against a reference summed in long double with
+// compensation; y is all ones, so every product is exact and the reference is as good as exact.
+namespace {
+	auto make_data(std::size_t n) -> std::vector<double> {
+		auto engine = std::mt19937_64(6771);
+		auto exponent = std::uniform_real_distribution(-8.0, 8.0);
+		auto sign = std::bernoulli_distribution();
+		auto result = std::vector<double>(n);
+		for (auto& d : result) {
+			d = (sign(engine) ? 1.0 : -1.0) * std::pow(10.0, exponent(engine));
+		}
+		return result;
+	}
+
+	auto reference_sum(std::vector<double> const& x) -> long double {
+		auto sum = 0.0L;
+		auto error = 0.0L;
+		for (auto const d : x) {
+			auto const t = sum + d;
+			error += std::fabs(sum) >= std::fabs(d) ? (sum - t) + d : (d - t) + sum;
+			sum = t;
+		}
+		return sum + error;
+	}
+
+	auto bm_dot(benchmark::State& state, comp6771::reduction mode) -> void {
+		auto const n = static_cast<std::size_t>(state.range(0));
+		auto const x = make_data(n);
+		auto const ones = std::vector<double>(n, 1.0);
+		auto result = 0.0;
+		for (auto _ : state) {
+			result = comp6771::kernels::dot(x, ones, mode);
+			benchmark::DoNotOptimize(result);
+		}
+		auto const reference = reference_sum(x);
+		state.counters["relative_error"] =
+		   static_cast<double>(std::fabs((result - reference) / reference));
+		state.SetBytesProcessed(state.iterations() * state.range(0) * 2
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	auto size_range(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(64)->Range(1 << 10, 1 << 22);
+	}
+
+	BENCHMARK_CAPTURE(bm_dot, unordered, comp6771::reduction::unordered)->Apply(size_range);
+	BENCHMARK_CAPTURE(bm_dot, blocked, comp6771::reduction::blocked)->Apply(size_range);
+	BENCHMARK_CAPTURE(bm_dot, pairwise, comp6771::reduction::pairwise)->Apply(size_range);
+	BENCHMARK_CAPTURE(bm_dot, compensated, comp6771::reduction::compensated)->Apply(size_range);
+} // namespace
@@ -0,0 +1,144 @@
+#include "comp6771/euclidean_vector_search.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Queries per second (items_per_second) for each index, over 2^16 uniformly random vectors in 4 and
+// 128 dimensions, finding the 10 nearest neighbours. The approximate searches also report recall:
+// the fraction of the true 10 nearest neighbours they found.
+namespace {
+	auto constexpr count = std::size_t{1} << 16;
+	auto constexpr query_count = std::size_t{64};
+	auto constexpr k = std::size_t{10};
+
+	auto make_vectors(std::size_t n, int dimensions, std::uint64_t seed)
+	   -> std::vector<comp6771::euclidean_vector> {
+		auto engine = std::mt19937_64(seed);
+		auto distribution = std::uniform_real_distribution<double>(-1.0, 1.0);
+		auto result = std::vector<comp6771::euclidean_vector>();
+		result.reserve(n);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			result.emplace_back(dimensions, [&](int) { return distribution(engine); });
+		}
+		return result;
+	}
+
+	struct data_set {
+		std::vector<comp6771::euclidean_vector> vectors;
+		std::vector<comp6771::euclidean_vector> queries;
+		std::vector<std::vector<comp6771::neighbour>> expected;
+	};
+
+	// building the indices is expensive, so each data set is only built once
+	auto get_data_set(int dimensions) -> data_set const& {
+		static auto const make = [](int d) {
+			auto result = data_set{make_vectors(count, d, 1), make_vectors(query_count, d, 2), {}};
+			result.expected = comp6771::exact_index(result.vectors).search(result.queries, k);
+			return result;
+		};
+		static auto const low = make(4);
+		static auto const high = make(128);
+		return dimensions == 4 ? low : high;
+	}
+
+	auto set_recall(benchmark::State& state,
+	                data_set const& data,
+	                std::vector<std::vector<comp6771::neighbour>> const& found) -> void {
+		auto hits = 0.0;
+		for (auto q = std::size_t{0}; q < found.size(); ++q) {
+			for (auto const& n : found[q]) {
+				hits += static_cast<double>(std::ranges::count(data.expected[q], n));
+			}
+		}
+		state.counters["recall"] = hits / static_cast<double>(found.size() * k);
+	}
+
+	auto bm_exact_search(benchmark::State& state) -> void {
+		auto const& data = get_data_set(static_cast<int>(state.range(0)));
+		auto const index = comp6771::exact_index(data.vectors);
+		for (auto _ : state) {
+			for (auto const& query : data.queries) {
+				benchmark::DoNotOptimize(index.search(query, k));
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(query_count));
+	}
+	BENCHMARK(bm_exact_search)->Arg(4)->Arg(128)->ArgName("dimensions");
+
+	// the same queries as bm_exact_search, all at once
+	auto bm_exact_search_batch(benchmark::State& state) -> void {
+		auto const& data = get_data_set(static_cast<int>(state.range(0)));
+		auto const index = comp6771::exact_index(data.vectors);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(index.search(data.queries, k));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(query_count));
+	}
+	BENCHMARK(bm_exact_search_batch)->Arg(4)->Arg(128)->ArgName("dimensions");
+
+	auto bm_kd_tree_search(benchmark::State& state) -> void {
+		auto const& data = get_data_set(static_cast<int>(state.range(0)));
+		auto const index = comp6771::kd_tree(data.vectors);
+		auto found = std::vector<std::vector<comp6771::neighbour>>(query_count);
+		for (auto _ : state) {
+			for (auto q = std::size_t{0}; q < query_count; ++q) {
+				found[q] = index.search(data.queries[q], k);
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(query_count));
+		set_recall(state, data, found);
+	}
+	BENCHMARK(bm_kd_tree_search)->Arg(4)->Arg(128)->ArgName("dimensions");
+
+	auto bm_ivf_search(benchmark::State& state) -> void {
+		auto const& data = get_data_set(static_cast<int>(state.range(0)));
+		// ivf_index's default of about sqrt(count) = 256 lists
+		static auto const low = comp6771::ivf_index(get_data_set(4).vectors);
+		static auto const high = comp6771::ivf_index(get_data_set(128).vectors);
+		auto const& index = state.range(0) == 4 ? low : high;
+		auto const probes = static_cast<std::size_t>(state.range(1));
+		auto found = std::vector<std::vector<comp6771::neighbour>>(query_count);
+		for (auto _ : state) {
+			for (auto q = std::size_t{0}; q < query_count; ++q) {
+				found[q] = index.search(data.queries[q], k, probes);
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(query_count));
+		set_recall(state, data, found);
+	}
+	BENCHMARK(bm_ivf_search)
+	   ->ArgsProduct({{4, 128}, {1, 4, 16, 64}})
+	   ->ArgNames({"dimensions", "probes"});
+
+	auto bm_kd_tree_build(benchmark::State& state) -> void {
+		auto const& data = get_data_set(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::kd_tree(data.vectors));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+	}
+	BENCHMARK(bm_kd_tree_build)
+	   ->Arg(4)
+	   ->Arg(128)
+	   ->ArgName("dimensions")
+	   ->Unit(benchmark::kMillisecond);
+
+	auto bm_ivf_build(benchmark::State& state) -> void {
+		auto const& data = get_data_set(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::ivf_index(data.vectors));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+	}
+	BENCHMARK(bm_ivf_build)
+	   ->Arg(4)
+	   ->Arg(128)
+	   ->ArgName("dimensions")
+	   ->Unit(benchmark::kMillisecond);
+} // namespace
@@ -0,0 +1,127 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Counts every heap allocation so each benchmark can report its allocation rate.
+namespace {
+	auto allocations = std::size_t{0};
+} // namespace
+
+auto operator new(std::size_t size) -> void* {
+	++allocations;
+	if (auto* p = std::malloc(size == 0 ? 1 : size)) { // NOLINT(cppcoreguidelines-no-malloc)
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+auto operator delete(void* p) noexcept -> void {
+	std::free(p); // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+auto operator delete(void* p, std::size_t) noexcept -> void {
+	std::free(p); // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+// euclidean_vector allocates from std::pmr::new_delete_resource(), which uses the aligned overloads
+auto operator new(std::size_t size, std::align_val_t alignment) -> void* {
+	++allocations;
+	auto const align = static_cast<std::size_t>(alignment);
+	auto const rounded = (size + align - 1) / align * align;
+	if (auto* p = std::aligned_alloc(align, rounded == 0 ? align : rounded)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+auto operator delete(void* p, std::align_val_t) noexcept -> void {
+	std::free(p); // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+auto operator delete(void* p, std::size_t, std::align_val_t) noexcept -> void {
+	std::free(p); // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+namespace {
+	// dimensions on both sides of euclidean_vector::inline_capacity
+	auto around_inline_capacity(benchmark::internal::Benchmark* b) -> void {
+		auto constexpr capacity = comp6771::euclidean_vector::inline_capacity;
+		for (auto const dimensions : {1, 3, capacity / 2, capacity, capacity + 1, 4 * capacity}) {
+			b->Arg(dimensions);
+		}
+	}
+
+	// reports allocations per iteration, and as a rate
+	class allocation_reporter {
+	public:
+		explicit allocation_reporter(benchmark::State& state) noexcept
+		: state_{state}
+		, start_{allocations} {}
+
+		allocation_reporter(allocation_reporter const&) = delete;
+		allocation_reporter(allocation_reporter&&) = delete;
+		auto operator=(allocation_reporter const&) -> allocation_reporter& = delete;
+		auto operator=(allocation_reporter&&) -> allocation_reporter& = delete;
+
+		~allocation_reporter() {
+			auto const count = static_cast<double>(allocations - start_);
+			state_.counters["allocations"] =
+			   benchmark::Counter(count, benchmark::Counter::kAvgIterations);
+			state_.counters["allocation_rate"] =
+			   benchmark::Counter(count, benchmark::Counter::kIsRate);
+		}
+
+	private:
+		benchmark::State& state_;
+		std::size_t start_;
+	};
+
+	auto bm_construct(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const reporter = allocation_reporter(state);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector(dimensions, 1.5));
+		}
+	}
+	BENCHMARK(bm_construct)->Apply(around_inline_capacity);
+
+	auto bm_copy(benchmark::State& state) -> void {
+		auto const source = comp6771::euclidean_vector(static_cast<int>(state.range(0)), 1.5);
+		auto const reporter = allocation_reporter(state);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector(source));
+		}
+	}
+	BENCHMARK(bm_copy)->Apply(around_inline_capacity);
+
+	auto bm_move(benchmark::State& state) -> void {
+		auto source = comp6771::euclidean_vector(static_cast<int>(state.range(0)), 1.5);
+		auto const reporter = allocation_reporter(state);
+		for (auto _ : state) {
+			auto moved = comp6771::euclidean_vector(std::move(source));
+			benchmark::DoNotOptimize(moved);
+			source = std::move(moved);
+		}
+	}
+	BENCHMARK(bm_move)->Apply(around_inline_capacity);
+
+	// a batch job building many short-lived vectors
+	auto bm_short_lived_batch(benchmark::State& state) -> void {
+		auto const dimensions = static_cast<int>(state.range(0));
+		auto const a = comp6771::euclidean_vector(dimensions, 1.5);
+		auto const b = comp6771::euclidean_vector(dimensions, 2.5);
+		auto const reporter = allocation_reporter(state);
+		for (auto _ : state) {
+			auto sum = 0.0;
+			for (auto i = 0; i < 100; ++i) {
+				sum += comp6771::dot(comp6771::euclidean_vector(a + b * i), a);
+			}
+			benchmark::DoNotOptimize(sum);
+		}
+	}
+	BENCHMARK(bm_short_lived_batch)->Apply(around_inline_capacity);
+} // namespace
@@ -0,0 +1,93 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_stats.hpp"
+
+#include "vector_factory.hpp"
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+// Built once for each COMP6771_EUCLIDEAN_VECTOR_STATS level. With stats off these should match the
+// other euclidean_vector benchmarks, and compare.py on the three builds' results shows what the
+// counters and the timers each cost, e.g. with off.json and counted.json holding the results of
+// euclidean_vector_stats_benchmark and euclidean_vector_stats_counted_benchmark:
+//
+//   tools/compare.py benchmarks off.json counted.json
+namespace {
+	using comp6771::bench::make_vector;
+
+	auto label(benchmark::State& state) -> void {
+		state.SetLabel("stats level " + std::to_string(COMP6771_EUCLIDEAN_VECTOR_STATS));
+	}
+
+	auto bm_dot(benchmark::State& state) -> void {
+		auto const x = make_vector(static_cast<int>(state.range(0)), 0.0);
+		auto const y = make_vector(static_cast<int>(state.range(0)), 1.0);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(x, y));
+		}
+		label(state);
+	}
+	BENCHMARK(bm_dot)->Arg(16)->Arg(4096);
+
+	auto bm_euclidean_norm(benchmark::State& state) -> void {
+		auto v = make_vector(static_cast<int>(state.range(0)), 0.0);
+		for (auto _ : state) {
+			// discards the cached norm, so that every call computes it
+			benchmark::DoNotOptimize(v.magnitudes());
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(v));
+		}
+		label(state);
+	}
+	BENCHMARK(bm_euclidean_norm)->Arg(16)->Arg(4096);
+
+	auto bm_unit(benchmark::State& state) -> void {
+		auto const v = make_vector(static_cast<int>(state.range(0)), 0.0);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::unit(v));
+		}
+		label(state);
+	}
+	BENCHMARK(bm_unit)->Arg(16)->Arg(4096);
+
+	// 16 dimensions are stored inline; 4096 allocate
+	auto bm_copy(benchmark::State& state) -> void {
+		auto const v = make_vector(static_cast<int>(state.range(0)), 0.0);
+		for (auto _ : state) {
+			auto copy = v;
+			benchmark::DoNotOptimize(copy);
+		}
+		label(state);
+	}
+	BENCHMARK(bm_copy)->Arg(16)->Arg(4096);
+
+	auto bm_add_assign(benchmark::State& state) -> void {
+		auto x = make_vector(static_cast<int>(state.range(0)), 0.0);
+		auto const y = make_vector(static_cast<int>(state.range(0)), 1.0);
+		for (auto _ : state) {
+			x += y;
+			benchmark::ClobberMemory();
+		}
+		label(state);
+	}
+	BENCHMARK(bm_add_assign)->Arg(16)->Arg(4096);
+
+	auto bm_evaluate(benchmark::State& state) -> void {
+		auto out = make_vector(static_cast<int>(state.range(0)), 0.0);
+		auto const x = make_vector(static_cast<int>(state.range(0)), 1.0);
+		auto const y = make_vector(static_cast<int>(state.range(0)), 2.0);
+		for (auto _ : state) {
+			out = x + y;
+			benchmark::ClobberMemory();
+		}
+		label(state);
+	}
+	BENCHMARK(bm_evaluate)->Arg(16)->Arg(4096);
+
+	auto bm_take_snapshot(benchmark::State& state) -> void {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::stats::take_snapshot());
+		}
+		label(state);
+	}
+	BENCHMARK(bm_take_snapshot);
+} // namespace
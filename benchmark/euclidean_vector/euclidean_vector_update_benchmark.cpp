@@ -0,0 +1,151 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdint>
+
+// The in-place updates against the operator chains they replace, from a vector that fits in L1 to
+// one that only fits in memory.
+namespace {
+	auto make_vector(int dimensions, double phase) -> comp6771::euclidean_vector {
+		return comp6771::euclidean_vector(dimensions,
+		                                  [phase](int i) { return 1.5 + std::sin(phase + i); });
+	}
+
+	auto set_bytes_processed(benchmark::State& state, std::int64_t vectors_touched) -> void {
+		state.SetBytesProcessed(state.iterations() * vectors_touched * state.range(0)
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	auto update_range(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(16)->Range(16, 1 << 20);
+	}
+
+	// w += alpha * g, the way an optimizer step is written today. The product is an expression, so
+	// there's no temporary, but it's evaluated an element at a time rather than by a kernel.
+	auto bm_axpy_by_operators(benchmark::State& state) -> void {
+		auto w = make_vector(static_cast<int>(state.range(0)), 0.0);
+		auto const g = make_vector(static_cast<int>(state.range(0)), 1.0);
+		for (auto _ : state) {
+			w += g * 1e-9;
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(bm_axpy_by_operators)->Apply(update_range);
+
+	// the same step with the product evaluated into a temporary first
+	auto bm_axpy_by_temporary(benchmark::State& state) -> void {
+		auto w = make_vector(static_cast<int>(state.range(0)), 0.0);
+		auto const g = make_vector(static_cast<int>(state.range(0)), 1.0);
+		for (auto _ : state) {
+			w += comp6771::euclidean_vector(g * 1e-9);
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(bm_axpy_by_temporary)->Apply(update_range);
+
+	auto bm_axpy(benchmark::State& state) -> void {
+		auto w = make_vector(static_cast<int>(state.range(0)), 0.0);
+		auto const g = make_vector(static_cast<int>(state.range(0)), 1.0);
+		for (auto _ : state) {
+			w.axpy(1e-9, g);
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(bm_axpy)->Apply(update_range);
+
+	auto bm_lerp_by_operators(benchmark::State& state) -> void {
+		auto w = make_vector(static_cast<int>(state.range(0)), 0.0);
+		auto const target = make_vector(static_cast<int>(state.range(0)), 1.0);
+		for (auto _ : state) {
+			w = w * 0.999 + target * 0.001;
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(bm_lerp_by_operators)->Apply(update_range);
+
+	auto bm_lerp(benchmark::State& state) -> void {
+		auto w = make_vector(static_cast<int>(state.range(0)), 0.0);
+		auto const target = make_vector(static_cast<int>(state.range(0)), 1.0);
+		for (auto _ : state) {
+			w.lerp(target, 0.001);
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(bm_lerp)->Apply(update_range);
+
+	// the norm is cached after the first iteration in both, so this measures the copy that
+	// unit() makes
+	auto bm_normalize_by_unit(benchmark::State& state) -> void {
+		auto v = make_vector(static_cast<int>(state.range(0)), 0.0);
+		for (auto _ : state) {
+			v = comp6771::unit(v);
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(bm_normalize_by_unit)->Apply(update_range);
+
+	auto bm_normalize(benchmark::State& state) -> void {
+		auto v = make_vector(static_cast<int>(state.range(0)), 0.0);
+		for (auto _ : state) {
+			v.normalize();
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(bm_normalize)->Apply(update_range);
+
+	auto bm_scale_add_by_operators(benchmark::State& state) -> void {
+		auto v = make_vector(static_cast<int>(state.range(0)), 0.0);
+		auto const offset = comp6771::euclidean_vector(static_cast<int>(state.range(0)), 1e-9);
+		for (auto _ : state) {
+			v = v * 0.5 + offset;
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(bm_scale_add_by_operators)->Apply(update_range);
+
+	auto bm_scale_add(benchmark::State& state) -> void {
+		auto v = make_vector(static_cast<int>(state.range(0)), 0.0);
+		for (auto _ : state) {
+			v.scale_add(0.5, 1e-9);
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 2);
+	}
+	BENCHMARK(bm_scale_add)->Apply(update_range);
+
+	// there's no element-wise operator, so the baseline is a loop over operator[]
+	auto bm_hadamard_by_subscript(benchmark::State& state) -> void {
+		auto v = make_vector(static_cast<int>(state.range(0)), 0.0);
+		// ones, so that repeated products can't overflow or slow down in subnormals
+		auto const x = comp6771::euclidean_vector(static_cast<int>(state.range(0)), 1.0);
+		for (auto _ : state) {
+			for (auto i = 0; i < v.dimensions(); ++i) {
+				v[i] *= x[i];
+			}
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(bm_hadamard_by_subscript)->Apply(update_range);
+
+	auto bm_hadamard(benchmark::State& state) -> void {
+		auto v = make_vector(static_cast<int>(state.range(0)), 0.0);
+		// as above
+		auto const x = comp6771::euclidean_vector(static_cast<int>(state.range(0)), 1.0);
+		for (auto _ : state) {
+			v.hadamard(x);
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed(state, 3);
+	}
+	BENCHMARK(bm_hadamard)->Apply(update_range);
+} // namespace
@@ -0,0 +1,58 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/fixed_euclidean_vector.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+	// a + b - c * k on small vectors: the dynamic type allocates the result on every iteration,
+	// the fixed type works entirely in registers
+	template<int N>
+	auto bm_fixed_update(benchmark::State& state) -> void {
+		auto const a = comp6771::fixed_euclidean_vector<N>(1.5);
+		auto const b = comp6771::fixed_euclidean_vector<N>(2.5);
+		auto const c = comp6771::fixed_euclidean_vector<N>(0.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(a + b - c * 0.25);
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_fixed_update, 2);
+	BENCHMARK_TEMPLATE(bm_fixed_update, 3);
+	BENCHMARK_TEMPLATE(bm_fixed_update, 4);
+	BENCHMARK_TEMPLATE(bm_fixed_update, 16);
+
+	template<int N>
+	auto bm_dynamic_update(benchmark::State& state) -> void {
+		auto const a = comp6771::euclidean_vector(N, 1.5);
+		auto const b = comp6771::euclidean_vector(N, 2.5);
+		auto const c = comp6771::euclidean_vector(N, 0.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_vector(a + b - c * 0.25));
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_dynamic_update, 2);
+	BENCHMARK_TEMPLATE(bm_dynamic_update, 3);
+	BENCHMARK_TEMPLATE(bm_dynamic_update, 4);
+	BENCHMARK_TEMPLATE(bm_dynamic_update, 16);
+
+	template<int N>
+	auto bm_fixed_dot(benchmark::State& state) -> void {
+		auto const a = comp6771::fixed_euclidean_vector<N>(1.5);
+		auto const b = comp6771::fixed_euclidean_vector<N>(2.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(dot(a, b));
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_fixed_dot, 3);
+	BENCHMARK_TEMPLATE(bm_fixed_dot, 16);
+
+	template<int N>
+	auto bm_dynamic_dot(benchmark::State& state) -> void {
+		auto const a = comp6771::euclidean_vector(N, 1.5);
+		auto const b = comp6771::euclidean_vector(N, 2.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(a, b));
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_dynamic_dot, 3);
+	BENCHMARK_TEMPLATE(bm_dynamic_dot, 16);
+} // namespace
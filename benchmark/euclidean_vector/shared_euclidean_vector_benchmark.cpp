@@ -0,0 +1,81 @@
+#include "comp6771/shared_euclidean_vector.hpp"
+
+#include "vector_factory.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// What it costs to hand a large read-only vector to a consumer by value, and what the first write
+// to a shared copy costs.
+namespace {
+	using comp6771::bench::make_vector;
+
+	auto make_shared(std::int64_t dimensions) -> comp6771::shared_euclidean_vector {
+		return comp6771::shared_euclidean_vector(make_vector(static_cast<int>(dimensions), 0.0));
+	}
+
+	auto copy_range(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(16)->Range(16, 1 << 20);
+	}
+
+	auto bm_copy_euclidean_vector(benchmark::State& state) -> void {
+		auto const v = make_vector(static_cast<int>(state.range(0)), 0.0);
+		for (auto _ : state) {
+			auto copy = v;
+			benchmark::DoNotOptimize(copy);
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0)
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+	BENCHMARK(bm_copy_euclidean_vector)->Apply(copy_range);
+
+	auto bm_copy_shared_euclidean_vector(benchmark::State& state) -> void {
+		auto const v = make_shared(state.range(0));
+		for (auto _ : state) {
+			auto copy = v;
+			benchmark::DoNotOptimize(copy);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(bm_copy_shared_euclidean_vector)->Apply(copy_range);
+
+	// every thread copies the same vector, so they all hit the same reference count
+	auto bm_copy_shared_euclidean_vector_contended(benchmark::State& state) -> void {
+		static auto const v = comp6771::shared_euclidean_vector(make_vector(1 << 16, 0.0));
+		for (auto _ : state) {
+			auto copy = v;
+			benchmark::DoNotOptimize(copy);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(bm_copy_shared_euclidean_vector_contended)
+	   ->ThreadRange(1, static_cast<int>(std::max(1U, std::thread::hardware_concurrency())));
+
+	// a copy followed by a write: the write pays for the copy that euclidean_vector makes up front
+	auto bm_copy_then_write(benchmark::State& state) -> void {
+		auto const v = make_shared(state.range(0));
+		for (auto _ : state) {
+			auto copy = v;
+			copy[0] = 1.0;
+			benchmark::DoNotOptimize(copy);
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0)
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+	BENCHMARK(bm_copy_then_write)->Apply(copy_range);
+
+	// reading through a copy is as fast as reading the euclidean_vector it shares
+	auto bm_read_shared_copy(benchmark::State& state) -> void {
+		auto const v = make_shared(state.range(0));
+		auto const copy = v;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(copy.vector(), copy.vector()));
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0)
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+	BENCHMARK(bm_read_shared_copy)->Apply(copy_range);
+} // namespace
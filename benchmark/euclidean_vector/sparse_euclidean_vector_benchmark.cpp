@@ -0,0 +1,152 @@
+#include "comp6771/sparse_euclidean_vector.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// Dense euclidean_vector against sparse_euclidean_vector for bag-of-words sized vectors, at
+// 0.1%, 1% and 10% non-zeros (the argument is non-zeros per thousand). Every benchmark reports
+// the bytes of magnitude storage per vector, and the number of dimensions processed per second,
+// so dense and sparse rates compare directly.
+namespace {
+	auto constexpr dimensions = 1 << 20;
+
+	auto density_range(benchmark::internal::Benchmark* b) -> void {
+		b->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+	}
+
+	// about count non-zeros at random indices; different seeds give different index sets
+	auto make_sparse(int count, unsigned seed) -> comp6771::sparse_euclidean_vector {
+		auto engine = std::mt19937(seed);
+		auto index = std::uniform_int_distribution<int>(0, dimensions - 1);
+		auto value = std::uniform_real_distribution<double>(-1.0, 1.0);
+		auto indices = std::vector<int>(static_cast<std::size_t>(count));
+		std::ranges::generate(indices, [&] { return index(engine); });
+		std::ranges::sort(indices);
+		auto const duplicates = std::ranges::unique(indices);
+		indices.erase(duplicates.begin(), duplicates.end());
+		auto values = std::vector<double>(indices.size());
+		std::ranges::generate(values, [&] { return value(engine); });
+		return comp6771::sparse_euclidean_vector(dimensions, indices, values);
+	}
+
+	auto non_zeros_of(benchmark::State const& state) -> int {
+		return dimensions / 1000 * static_cast<int>(state.range(0));
+	}
+
+	auto set_counters(benchmark::State& state, std::size_t bytes) -> void {
+		state.counters["bytes"] = static_cast<double>(bytes);
+		state.counters["dimensions/s"] =
+		   benchmark::Counter(dimensions, benchmark::Counter::kIsIterationInvariantRate);
+	}
+
+	auto sparse_bytes(comp6771::sparse_euclidean_vector const& v) -> std::size_t {
+		return v.indices().size_bytes() + v.values().size_bytes();
+	}
+
+	auto constexpr dense_bytes = sizeof(double) * dimensions;
+
+	//-------------------------------------------dot---------------------------------------------
+	auto make_dense(int count, unsigned seed) -> comp6771::euclidean_vector {
+		return static_cast<comp6771::euclidean_vector>(make_sparse(count, seed));
+	}
+
+	auto bm_dot_dense(benchmark::State& state) -> void {
+		auto const x = make_dense(non_zeros_of(state), 1);
+		auto const y = make_dense(non_zeros_of(state), 2);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(x, y));
+		}
+		set_counters(state, dense_bytes);
+	}
+	BENCHMARK(bm_dot_dense)->Apply(density_range);
+
+	auto bm_dot_sparse_dense(benchmark::State& state) -> void {
+		auto const x = make_sparse(non_zeros_of(state), 1);
+		auto const y = make_dense(non_zeros_of(state), 2);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(x, y));
+		}
+		set_counters(state, sparse_bytes(x));
+	}
+	BENCHMARK(bm_dot_sparse_dense)->Apply(density_range);
+
+	auto bm_dot_sparse_sparse(benchmark::State& state) -> void {
+		auto const x = make_sparse(non_zeros_of(state), 1);
+		auto const y = make_sparse(non_zeros_of(state), 2);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(x, y));
+		}
+		set_counters(state, sparse_bytes(x));
+	}
+	BENCHMARK(bm_dot_sparse_sparse)->Apply(density_range);
+
+	// a short query against a long document, where dot gallops instead of merging
+	auto bm_dot_sparse_sparse_skewed(benchmark::State& state) -> void {
+		auto const query = make_sparse(64, 1);
+		auto const document = make_sparse(non_zeros_of(state), 2);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(query, document));
+		}
+		set_counters(state, sparse_bytes(document));
+	}
+	BENCHMARK(bm_dot_sparse_sparse_skewed)->Apply(density_range);
+
+	//-------------------------------------------+=----------------------------------------------
+	auto bm_add_assign_dense(benchmark::State& state) -> void {
+		auto x = make_dense(non_zeros_of(state), 1);
+		auto const y = make_dense(non_zeros_of(state), 2);
+		for (auto _ : state) {
+			x += y;
+			benchmark::DoNotOptimize(x.magnitudes().data());
+		}
+		set_counters(state, dense_bytes);
+	}
+	BENCHMARK(bm_add_assign_dense)->Apply(density_range);
+
+	auto bm_add_assign_dense_sparse(benchmark::State& state) -> void {
+		auto x = make_dense(non_zeros_of(state), 1);
+		auto const y = make_sparse(non_zeros_of(state), 2);
+		for (auto _ : state) {
+			x += y;
+			benchmark::DoNotOptimize(x.magnitudes().data());
+		}
+		set_counters(state, sparse_bytes(y));
+	}
+	BENCHMARK(bm_add_assign_dense_sparse)->Apply(density_range);
+
+	// after the first iteration x holds the union of the indices, so the merge reuses its storage
+	auto bm_add_assign_sparse(benchmark::State& state) -> void {
+		auto x = make_sparse(non_zeros_of(state), 1);
+		auto const y = make_sparse(non_zeros_of(state), 2);
+		for (auto _ : state) {
+			x += y;
+			benchmark::DoNotOptimize(x.values().data());
+		}
+		set_counters(state, sparse_bytes(x));
+	}
+	BENCHMARK(bm_add_assign_sparse)->Apply(density_range);
+
+	//--------------------------------------euclidean_norm---------------------------------------
+	auto bm_euclidean_norm_dense(benchmark::State& state) -> void {
+		auto const x = make_dense(non_zeros_of(state), 1);
+		for (auto _ : state) {
+			// through a view, so that the norm isn't cached
+			auto const view = comp6771::const_euclidean_vector_view(x);
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(view));
+		}
+		set_counters(state, dense_bytes);
+	}
+	BENCHMARK(bm_euclidean_norm_dense)->Apply(density_range);
+
+	auto bm_euclidean_norm_sparse(benchmark::State& state) -> void {
+		auto const x = make_sparse(non_zeros_of(state), 1);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(x));
+		}
+		set_counters(state, sparse_bytes(x));
+	}
+	BENCHMARK(bm_euclidean_norm_sparse)->Apply(density_range);
+} // namespace
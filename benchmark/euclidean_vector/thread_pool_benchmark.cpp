@@ -0,0 +1,106 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/thread_pool.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Throughput of batch work over euclidean_vectors whose dimensions follow a heavy-tailed
+// distribution: most have a handful of dimensions, a few have tens of thousands. Work stealing
+// is compared with a static split into one contiguous block per thread, both with the vectors
+// shuffled and sorted largest first, which puts all of the expensive vectors in the first block.
+namespace {
+	auto constexpr vectors = 1 << 14;
+
+	enum class order { shuffled, largest_first };
+
+	auto make_vectors(order o) -> std::vector<comp6771::euclidean_vector> {
+		auto engine = std::mt19937(6771);
+		auto dimensions = std::lognormal_distribution(2.5, 1.5);
+		auto sizes = std::vector<int>(vectors);
+		std::generate(sizes.begin(), sizes.end(), [&] {
+			return std::clamp(static_cast<int>(dimensions(engine)), 1, 1 << 16);
+		});
+		if (o == order::largest_first) {
+			std::sort(sizes.begin(), sizes.end(), std::greater<>());
+		}
+		auto result = std::vector<comp6771::euclidean_vector>();
+		result.reserve(sizes.size());
+		for (auto const size : sizes) {
+			result.emplace_back(size, [](int j) { return 1.0 + j % 5; });
+		}
+		return result;
+	}
+
+	auto thread_range(benchmark::internal::Benchmark* b) -> void {
+		auto const max_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+		for (auto threads = 1; threads < max_threads; threads *= 2) {
+			b->Arg(threads);
+		}
+		b->Arg(max_threads)->ArgName("threads")->Unit(benchmark::kMillisecond)->UseRealTime();
+	}
+
+	auto normalise(comp6771::euclidean_vector& v) -> void {
+		v /= comp6771::euclidean_norm(v);
+		v *= 1.0000001; // keeps the norm from being 1 next time round
+	}
+
+	//------------------------------------normalise--------------------------------------------
+	auto bm_normalise_work_stealing(benchmark::State& state, order o) -> void {
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		auto batch = make_vectors(o);
+		for (auto _ : state) {
+			comp6771::parallel_for_each(pool, batch, normalise);
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * vectors);
+	}
+	BENCHMARK_CAPTURE(bm_normalise_work_stealing, shuffled, order::shuffled)->Apply(thread_range);
+	BENCHMARK_CAPTURE(bm_normalise_work_stealing, largest_first, order::largest_first)
+	   ->Apply(thread_range);
+
+	// one task per thread, so there's never anything to steal
+	auto bm_normalise_static(benchmark::State& state, order o) -> void {
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		auto batch = make_vectors(o);
+		auto const threads = static_cast<std::size_t>(pool.size());
+		for (auto _ : state) {
+			pool.parallel_for(threads, [&batch, threads](std::size_t t) {
+				auto const first = batch.size() * t / threads;
+				auto const last = batch.size() * (t + 1) / threads;
+				for (auto i = first; i < last; ++i) {
+					normalise(batch[i]);
+				}
+			});
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * vectors);
+	}
+	BENCHMARK_CAPTURE(bm_normalise_static, shuffled, order::shuffled)->Apply(thread_range);
+	BENCHMARK_CAPTURE(bm_normalise_static, largest_first, order::largest_first)
+	   ->Apply(thread_range);
+
+	//---------------------------------transform_reduce----------------------------------------
+	auto bm_sum_of_norms(benchmark::State& state, order o) -> void {
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		auto const batch = make_vectors(o);
+		for (auto _ : state) {
+			// dot rather than euclidean_norm, so that the norm cache doesn't hide the work
+			benchmark::DoNotOptimize(comp6771::parallel_transform_reduce(
+			   pool,
+			   batch,
+			   0.0,
+			   std::plus<>(),
+			   [](comp6771::euclidean_vector const& v) {
+				   return std::sqrt(comp6771::dot(v, v));
+			   }));
+		}
+		state.SetItemsProcessed(state.iterations() * vectors);
+	}
+	BENCHMARK_CAPTURE(bm_sum_of_norms, shuffled, order::shuffled)->Apply(thread_range);
+	BENCHMARK_CAPTURE(bm_sum_of_norms, largest_first, order::largest_first)->Apply(thread_range);
+} // namespace
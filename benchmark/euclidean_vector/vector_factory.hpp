@@ -0,0 +1,16 @@
+#ifndef COMP6771_BENCHMARK_VECTOR_FACTORY_HPP
+#define COMP6771_BENCHMARK_VECTOR_FACTORY_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+
+#include <cmath>
+
+namespace comp6771::bench {
+	// Magnitude i is sin(phase + i): every magnitude is different, none of them is a round number,
+	// and vectors with different phases point in different directions.
+	inline auto make_vector(int dimensions, double phase) -> euclidean_vector {
+		return euclidean_vector(dimensions, [phase](int i) { return std::sin(phase + i); });
+	}
+} // namespace comp6771::bench
+
+#endif // COMP6771_BENCHMARK_VECTOR_FACTORY_HPP
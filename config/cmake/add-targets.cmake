@@ -47,10 +47,28 @@ endfunction()
 # Builds an executable that can be run as a more reliable benchmark.
 # Accepts the same parameters as `cxx_executable`.
 # Depends on Google Benchmark being imported.
+#
+# Also creates a `benchmark.target_name` target that runs the benchmark and writes its results to
+# ${PROJECT_BINARY_DIR}/benchmark-results/target_name.json, and adds it to the `benchmarks` target,
+# which runs every benchmark. The JSON files can be compared across commits with Google Benchmark's
+# tools/compare.py.
 function(cxx_benchmark)
    cxx_executable(${ARGN})
 
    PROJECT_TEMPLATE_EXTRACT_ADD_TARGET_ARGS(${ARGN})
    target_compile_options("${add_target_args_TARGET}" PRIVATE -fno-inline)
    target_link_libraries("${add_target_args_TARGET}" PRIVATE benchmark::benchmark benchmark::benchmark_main)
+
+   set(results_dir "${PROJECT_BINARY_DIR}/benchmark-results")
+   add_custom_target("benchmark.${add_target_args_TARGET}"
+                     COMMAND "${CMAKE_COMMAND}" -E make_directory "${results_dir}"
+                     COMMAND "${add_target_args_TARGET}"
+                             "--benchmark_out=${results_dir}/${add_target_args_TARGET}.json"
+                             --benchmark_out_format=json
+                     DEPENDS "${add_target_args_TARGET}"
+                     USES_TERMINAL)
+   if(NOT TARGET benchmarks)
+      add_custom_target(benchmarks)
+   endif()
+   add_dependencies(benchmarks "benchmark.${add_target_args_TARGET}")
 endfunction()
@@ -0,0 +1,117 @@
+#ifndef COMP6771_COMPACT_EUCLIDEAN_VECTOR_HPP
+#define COMP6771_COMPACT_EUCLIDEAN_VECTOR_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <concepts>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace comp6771 {
+	// the element types a compact_euclidean_vector can store
+	template<typename T>
+	concept compact_element = std::same_as<T, float> or std::same_as<T, bfloat16>
+	                          or std::same_as<T, std::int8_t>;
+
+	// A read-only euclidean vector that stores its magnitudes in less than a double each, for
+	// workloads such as embeddings where memory and bandwidth matter more than the last digits:
+	//
+	//   - float: 4 bytes, about 7 significant digits
+	//   - bfloat16: 2 bytes, about 2-3 significant digits, with float's range
+	//   - std::int8_t: 1 byte, quantized against a per-vector scale, so magnitude i is
+	//     scale() * element i. The scale maps the largest magnitude to 127, so every magnitude
+	//     is within scale() / 2 of the original, which must be finite.
+	//
+	// dot and euclidean_norm widen the elements and accumulate in double (or, for int8, in
+	// exact integer arithmetic), so the only error is the rounding done when the vector is
+	// created. To change one, convert it to a euclidean_vector and back.
+	template<compact_element T>
+	class compact_euclidean_vector {
+	public:
+		using element_type = T;
+		using allocator_type = std::pmr::polymorphic_allocator<double>;
+
+		//----------------------------constructors---------------------------------
+		// no dimensions
+		compact_euclidean_vector() noexcept = default;
+		// rounds each magnitude of v to the nearest representable value
+		explicit compact_euclidean_vector(const_euclidean_vector_view v,
+		                                  allocator_type const& alloc = allocator_type());
+		// like euclidean_vector, a copy uses the default resource unless given one
+		compact_euclidean_vector(compact_euclidean_vector const&);
+		compact_euclidean_vector(compact_euclidean_vector const&, allocator_type const& alloc);
+		compact_euclidean_vector(compact_euclidean_vector&&) noexcept;
+
+		//---------------------------destructor------------------------------------
+		~compact_euclidean_vector();
+
+		//---------------------------operators-------------------------------------
+		auto operator=(compact_euclidean_vector const&) -> compact_euclidean_vector&;
+		// like the std::pmr containers, this copies when the two use different resources
+		auto operator=(compact_euclidean_vector&&) -> compact_euclidean_vector&;
+		// magnitude i, widened to double
+		auto operator[](int i) const noexcept -> double;
+		// the magnitudes, widened to double
+		explicit operator euclidean_vector() const;
+
+		//-----------------------member functions----------------------------------
+		[[nodiscard]] auto at(int i) const -> double;
+		[[nodiscard]] auto dimensions() const noexcept -> int;
+		// the stored elements, which are scaled by scale()
+		[[nodiscard]] auto elements() const noexcept -> std::span<T const>;
+		// always 1 for float and bfloat16
+		[[nodiscard]] auto scale() const noexcept -> double;
+		[[nodiscard]] auto get_allocator() const noexcept -> allocator_type;
+
+		//-------------------------------friends-----------------------------------
+		// compares the widened magnitudes, with the same tolerance as euclidean_vector's operator==
+		friend auto
+		operator==(compact_euclidean_vector const& lhs, compact_euclidean_vector const& rhs) noexcept
+		   -> bool {
+			if (lhs.dimensions() != rhs.dimensions()) {
+				return false;
+			}
+			for (auto i = 0; i < lhs.dimensions(); ++i) {
+				if (not(std::abs(lhs[i] - rhs[i]) <= euclidean_vector::epsilon)) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+	private:
+		std::pmr::vector<T> elements_;
+		double scale_ = 1.0;
+	};
+
+	using float_euclidean_vector = compact_euclidean_vector<float>;
+	using bfloat16_euclidean_vector = compact_euclidean_vector<bfloat16>;
+	using int8_euclidean_vector = compact_euclidean_vector<std::int8_t>;
+
+	extern template class compact_euclidean_vector<float>;
+	extern template class compact_euclidean_vector<bfloat16>;
+	extern template class compact_euclidean_vector<std::int8_t>;
+
+	//----------------------Utility functions----------------------------------
+	// These throw euclidean_vector_error on the same conditions as the dense overloads.
+	template<compact_element T>
+	auto euclidean_norm(compact_euclidean_vector<T> const& v) -> double;
+	template<compact_element T>
+	auto dot(compact_euclidean_vector<T> const& x, compact_euclidean_vector<T> const& y) -> double;
+
+	extern template auto euclidean_norm(compact_euclidean_vector<float> const&) -> double;
+	extern template auto euclidean_norm(compact_euclidean_vector<bfloat16> const&) -> double;
+	extern template auto euclidean_norm(compact_euclidean_vector<std::int8_t> const&) -> double;
+	extern template auto dot(compact_euclidean_vector<float> const&,
+	                         compact_euclidean_vector<float> const&) -> double;
+	extern template auto dot(compact_euclidean_vector<bfloat16> const&,
+	                         compact_euclidean_vector<bfloat16> const&) -> double;
+	extern template auto dot(compact_euclidean_vector<std::int8_t> const&,
+	                         compact_euclidean_vector<std::int8_t> const&) -> double;
+} // namespace comp6771
+
+#endif // COMP6771_COMPACT_EUCLIDEAN_VECTOR_HPP
@@ -0,0 +1,143 @@
+#ifndef COMP6771_EUCLIDEAN_MATRIX_HPP
+#define COMP6771_EUCLIDEAN_MATRIX_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace comp6771 {
+	enum class matrix_layout {
+		// each vector's magnitudes are contiguous
+		row_major,
+		// magnitude j of every vector is contiguous (structure of arrays)
+		column_major,
+	};
+
+	// A batch of rows() euclidean vectors that all have dimensions() dimensions, stored in a single
+	// block of memory instead of one allocation per vector. Every row (in row-major layout) or
+	// column (in column-major layout) starts on a cache line; the gaps are padding, and are zero.
+	//
+	// In row-major layout, row(i) is a euclidean_vector_view that can be used wherever a
+	// euclidean_vector can. In column-major layout, column(j) is a view of magnitude j of every
+	// row, and the batched functions below vectorise across rows instead of along them.
+	class euclidean_matrix {
+	public:
+		using allocator_type = std::pmr::polymorphic_allocator<double>;
+		static std::size_t constexpr storage_alignment = euclidean_vector::storage_alignment;
+
+		//----------------------------constructors---------------------------------
+		euclidean_matrix() noexcept;
+		// rows vectors of the given dimensions, with every magnitude set to value
+		euclidean_matrix(int rows,
+		                 int dimensions,
+		                 double value = 0.0,
+		                 matrix_layout layout = matrix_layout::row_major,
+		                 allocator_type const& alloc = allocator_type());
+		// copies the vectors, which must all have the same dimensions, into the rows
+		explicit euclidean_matrix(std::span<euclidean_vector const> vectors,
+		                          matrix_layout layout = matrix_layout::row_major,
+		                          allocator_type const& alloc = allocator_type());
+		// like euclidean_vector, a copy uses the default resource unless given one
+		euclidean_matrix(euclidean_matrix const&);
+		euclidean_matrix(euclidean_matrix const&, allocator_type const& alloc);
+		// copies orig into the given layout
+		euclidean_matrix(euclidean_matrix const& orig,
+		                 matrix_layout layout,
+		                 allocator_type const& alloc = allocator_type());
+		euclidean_matrix(euclidean_matrix&&) noexcept;
+
+		//---------------------------destructor------------------------------------
+		~euclidean_matrix();
+
+		//---------------------------operators-------------------------------------
+		auto operator=(euclidean_matrix const&) -> euclidean_matrix&;
+		// only takes over oth's storage if oth uses an equal resource; copies it otherwise, so this
+		// throws whatever the resource throws when it can't allocate
+		auto operator=(euclidean_matrix&&) -> euclidean_matrix&;
+		auto operator()(int row, int dimension) noexcept -> double&;
+		auto operator()(int row, int dimension) const noexcept -> double;
+
+		//-----------------------member functions----------------------------------
+		[[nodiscard]] auto rows() const noexcept -> int;
+		[[nodiscard]] auto dimensions() const noexcept -> int;
+		[[nodiscard]] auto layout() const noexcept -> matrix_layout;
+		// distance, in doubles, between the starts of consecutive rows (row-major) or columns
+		// (column-major)
+		[[nodiscard]] auto stride() const noexcept -> std::size_t;
+		[[nodiscard]] auto get_allocator() const noexcept -> allocator_type;
+
+		// Views of row i. Throw euclidean_vector_error if i is out of range, or if the matrix is
+		// column-major, where a row isn't contiguous.
+		[[nodiscard]] auto row(int i) -> euclidean_vector_view;
+		[[nodiscard]] auto row(int i) const -> const_euclidean_vector_view;
+		// Views of magnitude j of every row. Throw euclidean_vector_error if j is out of range, or
+		// if the matrix is row-major.
+		[[nodiscard]] auto column(int j) -> euclidean_vector_view;
+		[[nodiscard]] auto column(int j) const -> const_euclidean_vector_view;
+
+		// copies row i out of, or into, either layout
+		[[nodiscard]] auto get_row(int i) const -> euclidean_vector;
+		auto set_row(int i, const_euclidean_vector_view v) -> void;
+
+	private:
+		int rows_ = 0;
+		int dimensions_ = 0;
+		matrix_layout layout_ = matrix_layout::row_major;
+		std::size_t stride_ = 0;
+		double* data_ = nullptr;
+		allocator_type allocator_;
+
+		[[nodiscard]] auto storage_size() const noexcept -> std::size_t;
+		[[nodiscard]] auto index_of(int row, int dimension) const noexcept -> std::size_t;
+		auto allocate(int rows, int dimensions, matrix_layout layout) -> void;
+		auto deallocate() noexcept -> void;
+		auto check_row(int i) const -> void;
+		auto check_column(int j) const -> void;
+		auto check_row_view(int i) const -> void;
+		auto check_column_view(int j) const -> void;
+
+		friend auto dot(euclidean_matrix const& m,
+		                const_euclidean_vector_view v,
+		                std::span<double> result) -> void;
+		friend auto dot(euclidean_matrix const& queries, euclidean_matrix const& candidates)
+		   -> euclidean_matrix;
+		friend auto euclidean_norm(euclidean_matrix const& m) -> std::vector<double>;
+		friend auto unit(euclidean_matrix const& m) -> euclidean_matrix;
+	};
+
+	//----------------------Utility functions----------------------------------
+	// element i is dot(m row i, v); throws if v doesn't have m.dimensions() dimensions
+	auto dot(euclidean_matrix const& m, const_euclidean_vector_view v) -> std::vector<double>;
+	// as above, but writes into result, which must have m.rows() elements, instead of allocating
+	auto dot(euclidean_matrix const& m, const_euclidean_vector_view v, std::span<double> result)
+	   -> void;
+	// A queries.rows() x candidates.rows() row-major matrix, where element (i, j) is
+	// dot(queries row i, candidates row j). Throws if the two don't have the same dimensions.
+	auto dot(euclidean_matrix const& queries, euclidean_matrix const& candidates)
+	   -> euclidean_matrix;
+
+	// Element i is the cosine similarity of row i and query. norms must hold euclidean_norm(m):
+	// compute it once and reuse it for every query against the same rows. query's norm comes from
+	// its own cache. Throws if norms doesn't have m.rows() elements, or if any norm is zero.
+	auto cosine_similarity(euclidean_matrix const& m,
+	                       std::span<double const> norms,
+	                       euclidean_vector const& query) -> std::vector<double>;
+	auto cosine_similarity(euclidean_matrix const& m, euclidean_vector const& query)
+	   -> std::vector<double>;
+	// element (i, j) is the cosine similarity of queries row i and candidates row j
+	auto cosine_similarity(euclidean_matrix const& queries,
+	                       euclidean_matrix const& candidates,
+	                       std::span<double const> candidate_norms) -> euclidean_matrix;
+	auto cosine_similarity(euclidean_matrix const& queries, euclidean_matrix const& candidates)
+	   -> euclidean_matrix;
+	// element i is the euclidean norm of row i
+	auto euclidean_norm(euclidean_matrix const& m) -> std::vector<double>;
+	// every row divided by its norm, in the same layout; throws if any row has a zero norm
+	auto unit(euclidean_matrix const& m) -> euclidean_matrix;
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_MATRIX_HPP
@@ -1,19 +1,38 @@
 #ifndef COMP6771_EUCLIDEAN_VECTOR_HPP
 #define COMP6771_EUCLIDEAN_VECTOR_HPP
 
+#include "comp6771/euclidean_vector_stats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <compare>
+#include <concepts>
+#include <cstddef>
 #include <functional>
 #include <list>
 #include <memory>
+#include <memory_resource>
 #include <ostream>
 #include <range/v3/algorithm.hpp>
 #include <range/v3/iterator.hpp>
+#include <ranges>
 #include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+// Vectors with at most this many dimensions store their magnitudes inside the euclidean_vector
+// object instead of on the heap. Define it before including this header to change the threshold;
+// every translation unit in a program must agree on the value.
+#ifndef COMP6771_EUCLIDEAN_VECTOR_INLINE_CAPACITY
+#	define COMP6771_EUCLIDEAN_VECTOR_INLINE_CAPACITY 16
+#endif
+
 namespace comp6771 {
 	class euclidean_vector_error : public std::runtime_error {
 	public:
@@ -21,11 +40,117 @@ namespace comp6771 {
 		: std::runtime_error(what) {}
 	};
 
+	// Selects the euclidean_vector constructor that leaves the magnitudes uninitialized, for
+	// callers that are about to overwrite all of them anyway.
+	struct uninitialized_t {
+		explicit uninitialized_t() = default;
+	};
+	inline constexpr auto uninitialized = uninitialized_t();
+
+	class euclidean_vector;
+
+	template<typename T>
+	requires std::same_as<std::remove_const_t<T>, double>
+	class basic_euclidean_vector_view;
+
+	//---------------------------expression templates--------------------------------
+	// The binary arithmetic operators don't compute anything: they return a lightweight expression
+	// node that refers to (or, for temporaries, owns) its operands. The whole expression is
+	// evaluated in a single loop, with no intermediate vectors, when it's assigned to or used to
+	// construct a euclidean_vector. An expression refers to its lvalue operands, so it must not
+	// outlive them; convert it to a euclidean_vector to keep the result around.
+	namespace detail {
+		// base class of every expression node
+		struct expression_node {};
+
+		template<typename T>
+		concept expression_node_type = std::derived_from<std::remove_cvref_t<T>, expression_node>;
+
+		// base class of the non-owning views, which expressions read like euclidean_vectors
+		struct view_node {};
+
+		template<typename T>
+		concept view_node_type = std::derived_from<std::remove_cvref_t<T>, view_node>;
+
+		// what euclidean_vector's templated members accept besides a euclidean_vector
+		template<typename T>
+		concept lazy_vector_type = expression_node_type<T> or view_node_type<T>;
+
+		// reads a euclidean_vector's magnitudes during evaluation
+		struct leaf_evaluator {
+			double const* data;
+
+			auto operator()(std::size_t i) const noexcept -> double {
+				return data[i];
+			}
+		};
+
+		inline auto make_evaluator(euclidean_vector const&) noexcept -> leaf_evaluator;
+	} // namespace detail
+
+	// a euclidean_vector, a view, or an expression built from them
+	template<typename T>
+	concept vector_expression = std::same_as<std::remove_cvref_t<T>, euclidean_vector>
+	                            or detail::lazy_vector_type<T>;
+
+	// f(i) gives magnitude i
+	template<typename F>
+	concept magnitude_generator = std::invocable<F&, int>
+	                              and std::convertible_to<std::invoke_result_t<F&, int>, double>;
+
+	// a range whose elements can all be copied into a euclidean_vector in one pass
+	template<typename R>
+	concept magnitude_range = std::ranges::input_range<R> and std::ranges::sized_range<R>
+	                          and std::is_arithmetic_v<std::ranges::range_value_t<R>>;
+
+	// Heap storage released from a euclidean_vector by release(), along with the allocator it came
+	// from. Like std::unique_ptr, it frees the magnitudes when it's destroyed, unless a
+	// euclidean_vector adopts them first.
+	class magnitude_storage {
+	public:
+		using allocator_type = std::pmr::polymorphic_allocator<double>;
+
+		magnitude_storage() noexcept = default;
+		magnitude_storage(magnitude_storage const&) = delete;
+		magnitude_storage(magnitude_storage&& orig) noexcept;
+		~magnitude_storage();
+
+		auto operator=(magnitude_storage const&) -> magnitude_storage& = delete;
+		auto operator=(magnitude_storage&& oth) noexcept -> magnitude_storage&;
+
+		// starts at a multiple of euclidean_vector::storage_alignment
+		[[nodiscard]] auto magnitudes() const noexcept -> std::span<double>;
+		[[nodiscard]] auto get_allocator() const noexcept -> allocator_type;
+
+	private:
+		friend class euclidean_vector;
+
+		double* magnitudes_ = nullptr;
+		int dimensions_ = 0;
+		// a pointer rather than an allocator_type, which can't be assigned
+		std::pmr::memory_resource* resource_ = std::pmr::get_default_resource();
+
+		magnitude_storage(double* magnitudes, int dimensions, allocator_type const& alloc) noexcept;
+		auto reset() noexcept -> void;
+	};
+
 	class euclidean_vector {
 	public:
 		//------------------------threshold for firend == -------------------------
 		static double constexpr epsilon = 0.0000001;
 
+		// vectors with at most this many dimensions never allocate
+		static int constexpr inline_capacity = COMP6771_EUCLIDEAN_VECTOR_INLINE_CAPACITY;
+
+		// the magnitudes always start on a cache line, whether they're stored inline or not
+		static std::size_t constexpr storage_alignment = 64;
+
+		// Magnitudes that don't fit inline come from this allocator's memory_resource. Like the
+		// std::pmr containers, a vector keeps the resource it was constructed with for its whole
+		// lifetime: copy construction uses the default resource unless one is passed explicitly, move
+		// construction takes the source's resource, and assignment never changes the resource.
+		using allocator_type = std::pmr::polymorphic_allocator<double>;
+
 		//----------------------------constructors---------------------------------
 		euclidean_vector() noexcept;
 		explicit euclidean_vector(int) noexcept;
@@ -35,38 +160,115 @@ namespace comp6771 {
 		euclidean_vector(std::initializer_list<double>) noexcept;
 		euclidean_vector(euclidean_vector const&) noexcept;
 		euclidean_vector(euclidean_vector&&) noexcept;
+		// evaluates the expression in a single pass
+		template<detail::expression_node_type E>
+		euclidean_vector(E const& expr); // NOLINT(google-explicit-constructor)
+		// The magnitudes are left uninitialized: write every one of them before reading any.
+		euclidean_vector(uninitialized_t, int) noexcept;
+		// magnitude i is generator(i), for i = 0, 1, ..., dimensions - 1 in that order
+		template<magnitude_generator F>
+		euclidean_vector(int dimensions, F generator);
+		// copies any sized range of arithmetic values, converting each to double
+		template<magnitude_range R>
+		explicit euclidean_vector(R&& range);
+		// Copies magnitudes, then frees its storage. This is no faster than copying from an lvalue:
+		// a std::vector's storage isn't aligned to storage_alignment, so it can't be taken over, and
+		// the copy allocates just the same. It only saves the caller from clearing magnitudes.
+		explicit euclidean_vector(std::vector<double>&& magnitudes);
+		// Adopts storage's magnitudes and allocator without copying them. Storage with at most
+		// inline_capacity dimensions is copied inline and freed instead.
+		explicit euclidean_vector(magnitude_storage&& storage) noexcept;
+
+		//---------------------allocator-extended constructors---------------------
+		// Same as above, but storage comes from alloc.resource(). These throw whatever the resource
+		// throws when it can't allocate.
+		explicit euclidean_vector(allocator_type const& alloc);
+		euclidean_vector(int, allocator_type const& alloc);
+		euclidean_vector(int, double, allocator_type const& alloc);
+		euclidean_vector(std::vector<double>::const_iterator,
+		                 std::vector<double>::const_iterator,
+		                 allocator_type const& alloc);
+		euclidean_vector(std::initializer_list<double>, allocator_type const& alloc);
+		euclidean_vector(euclidean_vector const&, allocator_type const& alloc);
+		// only takes over orig's storage if orig uses an equal resource; copies it otherwise
+		euclidean_vector(euclidean_vector&& orig, allocator_type const& alloc);
+		euclidean_vector(uninitialized_t, int, allocator_type const& alloc);
+		template<magnitude_generator F>
+		euclidean_vector(int dimensions, F generator, allocator_type const& alloc);
+		template<magnitude_range R>
+		euclidean_vector(R&& range, allocator_type const& alloc);
+		euclidean_vector(std::vector<double>&& magnitudes, allocator_type const& alloc);
 
 		//---------------------------destructor------------------------------------
-		~euclidean_vector() = default;
+		~euclidean_vector();
 
 		//---------------------------operators-------------------------------------
-		auto operator=(euclidean_vector const&) noexcept -> euclidean_vector&;
-		auto operator=(euclidean_vector&&) noexcept -> euclidean_vector&;
+		// Assignment keeps our resource, so moving from a vector with a different resource copies
+		// into our storage. Both throw whatever the resource throws when it can't allocate, and
+		// leave *this with no dimensions if it does.
+		auto operator=(euclidean_vector const&) -> euclidean_vector&;
+		auto operator=(euclidean_vector&&) -> euclidean_vector&;
+		template<detail::lazy_vector_type E>
+		auto operator=(E const& expr) -> euclidean_vector&;
 		auto operator[](int) noexcept -> double&;
 		auto operator[](int) const noexcept -> double;
-		auto operator+() const noexcept -> euclidean_vector;
-		auto operator-() const noexcept -> euclidean_vector;
+		auto operator+() const& noexcept -> euclidean_vector;
+		auto operator+() && noexcept -> euclidean_vector;
+		auto operator-() const& noexcept -> euclidean_vector;
+		// negates in place and moves the result out, so it never allocates
+		auto operator-() && noexcept -> euclidean_vector;
 		auto operator+=(euclidean_vector const&) -> euclidean_vector&;
 		auto operator-=(euclidean_vector const&) -> euclidean_vector&;
+		template<detail::lazy_vector_type E>
+		auto operator+=(E const& expr) -> euclidean_vector&;
+		template<detail::lazy_vector_type E>
+		auto operator-=(E const& expr) -> euclidean_vector&;
 		auto operator*=(double) noexcept -> euclidean_vector&;
 		auto operator/=(double) -> euclidean_vector&;
-		explicit operator std::vector<double>() const noexcept;
-		explicit operator std::list<double>() const noexcept;
+		explicit operator std::vector<double>() const& noexcept;
+		explicit operator std::list<double>() const& noexcept;
+		// Neither container can take over storage from a memory_resource, so these still copy, but
+		// they leave *this with no dimensions and free its storage as soon as the copy is made.
+		explicit operator std::vector<double>() && noexcept;
+		explicit operator std::list<double>() && noexcept;
 
 		//-----------------------member functions----------------------------------
 		[[nodiscard]] auto at(int) const -> double;
 		[[nodiscard]] auto at(int) -> double&;
 		[[nodiscard]] auto dimensions() const noexcept -> int;
+		[[nodiscard]] auto get_allocator() const noexcept -> allocator_type;
+		// All the magnitudes, starting at an address that is a multiple of storage_alignment, which
+		// the compiler is told about so loops over them can use aligned vector loads. Like the
+		// non-const operator[], the non-const overload discards the cached norm, and the span is
+		// invalidated by anything that changes the dimensions.
+		[[nodiscard]] auto magnitudes() noexcept -> std::span<double>;
+		[[nodiscard]] auto magnitudes() const noexcept -> std::span<double const>;
+		// Hands the magnitudes' storage over to the caller, leaving *this with no dimensions.
+		// Allocated storage is passed on as is; inline magnitudes are first copied into storage from
+		// the allocator.
+		[[nodiscard]] auto release() -> magnitude_storage;
+
+		// In-place updates that read and write each magnitude once and never allocate, unlike the
+		// operator expressions they replace. Those taking another vector throw
+		// euclidean_vector_error if its dimensions don't match.
+		// *this += alpha * x
+		auto axpy(double alpha, euclidean_vector const& x) -> euclidean_vector&;
+		// *this = alpha * x + beta * *this
+		auto axpby(double alpha, euclidean_vector const& x, double beta) -> euclidean_vector&;
+		// *this = (1 - t) * *this + t * other, which is exactly other when t is 1
+		auto lerp(euclidean_vector const& other, double t) -> euclidean_vector&;
+		// *this = unit(*this) without the copy, using the cached norm if there is one; throws
+		// whenever unit() would
+		auto normalize() -> euclidean_vector&;
+		// each magnitude m becomes m * alpha + beta; see kernels::scale_add for its rounding
+		auto scale_add(double alpha, double beta) noexcept -> euclidean_vector&;
+		// multiplies, or divides, each magnitude by the matching magnitude of x
+		auto hadamard(euclidean_vector const& x) -> euclidean_vector&;
+		auto divide(euclidean_vector const& x) -> euclidean_vector&;
 
 		//--------------------------friends----------------------------------------
 		friend auto operator==(euclidean_vector const&, euclidean_vector const&) noexcept -> bool;
 		friend auto operator!=(euclidean_vector const&, euclidean_vector const&) noexcept -> bool;
-		friend auto operator+(euclidean_vector const& lhs, euclidean_vector const& rhs)
-		   -> euclidean_vector;
-		friend auto operator-(euclidean_vector const& lhs, euclidean_vector const& rhs)
-		   -> euclidean_vector;
-		friend auto operator*(euclidean_vector const&, double) noexcept -> euclidean_vector;
-		friend auto operator/(euclidean_vector const&, double) -> euclidean_vector;
 		friend auto operator<<(std::ostream&, euclidean_vector const&) noexcept -> std::ostream&;
 
 		//----------------------Utility functions----------------------------------
@@ -74,14 +276,306 @@ namespace comp6771 {
 		friend auto unit(euclidean_vector const& v) -> euclidean_vector;
 		friend auto dot(euclidean_vector const& x, euclidean_vector const& y) -> double;
 
+		friend auto detail::make_evaluator(euclidean_vector const&) noexcept
+		   -> detail::leaf_evaluator;
+		// a mutable view of a euclidean_vector discards its cached norm whenever it's written through
+		friend class basic_euclidean_vector_view<double>;
+
 	private:
 		//-----------------------artributes----------------------------------------
-		int dimensions_;
-		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		std::unique_ptr<double[]> magnitudes_;
+		int dimensions_ = 0;
+		// points to inline_magnitudes_ for vectors of up to inline_capacity dimensions, and to heap
+		// storage owned by this object otherwise
+		double* magnitudes_ = inline_magnitudes_.data();
+		alignas(storage_alignment) std::array<double, inline_capacity> inline_magnitudes_;
+		allocator_type allocator_;
+		// lazily computed euclidean norm; a negative value means "not computed yet". It is atomic so
+		// that concurrent readers calling euclidean_norm() on the same const vector don't race.
+		// Every non-const access invalidates it, so don't hold on to a reference returned by the
+		// non-const operator[] or at() across a call to euclidean_norm() or unit().
+		mutable std::atomic<double> norm_cache_{no_cached_norm};
+		static double constexpr no_cached_norm = -1.0;
+
+		auto invalidate_norm() noexcept -> void {
+			norm_cache_.store(no_cached_norm, std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] auto aligned_magnitudes() const noexcept -> double* {
+			return std::assume_aligned<storage_alignment>(magnitudes_);
+		}
+
+		auto allocate(int dimensions) -> void;
+		auto deallocate() noexcept -> void;
+		auto take_magnitudes(euclidean_vector& orig) noexcept -> void;
+		auto copy_magnitudes(euclidean_vector const& orig) -> void;
+
+		// calls op(magnitude, value) for each magnitude and the matching value of expr, which must
+		// have our dimensions
+		template<typename E, typename Op>
+		auto evaluate_into(E const& expr, Op op) noexcept -> void;
 	};
 	auto euclidean_norm(euclidean_vector const& v) -> double;
 	auto unit(euclidean_vector const& v) -> euclidean_vector;
 	auto dot(euclidean_vector const& x, euclidean_vector const& y) -> double;
+
+	//------------------------------expression nodes---------------------------------
+	namespace detail {
+		// lvalue euclidean_vectors are referred to, everything else (including views) is stored by
+		// value
+		template<typename T>
+		using operand_t = std::conditional_t<
+		   std::is_lvalue_reference_v<T> and std::same_as<std::remove_cvref_t<T>, euclidean_vector>,
+		   euclidean_vector const&,
+		   std::remove_cvref_t<T>>;
+
+		inline auto make_evaluator(euclidean_vector const& v) noexcept -> leaf_evaluator {
+			return leaf_evaluator{v.magnitudes_};
+		}
+
+		// reads through the view's span directly, since data() on a mutable view is a write
+		template<view_node_type V>
+		auto make_evaluator(V const& view) noexcept -> leaf_evaluator {
+			return leaf_evaluator{view.magnitudes_.data()};
+		}
+
+		template<expression_node_type E>
+		auto make_evaluator(E const& expr) noexcept {
+			return expr.evaluator();
+		}
+
+		template<vector_expression E>
+		auto dimensions_of(E const& expr) noexcept -> int {
+			return expr.dimensions();
+		}
+
+		template<typename Lhs, typename Rhs, typename Op>
+		class binary_expression : public expression_node {
+		public:
+			template<typename L, typename R>
+			binary_expression(L&& lhs, R&& rhs)
+			: lhs_(std::forward<L>(lhs))
+			, rhs_(std::forward<R>(rhs)) {
+				if (dimensions_of(lhs_) != dimensions_of(rhs_)) {
+					stats::count(stats::counter::dimension_mismatches);
+					throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+				}
+			}
+
+			[[nodiscard]] auto dimensions() const noexcept -> int {
+				return dimensions_of(lhs_);
+			}
+
+			[[nodiscard]] auto evaluator() const noexcept {
+				auto const lhs = make_evaluator(lhs_);
+				auto const rhs = make_evaluator(rhs_);
+				return [lhs, rhs](std::size_t i) noexcept { return Op{}(lhs(i), rhs(i)); };
+			}
+
+		private:
+			Lhs lhs_;
+			Rhs rhs_;
+		};
+
+		template<typename Vec, typename Op>
+		class scalar_expression : public expression_node {
+		public:
+			template<typename V>
+			scalar_expression(V&& vec, double scalar)
+			: vec_(std::forward<V>(vec))
+			, scalar_{scalar} {}
+
+			[[nodiscard]] auto dimensions() const noexcept -> int {
+				return dimensions_of(vec_);
+			}
+
+			[[nodiscard]] auto evaluator() const noexcept {
+				return [vec = make_evaluator(vec_), scalar = scalar_](std::size_t i) noexcept {
+					return Op{}(vec(i), scalar);
+				};
+			}
+
+		private:
+			Vec vec_;
+			double scalar_;
+		};
+
+		template<typename Vec>
+		class negate_expression : public expression_node {
+		public:
+			template<typename V>
+			explicit negate_expression(V&& vec)
+			: vec_(std::forward<V>(vec)) {}
+
+			[[nodiscard]] auto dimensions() const noexcept -> int {
+				return dimensions_of(vec_);
+			}
+
+			[[nodiscard]] auto evaluator() const noexcept {
+				return [vec = make_evaluator(vec_)](std::size_t i) noexcept { return -vec(i); };
+			}
+
+		private:
+			Vec vec_;
+		};
+	} // namespace detail
+
+	//---------------------------expression operators--------------------------------
+	template<vector_expression L, vector_expression R>
+	auto operator+(L&& lhs, R&& rhs)
+	   -> detail::binary_expression<detail::operand_t<L>, detail::operand_t<R>, std::plus<>> {
+		return {std::forward<L>(lhs), std::forward<R>(rhs)};
+	}
+
+	template<vector_expression L, vector_expression R>
+	auto operator-(L&& lhs, R&& rhs)
+	   -> detail::binary_expression<detail::operand_t<L>, detail::operand_t<R>, std::minus<>> {
+		return {std::forward<L>(lhs), std::forward<R>(rhs)};
+	}
+
+	template<vector_expression V>
+	auto operator*(V&& vec, double factor) noexcept
+	   -> detail::scalar_expression<detail::operand_t<V>, std::multiplies<>> {
+		return {std::forward<V>(vec), factor};
+	}
+
+	template<vector_expression V>
+	auto operator/(V&& vec, double divisor)
+	   -> detail::scalar_expression<detail::operand_t<V>, std::divides<>> {
+		if (divisor == 0) {
+			throw euclidean_vector_error("Invalid vector division by 0");
+		}
+		return {std::forward<V>(vec), divisor};
+	}
+
+	// An rvalue euclidean_vector on the left already owns storage for the result, so these work in
+	// place rather than building an expression that would allocate a new vector when evaluated.
+	template<vector_expression R>
+	auto operator+(euclidean_vector&& lhs, R&& rhs) -> euclidean_vector {
+		lhs += rhs;
+		return std::move(lhs);
+	}
+
+	template<vector_expression R>
+	auto operator-(euclidean_vector&& lhs, R&& rhs) -> euclidean_vector {
+		lhs -= rhs;
+		return std::move(lhs);
+	}
+
+	// euclidean_vector has its own member unary -, which returns a euclidean_vector
+	template<detail::lazy_vector_type E>
+	auto operator-(E&& expr) -> detail::negate_expression<std::remove_cvref_t<E>> {
+		return detail::negate_expression<std::remove_cvref_t<E>>(std::forward<E>(expr));
+	}
+
+	// Compares element by element, with the same tolerance as euclidean_vector's operator==, without
+	// materialising either side.
+	template<vector_expression L, vector_expression R>
+	requires detail::lazy_vector_type<L> or detail::lazy_vector_type<R>
+	auto operator==(L const& lhs, R const& rhs) -> bool {
+		if (detail::dimensions_of(lhs) != detail::dimensions_of(rhs)) {
+			return false;
+		}
+		auto const l = detail::make_evaluator(lhs);
+		auto const r = detail::make_evaluator(rhs);
+		auto const size = static_cast<std::size_t>(detail::dimensions_of(lhs));
+		for (auto i = std::size_t{0}; i < size; ++i) {
+			if (not(std::abs(l(i) - r(i)) <= euclidean_vector::epsilon)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<vector_expression L, vector_expression R>
+	requires detail::lazy_vector_type<L> or detail::lazy_vector_type<R>
+	auto operator!=(L const& lhs, R const& rhs) -> bool {
+		return not(lhs == rhs);
+	}
+
+	// printing an expression evaluates it first
+	template<detail::lazy_vector_type E>
+	auto operator<<(std::ostream& os, E const& expr) -> std::ostream& {
+		return os << euclidean_vector(expr);
+	}
+
+	//---------------------------expression evaluation-------------------------------
+	template<typename E, typename Op>
+	auto euclidean_vector::evaluate_into(E const& expr, Op op) noexcept -> void {
+		// every element only depends on the same index of each operand, so writing in place is
+		// safe even when *this is one of the operands
+		auto const recording = stats::scoped_operation(stats::operation::evaluate,
+		                                               static_cast<std::size_t>(dimensions_));
+		auto const evaluate = detail::make_evaluator(expr);
+		auto* const out = aligned_magnitudes();
+		auto const size = static_cast<std::size_t>(dimensions_);
+		for (auto i = std::size_t{0}; i < size; ++i) {
+			op(out[i], evaluate(i));
+		}
+		invalidate_norm();
+	}
+
+	template<detail::expression_node_type E>
+	euclidean_vector::euclidean_vector(E const& expr) {
+		allocate(expr.dimensions());
+		evaluate_into(expr, [](double& out, double value) { out = value; });
+	}
+
+	template<magnitude_generator F>
+	euclidean_vector::euclidean_vector(int dimensions, F generator)
+	: euclidean_vector(dimensions, std::move(generator), allocator_type()) {}
+
+	template<magnitude_generator F>
+	euclidean_vector::euclidean_vector(int dimensions, F generator, allocator_type const& alloc)
+	: euclidean_vector(uninitialized, dimensions, alloc) {
+		auto* const out = aligned_magnitudes();
+		for (auto i = 0; i < dimensions_; ++i) {
+			out[i] = static_cast<double>(std::invoke(generator, i));
+		}
+	}
+
+	template<magnitude_range R>
+	euclidean_vector::euclidean_vector(R&& range)
+	: euclidean_vector(std::forward<R>(range), allocator_type()) {}
+
+	template<magnitude_range R>
+	euclidean_vector::euclidean_vector(R&& range, allocator_type const& alloc)
+	: euclidean_vector(uninitialized, static_cast<int>(std::ranges::size(range)), alloc) {
+		std::ranges::transform(range, aligned_magnitudes(), [](auto value) {
+			return static_cast<double>(value);
+		});
+	}
+
+	template<detail::lazy_vector_type E>
+	auto euclidean_vector::operator=(E const& expr) -> euclidean_vector& {
+		if (expr.dimensions() == dimensions_) {
+			evaluate_into(expr, [](double& out, double value) { out = value; });
+		}
+		else {
+			// the expression may still refer to our current magnitudes, so evaluate it into new
+			// storage before replacing them
+			*this = euclidean_vector(expr);
+		}
+		return *this;
+	}
+
+	template<detail::lazy_vector_type E>
+	auto euclidean_vector::operator+=(E const& expr) -> euclidean_vector& {
+		if (dimensions_ != expr.dimensions()) {
+			stats::count(stats::counter::dimension_mismatches);
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		evaluate_into(expr, [](double& out, double value) { out += value; });
+		return *this;
+	}
+
+	template<detail::lazy_vector_type E>
+	auto euclidean_vector::operator-=(E const& expr) -> euclidean_vector& {
+		if (dimensions_ != expr.dimensions()) {
+			stats::count(stats::counter::dimension_mismatches);
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		evaluate_into(expr, [](double& out, double value) { out -= value; });
+		return *this;
+	}
 } // namespace comp6771
 #endif // COMP6771_EUCLIDEAN_VECTOR_HPP
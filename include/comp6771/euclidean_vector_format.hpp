@@ -0,0 +1,155 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_FORMAT_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_FORMAT_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <fmt/format.h>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+// Text formatting and parsing for euclidean_vectors that, unlike operator<<, round-trips.
+//
+// By default every magnitude is written in the fewest digits that parse back to exactly the same
+// double, using std::to_chars, so the text is both lossless and short. The output has the same
+// "[a b c]" shape as operator<<:
+//
+//     fmt::format("{}", v)      // [0.1 0.30000000000000004 1e+100]
+//     fmt::format("{:,.2e}", v) // [1.00e-01,3.00e-01,1.00e+100]
+//
+// The format spec is [separator][.precision][type], where separator is one of ',', ';' or '|'
+// (a space by default) and type is one of 'e', 'f', 'g' or 'a', as for a double.
+namespace comp6771 {
+	struct text_format {
+		// written between magnitudes
+		char separator = ' ';
+		// unset means whichever of fixed and scientific notation is shorter
+		std::optional<std::chars_format> notation;
+		// unset means the fewest digits that round-trip
+		std::optional<int> precision;
+	};
+
+	// Writes v as "[a b c]" to [first, last), like std::to_chars. Returns {last,
+	// std::errc::value_too_large} if the range is too small, in which case its contents are
+	// unspecified.
+	[[nodiscard]] auto to_chars(char* first,
+	                            char* last,
+	                            const_euclidean_vector_view v,
+	                            text_format const& format = text_format()) noexcept
+	   -> std::to_chars_result;
+
+	// Parses a euclidean_vector from [first, last) into value, like std::from_chars, but skipping
+	// leading whitespace. Accepts either "[a b c]", where the magnitudes are separated by
+	// whitespace and at most one ',', ';' or '|', or a line of values separated by one of those,
+	// e.g. "a,b,c", which ends at the first character after a magnitude that isn't a separator or
+	// a blank. So every separator the formatter writes parses back. The magnitudes are parsed
+	// straight into value's storage; value keeps its allocator, and is unchanged on error.
+	//
+	// On success, ptr points past the closing bracket or the last magnitude. On error, ptr points
+	// at the offending magnitude or separator, and ec is std::errc::invalid_argument, or
+	// std::errc::result_out_of_range if a magnitude doesn't fit in a double.
+	[[nodiscard]] auto from_chars(char const* first, char const* last, euclidean_vector& value)
+	   -> std::from_chars_result;
+
+	// The whole of text, less surrounding whitespace, must be a euclidean_vector that from_chars
+	// accepts. Throws euclidean_vector_error otherwise.
+	[[nodiscard]] auto parse_euclidean_vector(std::string_view text,
+	                                          euclidean_vector::allocator_type const& alloc =
+	                                             euclidean_vector::allocator_type())
+	   -> euclidean_vector;
+
+	namespace detail {
+		inline auto magnitude_to_chars(char* first,
+		                               char* last,
+		                               double m,
+		                               text_format const& format) noexcept -> std::to_chars_result {
+			if (format.precision) {
+				auto const notation = format.notation.value_or(std::chars_format::general);
+				return std::to_chars(first, last, m, notation, *format.precision);
+			}
+			if (format.notation) {
+				return std::to_chars(first, last, m, *format.notation);
+			}
+			return std::to_chars(first, last, m);
+		}
+	} // namespace detail
+} // namespace comp6771
+
+template<typename T>
+struct fmt::formatter<comp6771::basic_euclidean_vector_view<T>> {
+	constexpr auto parse(format_parse_context& ctx) -> decltype(ctx.begin()) {
+		auto it = ctx.begin();
+		auto const end = ctx.end();
+		if (it != end and (*it == ',' or *it == ';' or *it == '|')) {
+			format_.separator = *it++;
+		}
+		if (it != end and *it == '.') {
+			auto precision = 0;
+			auto const first_digit = ++it;
+			for (; it != end and '0' <= *it and *it <= '9'; ++it) {
+				precision = precision * 10 + (*it - '0');
+				if (precision > max_precision) {
+					throw format_error("euclidean_vector precision is too large");
+				}
+			}
+			if (it == first_digit) {
+				throw format_error("missing euclidean_vector precision");
+			}
+			format_.precision = precision;
+		}
+		if (it != end and *it != '}') {
+			switch (*it++) {
+			case 'e': format_.notation = std::chars_format::scientific; break;
+			case 'f': format_.notation = std::chars_format::fixed; break;
+			case 'g': format_.notation = std::chars_format::general; break;
+			case 'a': format_.notation = std::chars_format::hex; break;
+			default: throw format_error("invalid euclidean_vector format specifier");
+			}
+		}
+		if (it != end and *it != '}') {
+			throw format_error("invalid euclidean_vector format specifier");
+		}
+		return it;
+	}
+
+	template<typename FormatContext>
+	auto format(comp6771::const_euclidean_vector_view v, FormatContext& ctx) const
+	   -> decltype(ctx.out()) {
+		auto out = ctx.out();
+		*out++ = '[';
+		// each magnitude is written with the separator before it, and appended in one go
+		auto buffer = std::array<char, 1 + buffer_size>();
+		auto const magnitudes = v.magnitudes();
+		for (auto i = std::size_t{0}; i < magnitudes.size(); ++i) {
+			buffer[0] = format_.separator;
+			auto const result = comp6771::detail::magnitude_to_chars(buffer.data() + 1,
+			                                                         buffer.data() + buffer.size(),
+			                                                         magnitudes[i],
+			                                                         format_);
+			auto const first = buffer.data() + (i == 0 ? 1 : 0);
+			auto const length = static_cast<std::size_t>(result.ptr - first);
+			out = fmt::format_to(out, "{}", fmt::string_view(first, length));
+		}
+		*out++ = ']';
+		return out;
+	}
+
+private:
+	static auto constexpr max_precision = 99;
+	// the longest a magnitude can be: a sign, 309 digits before the point, and max_precision after
+	static auto constexpr buffer_size = std::size_t{1 + 309 + 1 + max_precision};
+
+	comp6771::text_format format_;
+};
+
+template<>
+struct fmt::formatter<comp6771::euclidean_vector>
+: fmt::formatter<comp6771::const_euclidean_vector_view> {};
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_FORMAT_HPP
@@ -0,0 +1,118 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_IO_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_IO_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+
+// A lossless binary format for euclidean_vectors, and a read-only store that memory maps it.
+//
+// A file holds a batch of count vectors that all have the same dimensions. It starts with a
+// 64-byte binary_header, followed by the vectors' magnitudes as doubles in the writer's byte
+// order. Each vector is padded with zeros to a multiple of binary_header::alignment bytes, so
+// that every vector in a mapped file starts on a cache line, just like a euclidean_vector's
+// magnitudes. The header's checksum covers everything after the header, padding included.
+//
+//     auto out = std::ofstream("embeddings.bin", std::ios::binary);
+//     comp6771::write_binary(out, vectors);
+//     ...
+//     auto const store = comp6771::mapped_euclidean_vectors("embeddings.bin");
+//     auto const d = comp6771::dot(store[42], query);
+//
+// Reading throws euclidean_vector_error if the data isn't in this format, was written on a
+// machine with a different byte order, is truncated, or (when the whole payload is read) doesn't
+// match its checksum.
+namespace comp6771 {
+	enum class binary_element_type : std::uint32_t {
+		float64 = 1,
+	};
+
+	struct binary_header {
+		static std::array<char, 8> constexpr expected_magic = {'C', '6', '7', '7',
+		                                                        '1', 'E', 'V', '1'};
+		// written as-is, so that a reader on a machine with the other byte order sees 0x04030201
+		static std::uint32_t constexpr expected_byte_order = 0x01020304;
+		static std::uint32_t constexpr alignment = euclidean_vector::storage_alignment;
+
+		std::array<char, 8> magic = expected_magic;
+		std::uint32_t byte_order = expected_byte_order;
+		binary_element_type element_type = binary_element_type::float64;
+		// bytes; each vector, and the header, is padded to a multiple of this
+		std::uint32_t vector_alignment = alignment;
+		std::uint32_t reserved = 0;
+		std::uint64_t count = 0;
+		std::uint64_t dimensions = 0;
+		// elements from the start of one vector to the start of the next
+		std::uint64_t stride = 0;
+		std::uint64_t checksum = 0;
+		std::uint64_t reserved2 = 0;
+	};
+	static_assert(sizeof(binary_header) == binary_header::alignment);
+
+	// 64-bit FNV-1a over the 8-byte words of a payload, which is always a whole number of doubles
+	[[nodiscard]] auto binary_checksum(std::span<double const> payload) noexcept -> std::uint64_t;
+
+	//---------------------------------streams---------------------------------
+	// Streams must be opened in binary mode. Writing only sets the stream's failbit on failure,
+	// like operator<<; reading throws.
+	auto write_binary(std::ostream& os, const_euclidean_vector_view v) -> std::ostream&;
+	// throws euclidean_vector_error, before writing anything, unless every vector has the same
+	// dimensions
+	auto write_binary(std::ostream& os, std::span<euclidean_vector const> vectors) -> std::ostream&;
+
+	// reads a batch of exactly one vector
+	[[nodiscard]] auto read_binary(std::istream& is,
+	                               euclidean_vector::allocator_type const& alloc =
+	                                  euclidean_vector::allocator_type()) -> euclidean_vector;
+	// also throws if the vectors have no dimensions and there are implausibly many of them
+	[[nodiscard]] auto read_binary_batch(std::istream& is,
+	                                     euclidean_vector::allocator_type const& alloc =
+	                                        euclidean_vector::allocator_type())
+	   -> std::vector<euclidean_vector>;
+
+	//-------------------------------mapped store------------------------------
+	// A file written by write_binary, mapped read-only into memory. Opening it only reads and
+	// checks the header, so it takes the same time for a thousand vectors as for a hundred
+	// million; the operating system pages magnitudes in as they're first touched. The vectors are
+	// exposed as views straight into the mapping, which are valid until the store is destroyed or
+	// moved from. Opening doesn't check the checksum, which means reading the whole file: call
+	// verify() for that. Throws std::system_error if the file can't be opened or mapped.
+	class mapped_euclidean_vectors {
+	public:
+		explicit mapped_euclidean_vectors(std::filesystem::path const& path);
+		mapped_euclidean_vectors(mapped_euclidean_vectors const&) = delete;
+		mapped_euclidean_vectors(mapped_euclidean_vectors&&) noexcept;
+		~mapped_euclidean_vectors();
+
+		auto operator=(mapped_euclidean_vectors const&) -> mapped_euclidean_vectors& = delete;
+		auto operator=(mapped_euclidean_vectors&&) noexcept -> mapped_euclidean_vectors&;
+		// vector i, which starts on a cache line
+		auto operator[](std::size_t i) const noexcept -> const_euclidean_vector_view;
+
+		// throws euclidean_vector_error if i is out of range
+		[[nodiscard]] auto at(std::size_t i) const -> const_euclidean_vector_view;
+		// number of vectors
+		[[nodiscard]] auto size() const noexcept -> std::size_t;
+		[[nodiscard]] auto dimensions() const noexcept -> int;
+		// whether the magnitudes match the checksum in the header
+		[[nodiscard]] auto verify() const noexcept -> bool;
+
+	private:
+		void* mapping_ = nullptr;
+		std::size_t mapping_bytes_ = 0;
+		binary_header header_;
+
+		[[nodiscard]] auto payload() const noexcept -> std::span<double const>;
+		auto unmap() noexcept -> void;
+	};
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_IO_HPP
@@ -0,0 +1,175 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_KERNELS_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_KERNELS_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace comp6771 {
+	// How dot and euclidean_norm add up their products.
+	enum class reduction {
+		// The fastest order for the CPU: one accumulator per SIMD lane, so the result can differ in
+		// the last bits between, say, an AVX2 and an AVX-512 machine.
+		unordered,
+		// Element i is added to accumulator i % 32 and the accumulators are combined in a fixed
+		// order. About as fast as unordered, and gives the same bits on every CPU.
+		blocked,
+		// Blocks of kernels::pairwise_block_size elements are summed as for blocked, and the block
+		// sums are added as a balanced binary tree, so rounding error grows with log n instead
+		// of n. Same bits on every CPU.
+		pairwise,
+		// Each accumulator carries the rounding error of every addition (Neumaier's compensation,
+		// computed branch-free with TwoSum), so the sum is almost as accurate as if it were done
+		// in twice the precision. Same bits on every CPU, for four extra additions per element.
+		compensated,
+	};
+
+	// The top half of an IEEE single precision float: the same 8 exponent bits, and so the same
+	// range, but only 8 significant bits (2 to 3 decimal digits) in half the space.
+	struct bfloat16 {
+		std::uint16_t bits = 0;
+
+		constexpr bfloat16() noexcept = default;
+
+		// rounds to the nearest bfloat16, ties to even; NaNs stay NaNs
+		constexpr explicit bfloat16(float value) noexcept {
+			auto const f = std::bit_cast<std::uint32_t>(value);
+			if ((f & 0x7FFF'FFFFU) > 0x7F80'0000U) {
+				bits = static_cast<std::uint16_t>((f >> 16U) | 0x0040U);
+				return;
+			}
+			auto const round = 0x7FFFU + ((f >> 16U) & 1U);
+			bits = static_cast<std::uint16_t>((f + round) >> 16U);
+		}
+
+		// exact: every bfloat16 is a float
+		constexpr explicit operator float() const noexcept {
+			return std::bit_cast<float>(static_cast<std::uint32_t>(bits) << 16U);
+		}
+
+		// compares the bits, so +0 != -0 and a NaN equals itself
+		friend constexpr auto operator==(bfloat16, bfloat16) noexcept -> bool = default;
+	};
+} // namespace comp6771
+
+// Element-wise kernels used by euclidean_vector. Each kernel has a scalar, SSE2, AVX2 and AVX-512
+// implementation; the widest one the CPU supports is picked once at runtime. None of them allocate.
+// Spans passed to the same kernel must have the same size; they may alias each other exactly, but
+// must not partially overlap.
+namespace comp6771::kernels {
+	enum class simd_width { scalar, sse2, avx2, avx512 };
+
+	inline std::size_t constexpr pairwise_block_size = 256;
+
+	// the three sums a cosine similarity needs, from a single pass over x and y
+	struct cosine_terms {
+		double dot = 0;
+		double x_squared_norm = 0;
+		double y_squared_norm = 0;
+	};
+
+	using dot_kernel = auto (*)(std::span<double const>, std::span<double const>) noexcept -> double;
+	using dot4_kernel = auto (*)(std::span<double const>,
+	                             double const*,
+	                             std::size_t,
+	                             std::span<double, 4>) noexcept -> void;
+	using squared_norm_kernel = auto (*)(std::span<double const>) noexcept -> double;
+	using axpy_kernel = auto (*)(double, std::span<double const>, std::span<double>) noexcept
+	                    -> void;
+	using cosine_kernel = auto (*)(std::span<double const>, std::span<double const>) noexcept
+	                      -> cosine_terms;
+	using scale_kernel = auto (*)(double, std::span<double>) noexcept -> void;
+	using axpby_kernel =
+	   auto (*)(double, std::span<double const>, double, std::span<double>) noexcept -> void;
+	using scale_add_kernel = auto (*)(double, double, std::span<double>) noexcept -> void;
+	using elementwise_kernel = auto (*)(std::span<double const>, std::span<double>) noexcept
+	                           -> void;
+	using float_dot_kernel = auto (*)(std::span<float const>, std::span<float const>) noexcept
+	                         -> double;
+	using bfloat16_dot_kernel = auto (*)(std::span<bfloat16 const>,
+	                                     std::span<bfloat16 const>) noexcept -> double;
+	using int8_dot_kernel = auto (*)(std::span<std::int8_t const>,
+	                                 std::span<std::int8_t const>) noexcept -> std::int64_t;
+
+	struct kernel_table {
+		dot_kernel dot;
+		dot_kernel blocked_dot;
+		dot_kernel pairwise_dot;
+		dot_kernel compensated_dot;
+		dot4_kernel dot4;
+		squared_norm_kernel squared_norm;
+		axpy_kernel axpy;
+		scale_kernel scale;
+		scale_kernel divide;
+		float_dot_kernel float_dot;
+		bfloat16_dot_kernel bfloat16_dot;
+		int8_dot_kernel int8_dot;
+		dot_kernel squared_distance;
+		dot_kernel manhattan_distance;
+		cosine_kernel cosine;
+		axpby_kernel axpby;
+		scale_add_kernel scale_add;
+		elementwise_kernel multiply_elementwise;
+		elementwise_kernel divide_elementwise;
+	};
+
+	// widest instruction set supported by both the build and the CPU we're running on
+	[[nodiscard]] auto detected_simd_width() noexcept -> simd_width;
+	[[nodiscard]] auto is_supported(simd_width) noexcept -> bool;
+
+	// The kernels for a specific width, for testing and benchmarking. Only call the returned
+	// kernels when is_supported(width) is true.
+	[[nodiscard]] auto kernels_for(simd_width) noexcept -> kernel_table const&;
+
+	//------------------------dispatching entry points-------------------------
+	// sum of x[i] * y[i]
+	[[nodiscard]] auto dot(std::span<double const> x, std::span<double const> y) noexcept -> double;
+	[[nodiscard]] auto dot(std::span<double const> x,
+	                       std::span<double const> y,
+	                       reduction mode) noexcept -> double;
+	// result[r] += dot(x, rows r of y) for r in [0, 4), where row r is the x.size() elements that
+	// start at y + r * stride. x is read once for all four rows.
+	auto dot4(std::span<double const> x,
+	          double const* y,
+	          std::size_t stride,
+	          std::span<double, 4> result) noexcept -> void;
+	// sum of x[i] * x[i]
+	[[nodiscard]] auto squared_norm(std::span<double const> x) noexcept -> double;
+	// sum of (x[i] - y[i]) * (x[i] - y[i])
+	[[nodiscard]] auto squared_distance(std::span<double const> x,
+	                                    std::span<double const> y) noexcept -> double;
+	// sum of |x[i] - y[i]|
+	[[nodiscard]] auto manhattan_distance(std::span<double const> x,
+	                                      std::span<double const> y) noexcept -> double;
+	// dot(x, y), squared_norm(x) and squared_norm(y), reading x and y once
+	[[nodiscard]] auto cosine(std::span<double const> x, std::span<double const> y) noexcept
+	   -> cosine_terms;
+	// y[i] += alpha * x[i], a multiply and an add rounded separately whatever the instruction set
+	auto axpy(double alpha, std::span<double const> x, std::span<double> y) noexcept -> void;
+	// x[i] *= alpha
+	auto scale(double alpha, std::span<double> x) noexcept -> void;
+	// x[i] /= divisor
+	auto divide(double divisor, std::span<double> x) noexcept -> void;
+	// y[i] = alpha * x[i] + beta * y[i], with no FMA, like axpy
+	auto axpby(double alpha, std::span<double const> x, double beta, std::span<double> y) noexcept
+	   -> void;
+	// x[i] = std::fma(x[i], alpha, beta), rounded once whatever the instruction set
+	auto scale_add(double alpha, double beta, std::span<double> x) noexcept -> void;
+	// y[i] *= x[i]
+	auto multiply_elementwise(std::span<double const> x, std::span<double> y) noexcept -> void;
+	// y[i] /= x[i]
+	auto divide_elementwise(std::span<double const> x, std::span<double> y) noexcept -> void;
+
+	//-------------------------reduced precision storage-----------------------
+	// Sums of x[i] * y[i] for the compact storage formats. Each element is widened to double
+	// before it's multiplied, so the products are exact and only the sum rounds. The int8 sum is
+	// done in integers, and is exact.
+	[[nodiscard]] auto dot(std::span<float const> x, std::span<float const> y) noexcept -> double;
+	[[nodiscard]] auto dot(std::span<bfloat16 const> x, std::span<bfloat16 const> y) noexcept
+	   -> double;
+	[[nodiscard]] auto dot(std::span<std::int8_t const> x, std::span<std::int8_t const> y) noexcept
+	   -> std::int64_t;
+} // namespace comp6771::kernels
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_KERNELS_HPP
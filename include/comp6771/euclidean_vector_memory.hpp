@@ -0,0 +1,116 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_MEMORY_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_MEMORY_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// memory_resources for euclidean_vector storage. Pass one to an allocator-extended constructor:
+//
+//     auto arena = comp6771::pmr::arena_resource();
+//     auto v = comp6771::euclidean_vector(1000, 0.0, &arena);
+//
+// Neither resource is thread-safe; give each thread its own. Both must outlive every vector that
+// uses them.
+namespace comp6771::pmr {
+	// A monotonic arena: allocation bumps a pointer through chunks obtained from the upstream
+	// resource, which grow geometrically. Deallocation is free and only reclaims memory when it
+	// undoes the most recent allocation, so a vector that is created and destroyed before the next
+	// one is allocated reuses the same bytes. Everything is returned at once by rewind() or
+	// release().
+	class arena_resource : public std::pmr::memory_resource {
+	public:
+		static std::size_t constexpr default_chunk_bytes = 64 * 1024;
+
+		explicit arena_resource(
+		   std::size_t initial_chunk_bytes = default_chunk_bytes,
+		   std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+		arena_resource(arena_resource const&) = delete;
+		auto operator=(arena_resource const&) -> arena_resource& = delete;
+		~arena_resource() override;
+
+		// Makes everything allocated so far available again, keeping the largest chunk for reuse
+		// and returning the others upstream. Any memory handed out before is invalidated.
+		auto rewind() noexcept -> void;
+		// returns all memory to the upstream resource
+		auto release() noexcept -> void;
+
+		[[nodiscard]] auto upstream_resource() const noexcept -> std::pmr::memory_resource*;
+
+	private:
+		struct chunk_header {
+			chunk_header* previous;
+			std::size_t bytes;
+		};
+
+		std::pmr::memory_resource* upstream_;
+		std::size_t next_chunk_bytes_;
+		chunk_header* chunks_ = nullptr; // most recently obtained first
+		std::byte* current_ = nullptr;
+		std::byte* end_ = nullptr;
+
+		auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override;
+		auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override;
+		[[nodiscard]] auto do_is_equal(std::pmr::memory_resource const& other) const noexcept
+		   -> bool override;
+
+		auto add_chunk(std::size_t min_bytes) -> void;
+		auto free_chunk(chunk_header* chunk) noexcept -> void;
+	};
+
+	// A pool with power-of-two size classes from 64 bytes (8 doubles) to 1 MiB (131072 doubles),
+	// which covers every euclidean_vector too big to be stored inline up to 131072 dimensions.
+	// Each class keeps a free list of blocks carved out of larger chunks, so repeatedly creating
+	// and destroying vectors of similar sizes never goes upstream once the pool is warm. Blocks are
+	// aligned to 64 bytes. Larger or more strictly aligned requests go straight to the upstream
+	// resource.
+	class pool_resource : public std::pmr::memory_resource {
+	public:
+		static std::size_t constexpr min_block_bytes = 64;
+		static std::size_t constexpr max_block_bytes = 1024 * 1024;
+		static std::size_t constexpr block_alignment = 64;
+
+		explicit pool_resource(
+		   std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+		pool_resource(pool_resource const&) = delete;
+		auto operator=(pool_resource const&) -> pool_resource& = delete;
+		~pool_resource() override;
+
+		// Returns every chunk, including blocks that are still in use, to the upstream resource.
+		// Allocations that bypassed the pool aren't tracked and still have to be deallocated.
+		auto release() noexcept -> void;
+
+		[[nodiscard]] auto upstream_resource() const noexcept -> std::pmr::memory_resource*;
+
+	private:
+		static std::size_t constexpr class_count = 15; // 64 << 14 == 1 MiB
+		// chunks are sized for this many bytes (but always hold at least one block)
+		static std::size_t constexpr max_chunk_bytes = 4 * 1024 * 1024;
+
+		struct free_block {
+			free_block* next;
+		};
+		struct size_class {
+			free_block* free_list = nullptr;
+			std::size_t blocks_per_chunk = 1;
+		};
+		struct chunk {
+			void* data;
+			std::size_t bytes;
+		};
+
+		std::pmr::memory_resource* upstream_;
+		std::array<size_class, class_count> classes_;
+		std::vector<chunk> chunks_;
+
+		auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override;
+		auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override;
+		[[nodiscard]] auto do_is_equal(std::pmr::memory_resource const& other) const noexcept
+		   -> bool override;
+
+		auto refill(std::size_t class_index) -> void;
+	};
+} // namespace comp6771::pmr
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_MEMORY_HPP
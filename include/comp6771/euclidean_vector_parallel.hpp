@@ -0,0 +1,48 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_PARALLEL_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_PARALLEL_HPP
+
+#include "comp6771/euclidean_vector_view.hpp"
+#include "comp6771/thread_pool.hpp"
+
+#include <cstddef>
+
+// Overloads of the euclidean_vector operations that split very large vectors across a
+// thread_pool. They take views, so they work on euclidean_vectors, views and matrix rows alike:
+//
+//     auto pool = comp6771::thread_pool();
+//     auto const d = comp6771::dot(pool, a, b);
+//     comp6771::add_assign(pool, a, b); // a += b
+//
+// Work is split into chunks of parallel_chunk_size magnitudes, which fit in a core's L2 cache.
+// Vectors shorter than parallel_threshold aren't worth waking the pool for, and stay on the
+// calling thread.
+//
+// Reductions are deterministic: each chunk is summed on its own and the per-chunk sums are then
+// combined in chunk order, so the result depends only on the magnitudes, never on the size of the
+// pool or on which thread ran which chunk. With reduction::pairwise it's also bit-for-bit the
+// serial result; with the other modes it can differ from it in the last bits.
+namespace comp6771 {
+	inline std::size_t constexpr parallel_chunk_size = std::size_t{1} << 15;
+	inline std::size_t constexpr parallel_threshold = std::size_t{1} << 18;
+
+	auto dot(thread_pool& pool,
+	         const_euclidean_vector_view x,
+	         const_euclidean_vector_view y,
+	         reduction mode = reduction::unordered) -> double;
+	auto euclidean_norm(thread_pool& pool,
+	                    const_euclidean_vector_view v,
+	                    reduction mode = reduction::unordered) -> double;
+
+	// v += w
+	auto add_assign(thread_pool& pool, euclidean_vector_view v, const_euclidean_vector_view w)
+	   -> void;
+	// v -= w
+	auto subtract_assign(thread_pool& pool, euclidean_vector_view v, const_euclidean_vector_view w)
+	   -> void;
+	// v *= scalar
+	auto multiply_assign(thread_pool& pool, euclidean_vector_view v, double scalar) -> void;
+	// v /= scalar; throws if scalar is 0
+	auto divide_assign(thread_pool& pool, euclidean_vector_view v, double scalar) -> void;
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_PARALLEL_HPP
@@ -0,0 +1,188 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_SEARCH_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_SEARCH_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+// k-nearest-neighbour search over a collection of euclidean_vectors, by Euclidean distance.
+//
+// Each index copies the vectors it's built from, which must all have the same dimensions, and
+// identifies them by their position in that range. A search returns at most k neighbours, closest
+// first; ties are broken by index, so results are deterministic. Searching a const index is
+// thread-safe. All of them throw euclidean_vector_error if the query's dimensions don't match the
+// index's, or if the vectors they're built from don't all have the same dimensions.
+//
+//   * exact_index compares the query with every vector. It's the baseline the others are measured
+//     against, and the fastest choice for small collections or for batches of queries.
+//   * kd_tree is also exact, but prunes whole subtrees. It works best in low dimensions (up to
+//     about 20); beyond that it ends up visiting nearly every leaf.
+//   * ivf_index is approximate: it clusters the vectors with k-means, and only searches the
+//     clusters whose centroids are closest to the query. Probing more clusters trades speed for
+//     recall, which makes it the choice for large collections of high-dimensional vectors.
+namespace comp6771 {
+	struct neighbour {
+		// position in the range the index was built from
+		std::size_t index = 0;
+		double squared_distance = 0;
+
+		friend auto operator==(neighbour const&, neighbour const&) -> bool = default;
+	};
+
+	// a range of vectors an index can be built from
+	template<typename R>
+	concept vector_collection =
+	   std::ranges::input_range<R>
+	   and std::convertible_to<std::ranges::range_reference_t<R>, const_euclidean_vector_view>;
+
+	namespace detail {
+		// vectors of the same dimensions, stored back to back
+		class vector_rows {
+		public:
+			vector_rows() = default;
+
+			template<vector_collection R>
+			explicit vector_rows(R&& vectors) {
+				for (auto&& v : vectors) {
+					push_back(const_euclidean_vector_view(v));
+				}
+			}
+
+			// throws euclidean_vector_error unless v has the same dimensions as the other rows
+			auto push_back(const_euclidean_vector_view v) -> void;
+
+			[[nodiscard]] auto operator[](std::size_t i) const noexcept -> std::span<double const> {
+				return std::span(magnitudes_).subspan(i * dimensions_, dimensions_);
+			}
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return size_;
+			}
+
+			[[nodiscard]] auto dimensions() const noexcept -> std::size_t {
+				return dimensions_;
+			}
+
+		private:
+			std::vector<double> magnitudes_;
+			std::size_t size_ = 0;
+			std::size_t dimensions_ = 0;
+		};
+	} // namespace detail
+
+	//-------------------------------exact search------------------------------
+	class exact_index {
+	public:
+		exact_index() = default;
+
+		template<vector_collection R>
+		explicit exact_index(R&& vectors)
+		: rows_(std::forward<R>(vectors)) {}
+
+		[[nodiscard]] auto search(const_euclidean_vector_view query, std::size_t k) const
+		   -> std::vector<neighbour>;
+		// Searches for every query at once, a block of the index at a time, so that each block is
+		// read from memory once for the whole batch rather than once per query.
+		[[nodiscard]] auto search(std::span<euclidean_vector const> queries, std::size_t k) const
+		   -> std::vector<std::vector<neighbour>>;
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t;
+		[[nodiscard]] auto dimensions() const noexcept -> int;
+
+	private:
+		detail::vector_rows rows_;
+	};
+
+	//---------------------------------k-d tree--------------------------------
+	class kd_tree {
+	public:
+		kd_tree() = default;
+
+		// splits at the median of the dimension with the largest spread until at most leaf_size
+		// vectors are left
+		template<vector_collection R>
+		explicit kd_tree(R&& vectors, std::size_t leaf_size = default_leaf_size)
+		: rows_(std::forward<R>(vectors)) {
+			build(leaf_size);
+		}
+
+		[[nodiscard]] auto search(const_euclidean_vector_view query, std::size_t k) const
+		   -> std::vector<neighbour>;
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t;
+		[[nodiscard]] auto dimensions() const noexcept -> int;
+
+	private:
+		static std::size_t constexpr default_leaf_size = 16;
+
+		// a leaf holds order_[first, last); an internal node has two children and no vectors
+		struct node {
+			std::size_t first = 0;
+			std::size_t last = 0;
+			std::size_t left = 0;
+			std::size_t right = 0;
+			std::size_t split_dimension = 0;
+			double split_value = 0;
+		};
+
+		detail::vector_rows rows_;
+		// the rows' indices, arranged so that each leaf's are contiguous
+		std::vector<std::size_t> order_;
+		std::vector<node> nodes_;
+
+		auto build(std::size_t leaf_size) -> void;
+		auto build(std::size_t first, std::size_t last, std::size_t leaf_size) -> std::size_t;
+	};
+
+	//---------------------------inverted file index---------------------------
+	struct ivf_options {
+		// number of clusters; 0 means about the square root of the number of vectors
+		std::size_t lists = 0;
+		// rounds of k-means
+		int iterations = 10;
+		// picks the initial centroids, so the same seed always builds the same index
+		std::uint64_t seed = 6771;
+	};
+
+	class ivf_index {
+	public:
+		ivf_index() = default;
+
+		template<vector_collection R>
+		explicit ivf_index(R&& vectors, ivf_options const& options = ivf_options())
+		: rows_(std::forward<R>(vectors)) {
+			build(options);
+		}
+
+		// searches the probes clusters whose centroids are closest to the query; probing every
+		// cluster gives the same results as exact_index
+		[[nodiscard]] auto
+		search(const_euclidean_vector_view query, std::size_t k, std::size_t probes) const
+		   -> std::vector<neighbour>;
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t;
+		[[nodiscard]] auto dimensions() const noexcept -> int;
+		// number of clusters
+		[[nodiscard]] auto lists() const noexcept -> std::size_t;
+
+	private:
+		// grouped by cluster, so that each cluster is scanned contiguously
+		detail::vector_rows rows_;
+		// ids_[i] is the position rows_[i] had in the range the index was built from
+		std::vector<std::size_t> ids_;
+		detail::vector_rows centroids_;
+		// cluster c holds rows [list_offsets_[c], list_offsets_[c + 1])
+		std::vector<std::size_t> list_offsets_;
+
+		auto build(ivf_options const& options) -> void;
+	};
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_SEARCH_HPP
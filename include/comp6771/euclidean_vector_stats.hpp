@@ -0,0 +1,153 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_STATS_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_STATS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+// How much euclidean_vector records about itself:
+//   0: nothing; every recording call compiles away
+//   1: counters for allocations, copies, moves, errors and each operation's calls and elements
+//   2: the counters, and the time spent in each operation
+// Define it before including any comp6771 header to change it; every translation unit in a program
+// must agree on the value, including the ones that build the library.
+#ifndef COMP6771_EUCLIDEAN_VECTOR_STATS
+#	define COMP6771_EUCLIDEAN_VECTOR_STATS 0
+#endif
+
+namespace comp6771::stats {
+	static_assert(COMP6771_EUCLIDEAN_VECTOR_STATS >= 0 and COMP6771_EUCLIDEAN_VECTOR_STATS <= 2,
+	              "COMP6771_EUCLIDEAN_VECTOR_STATS must be 0, 1 or 2");
+
+	inline constexpr bool counters_enabled = COMP6771_EUCLIDEAN_VECTOR_STATS >= 1;
+	inline constexpr bool timers_enabled = COMP6771_EUCLIDEAN_VECTOR_STATS >= 2;
+
+	enum class counter : std::size_t {
+		// heap allocations for magnitudes; vectors stored inline never allocate
+		allocations,
+		allocated_bytes,
+		// copies of all of a vector's magnitudes made by a copy constructor or copy assignment
+		deep_copies,
+		moves,
+		dimension_mismatches,
+		// euclidean_norm() calls answered from the cache, without an operation::euclidean_norm
+		norm_cache_hits,
+	};
+	inline constexpr auto counter_count = std::size_t{6};
+
+	enum class operation : std::size_t {
+		dot,
+		// only the calls that compute the norm; see counter::norm_cache_hits
+		euclidean_norm,
+		unit,
+		// the compound assignment operators, and the unary - of an rvalue
+		add,
+		subtract,
+		multiply,
+		divide,
+		negate,
+		// an expression built by the binary operators, evaluated into a vector
+		evaluate,
+		// the in-place updates; normalize also counts the euclidean_norm it needs
+		axpy,
+		axpby,
+		lerp,
+		normalize,
+		scale_add,
+		hadamard,
+		divide_elementwise,
+		// the single-pass distances; a batch overload is one call over all of its candidates
+		distance,
+		squared_distance,
+		manhattan_distance,
+		cosine_similarity,
+	};
+	inline constexpr auto operation_count = std::size_t{20};
+
+	struct operation_totals {
+		std::uint64_t calls = 0;
+		// the magnitudes written, or read for the reductions
+		std::uint64_t elements = 0;
+		// always 0 unless timers are enabled
+		std::uint64_t nanoseconds = 0;
+
+		friend auto operator==(operation_totals const&, operation_totals const&) -> bool = default;
+	};
+
+	// The totals over every thread at one point in time. Subtract an earlier snapshot from a later
+	// one to get what happened in between, e.g. while serving one request.
+	struct snapshot {
+		std::array<std::uint64_t, counter_count> counters{};
+		std::array<operation_totals, operation_count> operations{};
+
+		[[nodiscard]] auto operator[](counter c) const noexcept -> std::uint64_t {
+			return counters[static_cast<std::size_t>(c)];
+		}
+		[[nodiscard]] auto operator[](operation op) const noexcept -> operation_totals {
+			return operations[static_cast<std::size_t>(op)];
+		}
+
+		friend auto operator==(snapshot const&, snapshot const&) -> bool = default;
+	};
+	auto operator-(snapshot const& later, snapshot const& earlier) noexcept -> snapshot;
+
+	// Adds up every thread's totals, including those of threads that have exited. Each total is
+	// read atomically, but not all of them at once, so a snapshot taken while other threads work
+	// may count part of an operation. All zeros when counters are disabled.
+	[[nodiscard]] auto take_snapshot() -> snapshot;
+
+	// names as written by operator<<
+	[[nodiscard]] auto name(counter c) noexcept -> std::string_view;
+	[[nodiscard]] auto name(operation op) noexcept -> std::string_view;
+
+	// One "name value" line per total, e.g. "allocations 12" or "dot_elements 4096", for a log or
+	// a metrics scraper.
+	auto operator<<(std::ostream& os, snapshot const& s) -> std::ostream&;
+
+	namespace detail {
+		// Each thread adds to its own totals, so these never contend with another thread.
+		auto record(counter c, std::uint64_t n) noexcept -> void;
+		auto record(operation op, std::uint64_t elements) noexcept -> void;
+		auto record_time(operation op, std::chrono::nanoseconds elapsed) noexcept -> void;
+	} // namespace detail
+
+	inline auto count(counter c, std::uint64_t n = 1) noexcept -> void {
+		if constexpr (counters_enabled) {
+			detail::record(c, n);
+		}
+	}
+
+	// Counts a call of op over `elements` magnitudes and, when timers are enabled, adds the time
+	// until the end of the scope to op's total.
+	class scoped_operation {
+	public:
+		scoped_operation(operation op, std::size_t elements) noexcept {
+			if constexpr (counters_enabled) {
+				detail::record(op, elements);
+			}
+			if constexpr (timers_enabled) {
+				op_ = op;
+				start_ = clock::now();
+			}
+		}
+		scoped_operation(scoped_operation const&) = delete;
+		auto operator=(scoped_operation const&) -> scoped_operation& = delete;
+		~scoped_operation() {
+			if constexpr (timers_enabled) {
+				detail::record_time(op_, clock::now() - start_);
+			}
+		}
+
+	private:
+		using clock = std::chrono::steady_clock;
+
+		// only set when timers are enabled
+		operation op_{};
+		clock::time_point start_{};
+	};
+} // namespace comp6771::stats
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_STATS_HPP
@@ -0,0 +1,229 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_VIEW_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_VIEW_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace comp6771 {
+	// A non-owning euclidean vector over magnitudes that live somewhere else, e.g. in a memory
+	// mapped file or a network buffer. It's to euclidean_vector what std::span is to std::vector:
+	// cheap to copy, and copying or assigning a view never touches the magnitudes.
+	//
+	// Views work with dot, euclidean_norm, unit and the arithmetic operators just like
+	// euclidean_vectors, and the two can be mixed freely. euclidean_vector_view can also modify
+	// the magnitudes through the compound assignment operators; const_euclidean_vector_view is
+	// read-only. The result of a compound assignment is unspecified if the right-hand side
+	// partially overlaps the view.
+	//
+	// A view of a euclidean_vector is invalidated by anything that changes the vector's
+	// dimensions. A mutable view of a euclidean_vector discards the vector's cached norm whenever
+	// it hands out access to the magnitudes, just like the vector's own non-const members, so the
+	// same rule applies: don't hold on to a reference or span from it across a call to
+	// euclidean_norm() or unit() on the vector.
+	template<typename T>
+	requires std::same_as<std::remove_const_t<T>, double>
+	class basic_euclidean_vector_view : public detail::view_node {
+	public:
+		static bool constexpr is_mutable = not std::is_const_v<T>;
+
+		//----------------------------constructors---------------------------------
+		// no dimensions
+		constexpr basic_euclidean_vector_view() noexcept = default;
+
+		constexpr explicit basic_euclidean_vector_view(std::span<T> magnitudes) noexcept
+		: magnitudes_{magnitudes} {}
+
+		constexpr basic_euclidean_vector_view(T* data, int dimensions) noexcept
+		: magnitudes_{data, static_cast<std::size_t>(dimensions)} {}
+
+		// NOLINTNEXTLINE(google-explicit-constructor)
+		basic_euclidean_vector_view(euclidean_vector& v) noexcept requires is_mutable
+		: magnitudes_{v.magnitudes()}
+		, owner_{&v} {}
+
+		// NOLINTNEXTLINE(google-explicit-constructor)
+		basic_euclidean_vector_view(euclidean_vector const& v) noexcept requires(not is_mutable)
+		: magnitudes_{v.magnitudes()} {}
+
+		// a mutable view converts to a const one
+		template<typename U>
+		requires(not is_mutable and std::same_as<U, double>)
+		// NOLINTNEXTLINE(google-explicit-constructor)
+		constexpr basic_euclidean_vector_view(basic_euclidean_vector_view<U> view) noexcept
+		: magnitudes_{view.magnitudes_} {}
+
+		//---------------------------operators-------------------------------------
+		constexpr auto operator[](int i) const noexcept -> T& {
+			invalidate_norm();
+			return magnitudes_[static_cast<std::size_t>(i)];
+		}
+
+		auto operator+=(basic_euclidean_vector_view<double const> oth) const
+		   -> basic_euclidean_vector_view const& requires is_mutable {
+			check_dimensions(oth.dimensions());
+			invalidate_norm();
+			kernels::axpy(1.0, oth.magnitudes_, magnitudes_);
+			return *this;
+		}
+		auto operator-=(basic_euclidean_vector_view<double const> oth) const
+		   -> basic_euclidean_vector_view const& requires is_mutable {
+			check_dimensions(oth.dimensions());
+			invalidate_norm();
+			kernels::axpy(-1.0, oth.magnitudes_, magnitudes_);
+			return *this;
+		}
+		template<detail::expression_node_type E>
+		auto operator+=(E const& expr) const
+		   -> basic_euclidean_vector_view const& requires is_mutable {
+			check_dimensions(expr.dimensions());
+			evaluate_into(expr, [](double& out, double value) { out += value; });
+			return *this;
+		}
+		template<detail::expression_node_type E>
+		auto operator-=(E const& expr) const
+		   -> basic_euclidean_vector_view const& requires is_mutable {
+			check_dimensions(expr.dimensions());
+			evaluate_into(expr, [](double& out, double value) { out -= value; });
+			return *this;
+		}
+		auto operator*=(double factor) const noexcept
+		   -> basic_euclidean_vector_view const& requires is_mutable {
+			invalidate_norm();
+			kernels::scale(factor, magnitudes_);
+			return *this;
+		}
+		auto operator/=(double divisor) const
+		   -> basic_euclidean_vector_view const& requires is_mutable {
+			if (divisor == 0) {
+				throw euclidean_vector_error("Invalid vector division by 0");
+			}
+			invalidate_norm();
+			kernels::divide(divisor, magnitudes_);
+			return *this;
+		}
+
+		//-----------------------member functions----------------------------------
+		[[nodiscard]] constexpr auto at(int index) const -> T& {
+			if (index < 0 or index >= dimensions()) {
+				throw euclidean_vector_error("Index X is not valid for this euclidean_vector object");
+			}
+			return (*this)[index];
+		}
+		[[nodiscard]] constexpr auto dimensions() const noexcept -> int {
+			return static_cast<int>(magnitudes_.size());
+		}
+		[[nodiscard]] constexpr auto magnitudes() const noexcept -> std::span<T> {
+			invalidate_norm();
+			return magnitudes_;
+		}
+		[[nodiscard]] constexpr auto data() const noexcept -> T* {
+			invalidate_norm();
+			return magnitudes_.data();
+		}
+		[[nodiscard]] constexpr auto begin() const noexcept {
+			invalidate_norm();
+			return magnitudes_.begin();
+		}
+		[[nodiscard]] constexpr auto end() const noexcept {
+			invalidate_norm();
+			return magnitudes_.end();
+		}
+
+	private:
+		template<typename U>
+		requires std::same_as<std::remove_const_t<U>, double>
+		friend class basic_euclidean_vector_view;
+		template<detail::view_node_type V>
+		friend auto detail::make_evaluator(V const& view) noexcept -> detail::leaf_evaluator;
+
+		std::span<T> magnitudes_;
+		// the euclidean_vector this views, if it's a mutable view of one
+		euclidean_vector* owner_ = nullptr;
+
+		constexpr auto invalidate_norm() const noexcept -> void {
+			if constexpr (is_mutable) {
+				if (owner_ != nullptr) {
+					owner_->invalidate_norm();
+				}
+			}
+		}
+
+		auto check_dimensions(int dimensions) const -> void {
+			if (this->dimensions() != dimensions) {
+				throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+			}
+		}
+
+		template<typename E, typename Op>
+		auto evaluate_into(E const& expr, Op op) const noexcept -> void {
+			invalidate_norm();
+			auto const evaluate = detail::make_evaluator(expr);
+			for (auto i = std::size_t{0}; i < magnitudes_.size(); ++i) {
+				op(magnitudes_[i], evaluate(i));
+			}
+		}
+	};
+
+	using euclidean_vector_view = basic_euclidean_vector_view<double>;
+	using const_euclidean_vector_view = basic_euclidean_vector_view<double const>;
+
+	//----------------------Utility functions----------------------------------
+	// These also take euclidean_vectors, which convert to const_euclidean_vector_view. Unlike the
+	// euclidean_vector overloads, the norm of a view isn't cached.
+	auto euclidean_norm(const_euclidean_vector_view v) -> double;
+	auto unit(const_euclidean_vector_view v) -> euclidean_vector;
+	auto dot(const_euclidean_vector_view x, const_euclidean_vector_view y) -> double;
+
+	// dot and euclidean_norm with a chosen summation order and accuracy; see comp6771::reduction
+	auto dot(const_euclidean_vector_view x, const_euclidean_vector_view y, reduction mode)
+	   -> double;
+	auto euclidean_norm(const_euclidean_vector_view v, reduction mode) -> double;
+
+	// Distances and similarities computed in a single pass over both vectors, without the
+	// temporaries of, say, euclidean_norm(x - y). All of them throw euclidean_vector_error if x
+	// and y don't have the same dimensions.
+	auto distance(const_euclidean_vector_view x, const_euclidean_vector_view y) -> double;
+	auto squared_distance(const_euclidean_vector_view x, const_euclidean_vector_view y) -> double;
+	auto manhattan_distance(const_euclidean_vector_view x, const_euclidean_vector_view y)
+	   -> double;
+	// dot(x, y) / (euclidean_norm(x) * euclidean_norm(y)); also throws if either norm is zero
+	auto cosine_similarity(const_euclidean_vector_view x, const_euclidean_vector_view y)
+	   -> double;
+
+	// Element i is the function above applied to query and candidates[i]. The overloads taking
+	// result write into it instead of allocating, and throw if it doesn't have candidates.size()
+	// elements. Every candidate's dimensions, and for cosine_similarity every norm, are checked
+	// before anything is written.
+	auto distance(const_euclidean_vector_view query, std::span<euclidean_vector const> candidates)
+	   -> std::vector<double>;
+	auto distance(const_euclidean_vector_view query,
+	              std::span<euclidean_vector const> candidates,
+	              std::span<double> result) -> void;
+	auto squared_distance(const_euclidean_vector_view query,
+	                      std::span<euclidean_vector const> candidates) -> std::vector<double>;
+	auto squared_distance(const_euclidean_vector_view query,
+	                      std::span<euclidean_vector const> candidates,
+	                      std::span<double> result) -> void;
+	auto manhattan_distance(const_euclidean_vector_view query,
+	                        std::span<euclidean_vector const> candidates) -> std::vector<double>;
+	auto manhattan_distance(const_euclidean_vector_view query,
+	                        std::span<euclidean_vector const> candidates,
+	                        std::span<double> result) -> void;
+	auto cosine_similarity(const_euclidean_vector_view query,
+	                       std::span<euclidean_vector const> candidates) -> std::vector<double>;
+	auto cosine_similarity(const_euclidean_vector_view query,
+	                       std::span<euclidean_vector const> candidates,
+	                       std::span<double> result) -> void;
+} // namespace comp6771
+
+template<typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<comp6771::basic_euclidean_vector_view<T>> =
+   true;
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_VIEW_HPP
@@ -0,0 +1,187 @@
+#ifndef COMP6771_FIXED_EUCLIDEAN_VECTOR_HPP
+#define COMP6771_FIXED_EUCLIDEAN_VECTOR_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <ostream>
+#include <utility>
+
+namespace comp6771 {
+	// A euclidean vector whose dimension is part of its type. Magnitudes are stored inline, so it
+	// never allocates, every operation is unrolled at compile time, and mixing dimensions is a
+	// compile-time error rather than a euclidean_vector_error. Everything except the norm (which
+	// needs std::sqrt) and the stream output is usable in constant expressions.
+	template<int N>
+	requires(N >= 0) class fixed_euclidean_vector {
+	public:
+		static double constexpr epsilon = euclidean_vector::epsilon;
+
+		//----------------------------constructors---------------------------------
+		// all magnitudes are 0
+		constexpr fixed_euclidean_vector() noexcept = default;
+
+		// all magnitudes are value
+		constexpr explicit fixed_euclidean_vector(double value) noexcept {
+			for_each_index([&](std::size_t i) { magnitudes_[i] = value; });
+		}
+
+		// one magnitude per dimension, e.g. fixed_euclidean_vector<3>(1, 2, 3)
+		template<std::convertible_to<double>... Ts>
+		requires(sizeof...(Ts) == N and N > 1)
+		constexpr fixed_euclidean_vector(Ts... values) noexcept
+		: magnitudes_{static_cast<double>(values)...} {}
+
+		// throws euclidean_vector_error if v doesn't have N dimensions
+		explicit fixed_euclidean_vector(euclidean_vector const& v) {
+			if (v.dimensions() != N) {
+				throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+			}
+			for_each_index([&](std::size_t i) { magnitudes_[i] = v[static_cast<int>(i)]; });
+		}
+
+		//---------------------------operators-------------------------------------
+		constexpr auto operator[](int i) noexcept -> double& {
+			return magnitudes_[static_cast<std::size_t>(i)];
+		}
+		constexpr auto operator[](int i) const noexcept -> double {
+			return magnitudes_[static_cast<std::size_t>(i)];
+		}
+
+		constexpr auto operator+() const noexcept -> fixed_euclidean_vector {
+			return *this;
+		}
+		constexpr auto operator-() const noexcept -> fixed_euclidean_vector {
+			auto result = fixed_euclidean_vector();
+			for_each_index([&](std::size_t i) { result.magnitudes_[i] = -magnitudes_[i]; });
+			return result;
+		}
+
+		constexpr auto operator+=(fixed_euclidean_vector const& oth) noexcept
+		   -> fixed_euclidean_vector& {
+			for_each_index([&](std::size_t i) { magnitudes_[i] += oth.magnitudes_[i]; });
+			return *this;
+		}
+		constexpr auto operator-=(fixed_euclidean_vector const& oth) noexcept
+		   -> fixed_euclidean_vector& {
+			for_each_index([&](std::size_t i) { magnitudes_[i] -= oth.magnitudes_[i]; });
+			return *this;
+		}
+		constexpr auto operator*=(double factor) noexcept -> fixed_euclidean_vector& {
+			for_each_index([&](std::size_t i) { magnitudes_[i] *= factor; });
+			return *this;
+		}
+		constexpr auto operator/=(double divisor) -> fixed_euclidean_vector& {
+			if (divisor == 0) {
+				throw euclidean_vector_error("Invalid vector division by 0");
+			}
+			for_each_index([&](std::size_t i) { magnitudes_[i] /= divisor; });
+			return *this;
+		}
+
+		explicit operator euclidean_vector() const {
+			auto result = euclidean_vector(N);
+			for_each_index([&](std::size_t i) { result[static_cast<int>(i)] = magnitudes_[i]; });
+			return result;
+		}
+
+		//-----------------------member functions----------------------------------
+		[[nodiscard]] constexpr auto at(int index) const -> double {
+			if (index < 0 or index >= N) {
+				throw euclidean_vector_error("Index X is not valid for this euclidean_vector object");
+			}
+			return (*this)[index];
+		}
+		[[nodiscard]] constexpr auto at(int index) -> double& {
+			if (index < 0 or index >= N) {
+				throw euclidean_vector_error("Index X is not valid for this euclidean_vector object");
+			}
+			return (*this)[index];
+		}
+		[[nodiscard]] static constexpr auto dimensions() noexcept -> int {
+			return N;
+		}
+
+		//--------------------------friends----------------------------------------
+		friend constexpr auto
+		operator==(fixed_euclidean_vector const& lhs, fixed_euclidean_vector const& rhs) noexcept
+		   -> bool {
+			auto equal = true;
+			for_each_index([&](std::size_t i) {
+				auto const difference = lhs.magnitudes_[i] - rhs.magnitudes_[i];
+				equal = equal and difference <= epsilon and -difference <= epsilon;
+			});
+			return equal;
+		}
+		friend constexpr auto
+		operator+(fixed_euclidean_vector lhs, fixed_euclidean_vector const& rhs) noexcept
+		   -> fixed_euclidean_vector {
+			return lhs += rhs;
+		}
+		friend constexpr auto
+		operator-(fixed_euclidean_vector lhs, fixed_euclidean_vector const& rhs) noexcept
+		   -> fixed_euclidean_vector {
+			return lhs -= rhs;
+		}
+		friend constexpr auto operator*(fixed_euclidean_vector vec, double factor) noexcept
+		   -> fixed_euclidean_vector {
+			return vec *= factor;
+		}
+		friend constexpr auto operator/(fixed_euclidean_vector vec, double divisor)
+		   -> fixed_euclidean_vector {
+			return vec /= divisor;
+		}
+		friend auto operator<<(std::ostream& os, fixed_euclidean_vector const& vec)
+		   -> std::ostream& {
+			os << '[';
+			for_each_index([&](std::size_t i) { os << (i == 0 ? "" : " ") << vec.magnitudes_[i]; });
+			return os << ']';
+		}
+
+		friend constexpr auto
+		dot(fixed_euclidean_vector const& x, fixed_euclidean_vector const& y) noexcept -> double {
+			return [&]<std::size_t... I>(std::index_sequence<I...>) {
+				return (0.0 + ... + (x.magnitudes_[I] * y.magnitudes_[I]));
+			}(std::make_index_sequence<static_cast<std::size_t>(N)>{});
+		}
+
+	private:
+		std::array<double, static_cast<std::size_t>(N)> magnitudes_{};
+
+		// calls f(0), f(1), ..., f(N - 1), fully unrolled
+		template<typename F>
+		static constexpr auto for_each_index(F&& f) -> void {
+			[&]<std::size_t... I>(std::index_sequence<I...>) {
+				(f(I), ...);
+			}(std::make_index_sequence<static_cast<std::size_t>(N)>{});
+		}
+	};
+
+	//----------------------Utility functions----------------------------------
+	template<int N>
+	auto euclidean_norm(fixed_euclidean_vector<N> const& v) -> double {
+		if constexpr (N == 0) {
+			throw euclidean_vector_error("euclidean_vector with no dimensions does not have a norm");
+		}
+		return std::sqrt(dot(v, v));
+	}
+
+	template<int N>
+	auto unit(fixed_euclidean_vector<N> const& v) -> fixed_euclidean_vector<N> {
+		if constexpr (N == 0) {
+			throw euclidean_vector_error("euclidean_vector with no dimensions does not have a unit "
+			                             "vector");
+		}
+		auto const norm = euclidean_norm(v);
+		if (norm == 0) {
+			throw euclidean_vector_error("euclidean_vector with zero euclidean normal does not "
+			                             "have a unit vector");
+		}
+		return v / norm;
+	}
+} // namespace comp6771
+
+#endif // COMP6771_FIXED_EUCLIDEAN_VECTOR_HPP
@@ -0,0 +1,143 @@
+#ifndef COMP6771_SHARED_EUCLIDEAN_VECTOR_HPP
+#define COMP6771_SHARED_EUCLIDEAN_VECTOR_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+
+#include <atomic>
+#include <ostream>
+#include <span>
+#include <utility>
+
+namespace comp6771 {
+	// A euclidean vector whose copies share one buffer of magnitudes until one of them is written
+	// to, for vectors that are handed to many readers by value. Copying, assigning and destroying
+	// only touch an atomic reference count, so they take the same time whatever the dimensions --
+	// though that's longer than a plain copy of a vector with a few dozen dimensions.
+	// The first write through a copy -- the non-const operator[], at() or magnitudes(), or a
+	// compound assignment -- detaches it onto a buffer of its own, and the other copies never see
+	// the change.
+	//
+	// Like std::shared_ptr, distinct objects that share a buffer can be used from different
+	// threads without synchronisation, including writing to one while others read theirs, and one
+	// object can be read (through its const members) by any number of threads at once. Writing to
+	// one object while another thread reads that same object is a data race, as it is for any
+	// other type.
+	//
+	// The shared magnitudes are a euclidean_vector, which vector() exposes to every function that
+	// takes one, so copies also share its cached norm. Don't hold on to a reference returned by a
+	// non-const member across a copy of the object: the copy shares the buffer the reference
+	// points into, and a write through the reference would show up in both.
+	class shared_euclidean_vector {
+	public:
+		//----------------------------constructors---------------------------------
+		// one dimension, like euclidean_vector
+		shared_euclidean_vector();
+		// adopts v's storage without copying the magnitudes
+		explicit shared_euclidean_vector(euclidean_vector&& v);
+		explicit shared_euclidean_vector(euclidean_vector const& v);
+		shared_euclidean_vector(shared_euclidean_vector const& orig) noexcept
+		: buffer_{orig.buffer_} {
+			acquire(buffer_);
+		}
+		// leaves orig with no dimensions
+		shared_euclidean_vector(shared_euclidean_vector&& orig) noexcept
+		: buffer_{std::exchange(orig.buffer_, nullptr)} {}
+
+		//---------------------------destructor------------------------------------
+		~shared_euclidean_vector() {
+			release(buffer_);
+		}
+
+		//---------------------------operators-------------------------------------
+		auto operator=(shared_euclidean_vector const& oth) noexcept -> shared_euclidean_vector& {
+			// acquiring first makes self-assignment safe
+			acquire(oth.buffer_);
+			release(std::exchange(buffer_, oth.buffer_));
+			return *this;
+		}
+		auto operator=(shared_euclidean_vector&& oth) noexcept -> shared_euclidean_vector& {
+			if (this != &oth) {
+				release(std::exchange(buffer_, std::exchange(oth.buffer_, nullptr)));
+			}
+			return *this;
+		}
+		auto operator[](int i) const noexcept -> double {
+			return vector()[i];
+		}
+		auto operator[](int i) -> double&;
+		// shares the buffer
+		auto operator+() const noexcept -> shared_euclidean_vector {
+			return *this;
+		}
+		// These throw euclidean_vector_error on the same conditions as euclidean_vector's, before
+		// detaching.
+		auto operator+=(euclidean_vector const& oth) -> shared_euclidean_vector&;
+		auto operator-=(euclidean_vector const& oth) -> shared_euclidean_vector&;
+		auto operator+=(shared_euclidean_vector const& oth) -> shared_euclidean_vector&;
+		auto operator-=(shared_euclidean_vector const& oth) -> shared_euclidean_vector&;
+		auto operator*=(double factor) -> shared_euclidean_vector&;
+		auto operator/=(double divisor) -> shared_euclidean_vector&;
+		// copies the magnitudes out
+		explicit operator euclidean_vector() const {
+			return vector();
+		}
+
+		//-----------------------member functions----------------------------------
+		[[nodiscard]] auto at(int i) const -> double {
+			return vector().at(i);
+		}
+		[[nodiscard]] auto at(int i) -> double&;
+		[[nodiscard]] auto dimensions() const noexcept -> int {
+			return vector().dimensions();
+		}
+		[[nodiscard]] auto magnitudes() const noexcept -> std::span<double const> {
+			return vector().magnitudes();
+		}
+		[[nodiscard]] auto magnitudes() -> std::span<double>;
+		// The shared magnitudes, for dot, euclidean_norm, views and the other functions that take
+		// a euclidean_vector. The reference is invalidated by any non-const member.
+		[[nodiscard]] auto vector() const noexcept -> euclidean_vector const& {
+			return buffer_ != nullptr ? buffer_->vector : empty_vector();
+		}
+		// How many objects share the buffer; 0 for a moved-from vector. Like
+		// std::shared_ptr::use_count(), it may already be out of date when other threads hold
+		// copies.
+		[[nodiscard]] auto use_count() const noexcept -> long {
+			return buffer_ != nullptr ? buffer_->references.load(std::memory_order_relaxed) : 0;
+		}
+
+		//--------------------------friends----------------------------------------
+		// vectors that share a buffer are equal without looking at the magnitudes
+		friend auto
+		operator==(shared_euclidean_vector const& lhs, shared_euclidean_vector const& rhs) noexcept
+		   -> bool {
+			return lhs.buffer_ == rhs.buffer_ or lhs.vector() == rhs.vector();
+		}
+		friend auto operator<<(std::ostream& os, shared_euclidean_vector const& v) -> std::ostream& {
+			return os << v.vector();
+		}
+
+	private:
+		struct buffer {
+			std::atomic<long> references{1};
+			euclidean_vector vector;
+		};
+
+		// null after a move
+		buffer* buffer_;
+
+		static auto acquire(buffer* b) noexcept -> void {
+			if (b != nullptr) {
+				// a new reference can only be made from an existing one, so nothing needs ordering
+				b->references.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+		static auto release(buffer* b) noexcept -> void;
+		static auto empty_vector() noexcept -> euclidean_vector const&;
+
+		// gives *this a buffer no other object shares, copying the magnitudes if it has to
+		auto detach() -> euclidean_vector&;
+	};
+} // namespace comp6771
+
+#endif // COMP6771_SHARED_EUCLIDEAN_VECTOR_HPP
@@ -0,0 +1,113 @@
+#ifndef COMP6771_SPARSE_EUCLIDEAN_VECTOR_HPP
+#define COMP6771_SPARSE_EUCLIDEAN_VECTOR_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace comp6771 {
+	// A euclidean vector that only stores its non-zero magnitudes, as a strictly increasing array
+	// of indices and a parallel array of values. Every magnitude that isn't stored is zero. It
+	// takes 12 bytes per stored magnitude instead of 8 bytes per dimension, and dot, += and
+	// euclidean_norm only visit the stored magnitudes, so it pays off once fewer than about two
+	// thirds of the magnitudes are non-zero, and hugely so for bag-of-words style vectors with
+	// millions of dimensions and a handful of non-zeros.
+	//
+	// A stored magnitude may itself be zero, e.g. after adding two vectors whose magnitudes
+	// cancel out; it behaves exactly like one that isn't stored.
+	class sparse_euclidean_vector {
+	public:
+		using allocator_type = std::pmr::polymorphic_allocator<double>;
+
+		//----------------------------constructors---------------------------------
+		// no dimensions
+		sparse_euclidean_vector() noexcept;
+		// the given dimensions, all zero
+		explicit sparse_euclidean_vector(int dimensions,
+		                                 allocator_type const& alloc = allocator_type()) noexcept;
+		// Magnitude indices[k] is values[k] and every other magnitude is zero. Throws
+		// euclidean_vector_error unless indices and values are the same size, and the indices are
+		// strictly increasing and in [0, dimensions).
+		sparse_euclidean_vector(int dimensions,
+		                        std::span<int const> indices,
+		                        std::span<double const> values,
+		                        allocator_type const& alloc = allocator_type());
+		// stores the magnitudes of v that aren't zero
+		explicit sparse_euclidean_vector(const_euclidean_vector_view v,
+		                                 allocator_type const& alloc = allocator_type());
+		// like euclidean_vector, a copy uses the default resource unless given one
+		sparse_euclidean_vector(sparse_euclidean_vector const&);
+		sparse_euclidean_vector(sparse_euclidean_vector const&, allocator_type const& alloc);
+		sparse_euclidean_vector(sparse_euclidean_vector&&) noexcept;
+
+		//---------------------------destructor------------------------------------
+		~sparse_euclidean_vector();
+
+		//---------------------------operators-------------------------------------
+		auto operator=(sparse_euclidean_vector const&) -> sparse_euclidean_vector&;
+		// like the std::pmr containers, this copies when the two use different resources
+		auto operator=(sparse_euclidean_vector&&) -> sparse_euclidean_vector&;
+		// magnitude i, found by binary search; zero if it isn't stored
+		auto operator[](int i) const noexcept -> double;
+		// Stores the union of both vectors' indices. Reuses the existing storage when it has room
+		// for the result.
+		auto operator+=(sparse_euclidean_vector const&) -> sparse_euclidean_vector&;
+		auto operator-=(sparse_euclidean_vector const&) -> sparse_euclidean_vector&;
+		auto operator*=(double) noexcept -> sparse_euclidean_vector&;
+		auto operator/=(double) -> sparse_euclidean_vector&;
+		// a dense copy
+		explicit operator euclidean_vector() const;
+
+		//-----------------------member functions----------------------------------
+		[[nodiscard]] auto at(int i) const -> double;
+		[[nodiscard]] auto dimensions() const noexcept -> int;
+		// number of stored magnitudes
+		[[nodiscard]] auto non_zeros() const noexcept -> int;
+		[[nodiscard]] auto indices() const noexcept -> std::span<int const>;
+		// the stored magnitudes can be changed in place, but not added or removed
+		[[nodiscard]] auto values() noexcept -> std::span<double>;
+		[[nodiscard]] auto values() const noexcept -> std::span<double const>;
+		[[nodiscard]] auto get_allocator() const noexcept -> allocator_type;
+
+		//-------------------------------friends-----------------------------------
+		// Compare the magnitudes they imply, with the same tolerance as euclidean_vector's
+		// operator==, so an explicitly stored zero equals one that isn't stored.
+		friend auto
+		operator==(sparse_euclidean_vector const&, sparse_euclidean_vector const&) noexcept -> bool;
+		friend auto operator==(sparse_euclidean_vector const&, const_euclidean_vector_view) noexcept
+		   -> bool;
+
+	private:
+		int dimensions_ = 0;
+		std::pmr::vector<int> indices_;
+		std::pmr::vector<double> values_;
+
+		// *this += alpha * oth
+		auto merge(sparse_euclidean_vector const& oth, double alpha) -> void;
+	};
+
+	//----------------------Utility functions----------------------------------
+	// All of these throw euclidean_vector_error on the same conditions as the dense overloads.
+	auto euclidean_norm(sparse_euclidean_vector const& v) -> double;
+	// Walks both index arrays together, or, when one vector has many times more stored
+	// magnitudes than the other, gallops through the longer one.
+	auto dot(sparse_euclidean_vector const& x, sparse_euclidean_vector const& y) -> double;
+	// gathers the magnitudes of y at x's indices
+	auto dot(sparse_euclidean_vector const& x, const_euclidean_vector_view y) -> double;
+	auto dot(const_euclidean_vector_view x, sparse_euclidean_vector const& y) -> double;
+
+	// Dense += sparse, which only touches the magnitudes at w's indices. The euclidean_vector
+	// overloads discard the vector's cached norm.
+	auto operator+=(euclidean_vector& v, sparse_euclidean_vector const& w) -> euclidean_vector&;
+	auto operator-=(euclidean_vector& v, sparse_euclidean_vector const& w) -> euclidean_vector&;
+	auto operator+=(euclidean_vector_view v, sparse_euclidean_vector const& w)
+	   -> euclidean_vector_view;
+	auto operator-=(euclidean_vector_view v, sparse_euclidean_vector const& w)
+	   -> euclidean_vector_view;
+} // namespace comp6771
+
+#endif // COMP6771_SPARSE_EUCLIDEAN_VECTOR_HPP
@@ -0,0 +1,152 @@
+#ifndef COMP6771_THREAD_POOL_HPP
+#define COMP6771_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace comp6771 {
+	// A fixed set of worker threads that run parallel_for loops. The thread calling parallel_for
+	// works on the loop too, so a pool of size() n runs n - 1 workers; a pool of size 1 has no
+	// workers and runs everything on the caller.
+	//
+	// Loops are scheduled by work stealing. Every thread starts with an equal, contiguous share of
+	// the indices in its own deque, and takes them from the front one at a time. A thread whose
+	// deque runs dry steals the back half of another thread's deque, so iterations that take
+	// wildly different amounts of time still keep every thread busy, while threads that don't
+	// run out keep working through neighbouring indices.
+	//
+	// One loop runs at a time: concurrent calls to parallel_for are serialised, and a
+	// parallel_for called from inside a loop body runs serially on the calling thread.
+	class thread_pool {
+	public:
+		// one thread per hardware thread
+		thread_pool();
+		explicit thread_pool(int threads);
+		thread_pool(thread_pool const&) = delete;
+		auto operator=(thread_pool const&) -> thread_pool& = delete;
+		~thread_pool();
+
+		// number of threads that work on a loop, including the caller
+		[[nodiscard]] auto size() const noexcept -> int;
+
+		// Calls body(i) once for every i in [0, count), spread across the pool, and returns once
+		// every call has finished. Which thread runs which i is unspecified. If any call throws,
+		// the remaining indices are skipped and the first exception is rethrown.
+		template<std::invocable<std::size_t> F>
+		auto parallel_for(std::size_t count, F&& body) -> void {
+			auto invoke = [](void* context, std::size_t i) {
+				(*static_cast<std::remove_reference_t<F>*>(context))(i);
+			};
+			// invoke restores any const that this cast removes
+			run(count, invoke, const_cast<std::remove_cvref_t<F>*>(std::addressof(body)));
+		}
+
+		// a pool shared by the library's parallel overloads, created on first use
+		[[nodiscard]] static auto shared() -> thread_pool&;
+
+	private:
+		using task_function = void (*)(void*, std::size_t);
+
+		struct loop {
+			task_function body;
+			void* context;
+			std::atomic<bool> failed = false;
+			std::exception_ptr error = nullptr;
+			std::mutex error_mutex{};
+		};
+
+		// the indices [front, back) that a thread has yet to run; a cache line each, so that
+		// threads taking from their own deques don't contend
+		struct alignas(64) work_deque {
+			std::mutex mutex;
+			std::size_t front = 0;
+			std::size_t back = 0;
+		};
+
+		std::vector<std::thread> workers_;
+		// deques_[0] belongs to the thread calling parallel_for, deques_[i + 1] to workers_[i]
+		std::unique_ptr<work_deque[]> deques_;
+		std::mutex submit_mutex_;
+		std::mutex mutex_;
+		std::condition_variable wake_;
+		std::condition_variable idle_;
+		loop* loop_ = nullptr;
+		std::size_t generation_ = 0;
+		int active_ = 0;
+		bool stopping_ = false;
+
+		auto run(std::size_t count, task_function body, void* context) -> void;
+		auto work_on(loop& l, std::size_t self) noexcept -> void;
+		auto take(std::size_t self) noexcept -> std::optional<std::size_t>;
+		auto steal(std::size_t self) noexcept -> std::optional<std::size_t>;
+		auto worker_main(std::size_t self) -> void;
+	};
+
+	//--------------------------batch algorithms---------------------------------
+	// Calls f(element) for every element of range, each as its own task, so that elements that
+	// take much longer than others (e.g. euclidean_vectors of very different dimensions) are
+	// balanced across the pool. f is shared by every thread and may be called concurrently. Throws
+	// the first exception thrown by any call, once every running call has finished.
+	template<std::ranges::random_access_range R, typename F>
+	requires std::ranges::sized_range<R> and std::invocable<F&, std::ranges::range_reference_t<R>>
+	auto parallel_for_each(thread_pool& pool, R&& range, F f) -> void {
+		auto const first = std::ranges::begin(range);
+		pool.parallel_for(static_cast<std::size_t>(std::ranges::size(range)),
+		                  [first, &f](std::size_t i) {
+			                  std::invoke(f, first[static_cast<std::ptrdiff_t>(i)]);
+		                  });
+	}
+
+	inline std::size_t constexpr parallel_reduce_block_size = 16;
+
+	// Returns reduce(... reduce(reduce(init, transform(e0)), transform(e1)) ..., transform(en)),
+	// where reduce must be associative. Elements are combined in fixed blocks of
+	// parallel_reduce_block_size, left to right within a block and then block by block, so the
+	// result is the same for any pool, even when reduce isn't exactly associative, as with floating
+	// point addition. transform and reduce may be called concurrently.
+	template<std::ranges::random_access_range R,
+	         std::movable T,
+	         typename Reduce,
+	         typename Transform>
+	requires std::ranges::sized_range<R>
+	auto parallel_transform_reduce(thread_pool& pool,
+	                               R&& range,
+	                               T init,
+	                               Reduce reduce,
+	                               Transform transform) -> T {
+		auto const size = static_cast<std::size_t>(std::ranges::size(range));
+		auto const blocks = (size + parallel_reduce_block_size - 1) / parallel_reduce_block_size;
+		auto partials = std::vector<std::optional<T>>(blocks);
+		auto const first = std::ranges::begin(range);
+		auto const element = [first, &transform](std::size_t i) {
+			return std::invoke(transform, first[static_cast<std::ptrdiff_t>(i)]);
+		};
+		pool.parallel_for(blocks, [&](std::size_t block) {
+			auto const begin = block * parallel_reduce_block_size;
+			auto const end = std::min(size, begin + parallel_reduce_block_size);
+			auto result = static_cast<T>(element(begin));
+			for (auto i = begin + 1; i < end; ++i) {
+				result = static_cast<T>(std::invoke(reduce, std::move(result), element(i)));
+			}
+			partials[block].emplace(std::move(result));
+		});
+		for (auto& partial : partials) {
+			init = static_cast<T>(std::invoke(reduce, std::move(init), std::move(*partial)));
+		}
+		return init;
+	}
+} // namespace comp6771
+
+#endif // COMP6771_THREAD_POOL_HPP
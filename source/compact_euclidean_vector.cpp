@@ -0,0 +1,166 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/compact_euclidean_vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace comp6771 {
+	namespace {
+		auto constexpr int8_limit = 127.0;
+
+		// the value that stored element e stands for, before scaling
+		template<typename T>
+		auto widen(T e) noexcept -> double {
+			if constexpr (std::same_as<T, std::int8_t>) {
+				return static_cast<double>(e);
+			}
+			else {
+				return static_cast<double>(static_cast<float>(e));
+			}
+		}
+
+		// maps the largest magnitude to int8_limit; a vector of zeros keeps a scale of 1
+		auto quantization_scale(std::span<double const> magnitudes) noexcept -> double {
+			auto largest = 0.0;
+			for (auto const m : magnitudes) {
+				largest = std::max(largest, std::abs(m));
+			}
+			return largest == 0.0 ? 1.0 : largest / int8_limit;
+		}
+	} // namespace
+
+	//---------------------------------constructors------------------------------------------------
+	template<compact_element T>
+	compact_euclidean_vector<T>::compact_euclidean_vector(const_euclidean_vector_view v,
+	                                                      allocator_type const& alloc)
+	: elements_(v.magnitudes().size(), alloc) {
+		auto const magnitudes = v.magnitudes();
+		if constexpr (std::same_as<T, std::int8_t>) {
+			scale_ = quantization_scale(magnitudes);
+			std::ranges::transform(magnitudes, elements_.begin(), [this](double m) {
+				auto const q = std::clamp(std::round(m / scale_), -int8_limit, int8_limit);
+				return static_cast<std::int8_t>(q);
+			});
+		}
+		else if constexpr (std::same_as<T, bfloat16>) {
+			std::ranges::transform(magnitudes, elements_.begin(), [](double m) {
+				return bfloat16(static_cast<float>(m));
+			});
+		}
+		else {
+			std::ranges::transform(magnitudes, elements_.begin(), [](double m) {
+				return static_cast<float>(m);
+			});
+		}
+	}
+
+	template<compact_element T>
+	compact_euclidean_vector<T>::compact_euclidean_vector(compact_euclidean_vector const& orig)
+	: compact_euclidean_vector(orig, allocator_type()) {}
+
+	template<compact_element T>
+	compact_euclidean_vector<T>::compact_euclidean_vector(compact_euclidean_vector const& orig,
+	                                                      allocator_type const& alloc)
+	: elements_(orig.elements_, alloc)
+	, scale_{orig.scale_} {}
+
+	template<compact_element T>
+	compact_euclidean_vector<T>::compact_euclidean_vector(compact_euclidean_vector&& orig) noexcept
+	: elements_(std::move(orig.elements_))
+	, scale_{std::exchange(orig.scale_, 1.0)} {}
+
+	//--------------------------------destructor---------------------------------------------------
+	template<compact_element T>
+	compact_euclidean_vector<T>::~compact_euclidean_vector() = default;
+
+	//---------------------------------operators---------------------------------------------------
+	template<compact_element T>
+	auto compact_euclidean_vector<T>::operator=(compact_euclidean_vector const&)
+	   -> compact_euclidean_vector& = default;
+
+	template<compact_element T>
+	auto compact_euclidean_vector<T>::operator=(compact_euclidean_vector&& oth)
+	   -> compact_euclidean_vector& {
+		if (this == &oth) {
+			return *this;
+		}
+		elements_ = std::move(oth.elements_);
+		scale_ = std::exchange(oth.scale_, 1.0);
+		oth.elements_.clear();
+		return *this;
+	}
+
+	template<compact_element T>
+	auto compact_euclidean_vector<T>::operator[](int i) const noexcept -> double {
+		return scale_ * widen(elements_[static_cast<std::size_t>(i)]);
+	}
+
+	template<compact_element T>
+	compact_euclidean_vector<T>::operator euclidean_vector() const {
+		return euclidean_vector(dimensions(), [this](int i) { return (*this)[i]; });
+	}
+
+	//-------------------------------member functions----------------------------------------------
+	template<compact_element T>
+	auto compact_euclidean_vector<T>::at(int i) const -> double {
+		if (i < 0 or i >= dimensions()) {
+			throw euclidean_vector_error("Index X is not valid for this euclidean_vector object");
+		}
+		return (*this)[i];
+	}
+
+	template<compact_element T>
+	auto compact_euclidean_vector<T>::dimensions() const noexcept -> int {
+		return static_cast<int>(elements_.size());
+	}
+
+	template<compact_element T>
+	auto compact_euclidean_vector<T>::elements() const noexcept -> std::span<T const> {
+		return elements_;
+	}
+
+	template<compact_element T>
+	auto compact_euclidean_vector<T>::scale() const noexcept -> double {
+		return scale_;
+	}
+
+	template<compact_element T>
+	auto compact_euclidean_vector<T>::get_allocator() const noexcept -> allocator_type {
+		return elements_.get_allocator();
+	}
+
+	template class compact_euclidean_vector<float>;
+	template class compact_euclidean_vector<bfloat16>;
+	template class compact_euclidean_vector<std::int8_t>;
+
+	//-------------------------------Utility functions---------------------------------------------
+	template<compact_element T>
+	auto euclidean_norm(compact_euclidean_vector<T> const& v) -> double {
+		if (v.dimensions() == 0) {
+			throw euclidean_vector_error("euclidean_vector with no dimensions does not have a norm");
+		}
+		return v.scale() * std::sqrt(static_cast<double>(kernels::dot(v.elements(), v.elements())));
+	}
+
+	template<compact_element T>
+	auto dot(compact_euclidean_vector<T> const& x, compact_euclidean_vector<T> const& y) -> double {
+		if (x.dimensions() != y.dimensions()) {
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		return x.scale() * y.scale() * static_cast<double>(kernels::dot(x.elements(), y.elements()));
+	}
+
+	template auto euclidean_norm(compact_euclidean_vector<float> const&) -> double;
+	template auto euclidean_norm(compact_euclidean_vector<bfloat16> const&) -> double;
+	template auto euclidean_norm(compact_euclidean_vector<std::int8_t> const&) -> double;
+	template auto dot(compact_euclidean_vector<float> const&,
+	                  compact_euclidean_vector<float> const&) -> double;
+	template auto dot(compact_euclidean_vector<bfloat16> const&,
+	                  compact_euclidean_vector<bfloat16> const&) -> double;
+	template auto dot(compact_euclidean_vector<std::int8_t> const&,
+	                  compact_euclidean_vector<std::int8_t> const&) -> double;
+} // namespace comp6771
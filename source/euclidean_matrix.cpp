@@ -0,0 +1,454 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <gsl/gsl-lite.hpp>
+#include <utility>
+
+namespace comp6771 {
+	namespace {
+		// rows or columns are padded to whole cache lines, so each one starts aligned
+		auto padded(int length) noexcept -> std::size_t {
+			auto constexpr per_line = euclidean_matrix::storage_alignment / sizeof(double);
+			auto const size = gsl_lite::narrow_cast<std::size_t>(length);
+			return (size + per_line - 1) / per_line * per_line;
+		}
+
+		// The query is split into blocks small enough to stay in L1 while every row is scored
+		// against them.
+		auto constexpr query_block = std::size_t{1024};
+		// In column-major layout, results are accumulated in runs of rows that stay in L1 across
+		// every column.
+		auto constexpr row_block = std::size_t{2048};
+		// Matrix-matrix products score candidates in blocks that stay in L2 across every query.
+		auto constexpr candidate_block_bytes = std::size_t{256} * 1024;
+
+		// result[i] = dot(query, row i), for count rows that start stride doubles apart. Rows are
+		// scored four at a time, so each load of the query is shared by four rows.
+		auto dot_rows(double const* rows,
+		              std::size_t stride,
+		              std::size_t count,
+		              std::span<double const> query,
+		              std::span<double> result) noexcept -> void {
+			std::fill(result.begin(), result.end(), 0.0);
+			for (auto k = std::size_t{0}; k < query.size(); k += query_block) {
+				auto const block = query.subspan(k, std::min(query_block, query.size() - k));
+				auto i = std::size_t{0};
+				for (; i + 4 <= count; i += 4) {
+					kernels::dot4(block, rows + i * stride + k, stride, result.subspan(i).first<4>());
+				}
+				for (; i < count; ++i) {
+					result[i] += kernels::dot(block, {rows + i * stride + k, block.size()});
+				}
+			}
+		}
+
+		// result[i] = dot(query, row i) for column-major storage, one axpy per column
+		auto dot_columns(double const* columns,
+		                 std::size_t stride,
+		                 std::span<double const> query,
+		                 std::span<double> result) noexcept -> void {
+			std::fill(result.begin(), result.end(), 0.0);
+			for (auto i = std::size_t{0}; i < result.size(); i += row_block) {
+				auto const run = result.subspan(i, std::min(row_block, result.size() - i));
+				for (auto j = std::size_t{0}; j < query.size(); ++j) {
+					kernels::axpy(query[j], {columns + j * stride + i, run.size()}, run);
+				}
+			}
+		}
+
+		auto check_norms(std::span<double const> norms, int rows) -> void {
+			if (norms.size() != gsl_lite::narrow_cast<std::size_t>(rows)) {
+				throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+			}
+			if (std::find(norms.begin(), norms.end(), 0.0) != norms.end()) {
+				throw euclidean_vector_error("euclidean_vector with zero euclidean normal does not "
+				                             "have a unit vector");
+			}
+		}
+	} // namespace
+
+	//------------------------------constructors---------------------------------------------------
+	euclidean_matrix::euclidean_matrix() noexcept = default;
+
+	euclidean_matrix::euclidean_matrix(int rows,
+	                                   int dimensions,
+	                                   double value,
+	                                   matrix_layout layout,
+	                                   allocator_type const& alloc)
+	: allocator_{alloc} {
+		allocate(rows, dimensions, layout);
+		auto const lines = gsl_lite::narrow_cast<std::size_t>(layout_ == matrix_layout::row_major
+		                                                         ? rows_
+		                                                         : dimensions_);
+		auto const length = gsl_lite::narrow_cast<std::size_t>(layout_ == matrix_layout::row_major
+		                                                          ? dimensions_
+		                                                          : rows_);
+		for (auto line = std::size_t{0}; line < lines; ++line) {
+			auto* const first = data_ + line * stride_;
+			std::fill(first, first + length, value);
+			std::fill(first + length, first + stride_, 0.0);
+		}
+	}
+
+	euclidean_matrix::euclidean_matrix(std::span<euclidean_vector const> vectors,
+	                                   matrix_layout layout,
+	                                   allocator_type const& alloc)
+	: euclidean_matrix(gsl_lite::narrow_cast<int>(vectors.size()),
+	                   vectors.empty() ? 0 : vectors.front().dimensions(),
+	                   0.0,
+	                   layout,
+	                   alloc) {
+		for (auto i = 0; i < rows_; ++i) {
+			set_row(i, vectors[gsl_lite::narrow_cast<std::size_t>(i)]);
+		}
+	}
+
+	euclidean_matrix::euclidean_matrix(euclidean_matrix const& orig)
+	: euclidean_matrix(orig, allocator_type()) {}
+
+	euclidean_matrix::euclidean_matrix(euclidean_matrix const& orig, allocator_type const& alloc)
+	: allocator_{alloc} {
+		allocate(orig.rows_, orig.dimensions_, orig.layout_);
+		std::copy_n(orig.data_, storage_size(), data_);
+	}
+
+	euclidean_matrix::euclidean_matrix(euclidean_matrix const& orig,
+	                                   matrix_layout layout,
+	                                   allocator_type const& alloc)
+	: euclidean_matrix(orig.rows_, orig.dimensions_, 0.0, layout, alloc) {
+		for (auto i = 0; i < rows_; ++i) {
+			for (auto j = 0; j < dimensions_; ++j) {
+				(*this)(i, j) = orig(i, j);
+			}
+		}
+	}
+
+	euclidean_matrix::euclidean_matrix(euclidean_matrix&& orig) noexcept
+	: rows_{std::exchange(orig.rows_, 0)}
+	, dimensions_{std::exchange(orig.dimensions_, 0)}
+	, layout_{orig.layout_}
+	, stride_{std::exchange(orig.stride_, 0)}
+	, data_{std::exchange(orig.data_, nullptr)}
+	, allocator_{orig.allocator_} {}
+
+	//--------------------------------destructor---------------------------------------------------
+	euclidean_matrix::~euclidean_matrix() {
+		deallocate();
+	}
+
+	//-----------------------------------storage---------------------------------------------------
+	auto euclidean_matrix::storage_size() const noexcept -> std::size_t {
+		auto const lines = layout_ == matrix_layout::row_major ? rows_ : dimensions_;
+		return gsl_lite::narrow_cast<std::size_t>(lines) * stride_;
+	}
+
+	auto euclidean_matrix::index_of(int row, int dimension) const noexcept -> std::size_t {
+		auto const r = gsl_lite::narrow_cast<std::size_t>(row);
+		auto const d = gsl_lite::narrow_cast<std::size_t>(dimension);
+		return layout_ == matrix_layout::row_major ? r * stride_ + d : d * stride_ + r;
+	}
+
+	auto euclidean_matrix::allocate(int rows, int dimensions, matrix_layout layout) -> void {
+		layout_ = layout;
+		stride_ = padded(layout == matrix_layout::row_major ? dimensions : rows);
+		rows_ = rows;
+		dimensions_ = dimensions;
+		auto const size = storage_size();
+		data_ = size == 0 ? nullptr
+		                  : static_cast<double*>(
+		                     allocator_.allocate_bytes(size * sizeof(double), storage_alignment));
+	}
+
+	auto euclidean_matrix::deallocate() noexcept -> void {
+		if (data_ != nullptr) {
+			allocator_.deallocate_bytes(data_, storage_size() * sizeof(double), storage_alignment);
+		}
+		rows_ = 0;
+		dimensions_ = 0;
+		stride_ = 0;
+		data_ = nullptr;
+	}
+
+	//--------------------------------operations---------------------------------------------------
+	// Like euclidean_vector, assignment keeps our resource.
+	auto euclidean_matrix::operator=(euclidean_matrix const& oth) -> euclidean_matrix& {
+		if (this == &oth) {
+			return *this;
+		}
+		if (rows_ != oth.rows_ or dimensions_ != oth.dimensions_ or layout_ != oth.layout_) {
+			deallocate();
+			allocate(oth.rows_, oth.dimensions_, oth.layout_);
+		}
+		std::copy_n(oth.data_, storage_size(), data_);
+		return *this;
+	}
+
+	auto euclidean_matrix::operator=(euclidean_matrix&& oth) -> euclidean_matrix& {
+		if (this == &oth) {
+			return *this;
+		}
+		if (allocator_ != oth.allocator_) {
+			return *this = static_cast<euclidean_matrix const&>(oth);
+		}
+		deallocate();
+		rows_ = std::exchange(oth.rows_, 0);
+		dimensions_ = std::exchange(oth.dimensions_, 0);
+		layout_ = oth.layout_;
+		stride_ = std::exchange(oth.stride_, 0);
+		data_ = std::exchange(oth.data_, nullptr);
+		return *this;
+	}
+
+	auto euclidean_matrix::operator()(int row, int dimension) noexcept -> double& {
+		assert(row >= 0 and row < rows_ and dimension >= 0 and dimension < dimensions_);
+		return data_[index_of(row, dimension)];
+	}
+	auto euclidean_matrix::operator()(int row, int dimension) const noexcept -> double {
+		assert(row >= 0 and row < rows_ and dimension >= 0 and dimension < dimensions_);
+		return data_[index_of(row, dimension)];
+	}
+
+	//---------------------------------Member Functions--------------------------------------------
+	auto euclidean_matrix::rows() const noexcept -> int {
+		return rows_;
+	}
+	auto euclidean_matrix::dimensions() const noexcept -> int {
+		return dimensions_;
+	}
+	auto euclidean_matrix::layout() const noexcept -> matrix_layout {
+		return layout_;
+	}
+	auto euclidean_matrix::stride() const noexcept -> std::size_t {
+		return stride_;
+	}
+	auto euclidean_matrix::get_allocator() const noexcept -> allocator_type {
+		return allocator_;
+	}
+
+	auto euclidean_matrix::check_row(int i) const -> void {
+		if (i < 0 or i >= rows_) {
+			throw euclidean_vector_error("Index X is not valid for this euclidean_vector object");
+		}
+	}
+	auto euclidean_matrix::check_column(int j) const -> void {
+		if (j < 0 or j >= dimensions_) {
+			throw euclidean_vector_error("Index X is not valid for this euclidean_vector object");
+		}
+	}
+
+	auto euclidean_matrix::check_row_view(int i) const -> void {
+		check_row(i);
+		if (layout_ != matrix_layout::row_major) {
+			throw euclidean_vector_error("Rows of a column-major euclidean_matrix are not contiguous");
+		}
+	}
+	auto euclidean_matrix::check_column_view(int j) const -> void {
+		check_column(j);
+		if (layout_ != matrix_layout::column_major) {
+			throw euclidean_vector_error("Columns of a row-major euclidean_matrix are not "
+			                             "contiguous");
+		}
+	}
+
+	auto euclidean_matrix::row(int i) -> euclidean_vector_view {
+		check_row_view(i);
+		return euclidean_vector_view(data_ + index_of(i, 0), dimensions_);
+	}
+	auto euclidean_matrix::row(int i) const -> const_euclidean_vector_view {
+		check_row_view(i);
+		return const_euclidean_vector_view(data_ + index_of(i, 0), dimensions_);
+	}
+
+	auto euclidean_matrix::column(int j) -> euclidean_vector_view {
+		check_column_view(j);
+		return euclidean_vector_view(data_ + index_of(0, j), rows_);
+	}
+	auto euclidean_matrix::column(int j) const -> const_euclidean_vector_view {
+		check_column_view(j);
+		return const_euclidean_vector_view(data_ + index_of(0, j), rows_);
+	}
+
+	auto euclidean_matrix::get_row(int i) const -> euclidean_vector {
+		check_row(i);
+		return euclidean_vector(dimensions_, [this, i](int j) { return (*this)(i, j); });
+	}
+
+	auto euclidean_matrix::set_row(int i, const_euclidean_vector_view v) -> void {
+		check_row(i);
+		if (v.dimensions() != dimensions_) {
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		for (auto j = 0; j < dimensions_; ++j) {
+			(*this)(i, j) = v[j];
+		}
+	}
+
+	//-------------------------------Utility functions---------------------------------------------
+	// Row-major runs one kernel per row. Column-major instead sweeps each column across all rows,
+	// accumulating every row's result at once, so the inner loop vectorises over rows and never
+	// has to reduce within a short row.
+	auto dot(euclidean_matrix const& m, const_euclidean_vector_view v) -> std::vector<double> {
+		auto result = std::vector<double>(gsl_lite::narrow_cast<std::size_t>(m.rows()));
+		dot(m, v, result);
+		return result;
+	}
+
+	auto dot(euclidean_matrix const& m, const_euclidean_vector_view v, std::span<double> result)
+	   -> void {
+		if (m.dimensions_ != v.dimensions()
+		    or result.size() != gsl_lite::narrow_cast<std::size_t>(m.rows_))
+		{
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		if (m.layout_ == matrix_layout::row_major) {
+			dot_rows(m.data_, m.stride_, result.size(), v.magnitudes(), result);
+		}
+		else {
+			dot_columns(m.data_, m.stride_, v.magnitudes(), result);
+		}
+	}
+
+	// Candidates are scored in blocks that fit in L2; within a block, each query row stays in L1
+	// while it is scored against every candidate in the block.
+	auto dot(euclidean_matrix const& queries, euclidean_matrix const& candidates)
+	   -> euclidean_matrix {
+		if (queries.dimensions_ != candidates.dimensions_) {
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		auto result = euclidean_matrix(queries.rows_, candidates.rows_);
+		// vectors with no dimensions have a dot product of 0, and no stride to block by
+		if (result.rows_ == 0 or result.dimensions_ == 0 or queries.dimensions_ == 0) {
+			return result;
+		}
+		auto transposed = euclidean_matrix();
+		if (queries.layout_ == matrix_layout::column_major) {
+			transposed = euclidean_matrix(queries, matrix_layout::row_major);
+		}
+		auto const& query_rows =
+		   queries.layout_ == matrix_layout::row_major ? queries : transposed;
+		if (candidates.layout_ == matrix_layout::column_major) {
+			for (auto i = 0; i < result.rows_; ++i) {
+				dot(candidates, query_rows.row(i), result.row(i).magnitudes());
+			}
+			return result;
+		}
+
+		auto const count = gsl_lite::narrow_cast<std::size_t>(candidates.rows_);
+		auto const per_block = std::max(std::size_t{4},
+		                                candidate_block_bytes / (candidates.stride_ * sizeof(double))
+		                                   / 4 * 4);
+		for (auto first = std::size_t{0}; first < count; first += per_block) {
+			auto const block = std::min(per_block, count - first);
+			for (auto i = 0; i < result.rows_; ++i) {
+				dot_rows(candidates.data_ + first * candidates.stride_,
+				         candidates.stride_,
+				         block,
+				         query_rows.row(i).magnitudes(),
+				         result.row(i).magnitudes().subspan(first, block));
+			}
+		}
+		return result;
+	}
+
+	auto cosine_similarity(euclidean_matrix const& m,
+	                       std::span<double const> norms,
+	                       euclidean_vector const& query) -> std::vector<double> {
+		auto result = dot(m, query);
+		check_norms(norms, m.rows());
+		auto const query_norm = euclidean_norm(query);
+		if (query_norm == 0.0) {
+			throw euclidean_vector_error("euclidean_vector with zero euclidean normal does not "
+			                             "have a unit vector");
+		}
+		for (auto i = std::size_t{0}; i < result.size(); ++i) {
+			result[i] /= norms[i] * query_norm;
+		}
+		return result;
+	}
+
+	auto cosine_similarity(euclidean_matrix const& m, euclidean_vector const& query)
+	   -> std::vector<double> {
+		return cosine_similarity(m, euclidean_norm(m), query);
+	}
+
+	auto cosine_similarity(euclidean_matrix const& queries,
+	                       euclidean_matrix const& candidates,
+	                       std::span<double const> candidate_norms) -> euclidean_matrix {
+		auto result = dot(queries, candidates);
+		check_norms(candidate_norms, candidates.rows());
+		auto const query_norms = euclidean_norm(queries);
+		check_norms(query_norms, queries.rows());
+		for (auto i = 0; i < result.rows(); ++i) {
+			auto const scores = result.row(i).magnitudes();
+			auto const query_norm = query_norms[gsl_lite::narrow_cast<std::size_t>(i)];
+			for (auto j = std::size_t{0}; j < scores.size(); ++j) {
+				scores[j] /= query_norm * candidate_norms[j];
+			}
+		}
+		return result;
+	}
+
+	auto cosine_similarity(euclidean_matrix const& queries, euclidean_matrix const& candidates)
+	   -> euclidean_matrix {
+		return cosine_similarity(queries, candidates, euclidean_norm(candidates));
+	}
+
+	auto euclidean_norm(euclidean_matrix const& m) -> std::vector<double> {
+		if (m.dimensions_ == 0 and m.rows_ != 0) {
+			throw euclidean_vector_error("euclidean_vector with no dimensions does not have a norm");
+		}
+		auto result = std::vector<double>(gsl_lite::narrow_cast<std::size_t>(m.rows_));
+		if (m.layout_ == matrix_layout::row_major) {
+			for (auto i = 0; i < m.rows_; ++i) {
+				result[gsl_lite::narrow_cast<std::size_t>(i)] =
+				   kernels::squared_norm(m.row(i).magnitudes());
+			}
+		}
+		else {
+			for (auto j = 0; j < m.dimensions_; ++j) {
+				auto const column = m.column(j).magnitudes();
+				for (auto i = std::size_t{0}; i < column.size(); ++i) {
+					result[i] += column[i] * column[i];
+				}
+			}
+		}
+		std::transform(result.begin(), result.end(), result.begin(), [](double squared) {
+			return std::sqrt(squared);
+		});
+		return result;
+	}
+
+	auto unit(euclidean_matrix const& m) -> euclidean_matrix {
+		if (m.dimensions_ == 0 and m.rows_ != 0) {
+			throw euclidean_vector_error("euclidean_vector with no dimensions does not have a unit "
+			                             "vector");
+		}
+		auto const norms = euclidean_norm(m);
+		if (std::find(norms.begin(), norms.end(), 0.0) != norms.end()) {
+			throw euclidean_vector_error("euclidean_vector with zero euclidean normal does not "
+			                             "have a unit vector");
+		}
+		auto result = m;
+		if (m.layout_ == matrix_layout::row_major) {
+			for (auto i = 0; i < m.rows_; ++i) {
+				auto const norm = norms[gsl_lite::narrow_cast<std::size_t>(i)];
+				kernels::divide(norm, result.row(i).magnitudes());
+			}
+		}
+		else {
+			for (auto j = 0; j < m.dimensions_; ++j) {
+				auto const column = result.column(j).magnitudes();
+				for (auto i = std::size_t{0}; i < column.size(); ++i) {
+					column[i] /= norms[i];
+				}
+			}
+		}
+		return result;
+	}
+} // namespace comp6771
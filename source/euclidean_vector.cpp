@@ -2,10 +2,14 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 //
 #include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+#include "comp6771/euclidean_vector_stats.hpp"
+#include <algorithm>
+#include <cmath>
 #include <gsl/gsl-lite.hpp>
-#include <range/v3/numeric/accumulate.hpp>
 #include <range/v3/range.hpp>
 #include <range/v3/view.hpp>
+#include <utility>
 // why can compile here but not in master?
 namespace comp6771 {
 	//------------------------------constructors---------------------------------------------------
@@ -19,85 +23,282 @@ namespace comp6771 {
 
 	// fill constructor
 	euclidean_vector::euclidean_vector(int dimensions, double value) noexcept
-	: dimensions_{dimensions} {
+	: euclidean_vector(dimensions, value, allocator_type()) {}
+
+	// range constructor
+	euclidean_vector::euclidean_vector(std::vector<double>::const_iterator begin_iter,
+	                                   std::vector<double>::const_iterator end_iter) noexcept
+	: euclidean_vector(begin_iter, end_iter, allocator_type()) {}
+
+	// initializer list constructor
+	euclidean_vector::euclidean_vector(std::initializer_list<double> list) noexcept
+	: euclidean_vector(list, allocator_type()) {}
+
+	// copy constructor; like the std::pmr containers, the copy doesn't inherit orig's resource
+	euclidean_vector::euclidean_vector(euclidean_vector const& orig) noexcept
+	: euclidean_vector(orig, allocator_type()) {}
+
+	// move constructor
+	euclidean_vector::euclidean_vector(euclidean_vector&& orig) noexcept
+	: allocator_{orig.allocator_}
+	, norm_cache_{orig.norm_cache_.load(std::memory_order_relaxed)} {
+		take_magnitudes(orig);
+	}
+
+	// uninitialized constructor
+	euclidean_vector::euclidean_vector(uninitialized_t, int dimensions) noexcept
+	: euclidean_vector(uninitialized, dimensions, allocator_type()) {}
+
+	// consuming std::vector constructor
+	euclidean_vector::euclidean_vector(std::vector<double>&& magnitudes)
+	: euclidean_vector(std::move(magnitudes), allocator_type()) {}
+
+	//-------------------------allocator-extended constructors-------------------------------------
+	euclidean_vector::euclidean_vector(allocator_type const& alloc)
+	: euclidean_vector(1, alloc) {}
+
+	euclidean_vector::euclidean_vector(int dimension, allocator_type const& alloc)
+	: euclidean_vector(dimension, 0, alloc) {}
+
+	euclidean_vector::euclidean_vector(int dimensions, double value, allocator_type const& alloc)
+	: allocator_{alloc} {
+		allocate(dimensions);
 		// size_t may have different bits than int in some machines
 		// so I cast int to unsigned int (not size_t)
 		auto const dim_size = gsl_lite::narrow_cast<unsigned int>(dimensions_);
-		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		magnitudes_ = std::make_unique<double[]>(dim_size);
-		auto usable_data = std::span<double>(magnitudes_.get(), dim_size);
+		auto usable_data = std::span<double>(aligned_magnitudes(), dim_size);
 		ranges::fill(usable_data, value); // wow, span is so convinient
 	}
 
-	// range constructor
 	euclidean_vector::euclidean_vector(std::vector<double>::const_iterator begin_iter,
-	                                   std::vector<double>::const_iterator end_iter) noexcept
-	: dimensions_{static_cast<int>(ranges::distance(begin_iter, end_iter))} {
+	                                   std::vector<double>::const_iterator end_iter,
+	                                   allocator_type const& alloc)
+	: allocator_{alloc} {
+		allocate(static_cast<int>(ranges::distance(begin_iter, end_iter)));
 		auto const dim_size = gsl_lite::narrow_cast<unsigned int>(dimensions_);
-		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		magnitudes_ = std::make_unique<double[]>(dim_size);
-		auto usable_data = std::span<double>(magnitudes_.get(), dim_size);
+		auto usable_data = std::span<double>(aligned_magnitudes(), dim_size);
 		ranges::copy(begin_iter, end_iter, usable_data.begin());
 	}
 
-	// initializer list constructor
-	euclidean_vector::euclidean_vector(std::initializer_list<double> list) noexcept
-	: dimensions_{static_cast<int>(ranges::distance(list))} {
+	euclidean_vector::euclidean_vector(std::initializer_list<double> list,
+	                                   allocator_type const& alloc)
+	: allocator_{alloc} {
+		allocate(static_cast<int>(ranges::distance(list)));
 		auto const dim_size = gsl_lite::narrow_cast<unsigned int>(dimensions_);
-		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		magnitudes_ = std::make_unique<double[]>(dim_size);
-		auto usable_data = std::span<double>(magnitudes_.get(), dim_size);
+		auto usable_data = std::span<double>(aligned_magnitudes(), dim_size);
 		ranges::copy(list.begin(), list.end(), usable_data.begin());
 	}
 
-	// copy constructor
-	euclidean_vector::euclidean_vector(euclidean_vector const& orig) noexcept
-	: dimensions_{orig.dimensions_} {
-		auto const dim_size = gsl_lite::narrow_cast<unsigned int>(dimensions_);
-		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		magnitudes_ = std::make_unique<double[]>(dim_size);
-		auto usable_data = std::span<double>(magnitudes_.get(), dim_size);
-		auto const orig_data = std::span<double>(orig.magnitudes_.get(), dim_size);
-		ranges::copy(orig_data.begin(), orig_data.end(), usable_data.begin());
+	euclidean_vector::euclidean_vector(euclidean_vector const& orig, allocator_type const& alloc)
+	: allocator_{alloc}
+	, norm_cache_{orig.norm_cache_.load(std::memory_order_relaxed)} {
+		allocate(orig.dimensions_);
+		copy_magnitudes(orig);
 	}
 
-	// move constructor
-	euclidean_vector::euclidean_vector(euclidean_vector&& orig) noexcept
-	: dimensions_{orig.dimensions_} {
-		magnitudes_ = std::move(orig.magnitudes_);
+	euclidean_vector::euclidean_vector(euclidean_vector&& orig, allocator_type const& alloc)
+	: allocator_{alloc}
+	, norm_cache_{orig.norm_cache_.load(std::memory_order_relaxed)} {
+		if (allocator_ == orig.allocator_) {
+			take_magnitudes(orig);
+		}
+		else {
+			allocate(orig.dimensions_);
+			copy_magnitudes(orig);
+		}
+	}
+
+	euclidean_vector::euclidean_vector(uninitialized_t, int dimensions, allocator_type const& alloc)
+	: allocator_{alloc} {
+		allocate(dimensions);
+	}
+
+	euclidean_vector::euclidean_vector(std::vector<double>&& magnitudes, allocator_type const& alloc)
+	: euclidean_vector(magnitudes.cbegin(), magnitudes.cend(), alloc) {
+		magnitudes = std::vector<double>();
+	}
+
+	//--------------------------------destructor---------------------------------------------------
+	euclidean_vector::~euclidean_vector() {
+		deallocate();
+	}
+
+	//-----------------------------------storage---------------------------------------------------
+	namespace {
+		auto storage_bytes(int dimensions) noexcept -> std::size_t {
+			return gsl_lite::narrow_cast<std::size_t>(dimensions) * sizeof(double);
+		}
+
+		// records a call of op on a vector with this many dimensions, until the end of the scope
+		auto record(stats::operation op, int dimensions) noexcept -> stats::scoped_operation {
+			return stats::scoped_operation(op, gsl_lite::narrow_cast<std::size_t>(dimensions));
+		}
+	} // namespace
+
+	// Vectors with at most inline_capacity dimensions keep their magnitudes in inline_magnitudes_,
+	// larger ones in memory from allocator_. magnitudes_ always points at whichever is in use.
+	// Allocated storage is requested with storage_alignment, so it starts on a cache line too.
+	auto euclidean_vector::allocate(int dimensions) -> void {
+		magnitudes_ = dimensions <= inline_capacity
+		                 ? inline_magnitudes_.data()
+		                 : static_cast<double*>(
+		                    allocator_.allocate_bytes(storage_bytes(dimensions), storage_alignment));
+		dimensions_ = dimensions;
+		if (magnitudes_ != inline_magnitudes_.data()) {
+			stats::count(stats::counter::allocations);
+			stats::count(stats::counter::allocated_bytes, storage_bytes(dimensions));
+		}
+	}
+
+	auto euclidean_vector::deallocate() noexcept -> void {
+		if (magnitudes_ != inline_magnitudes_.data()) {
+			allocator_.deallocate_bytes(magnitudes_, storage_bytes(dimensions_), storage_alignment);
+		}
+		dimensions_ = 0;
+		magnitudes_ = inline_magnitudes_.data();
+	}
+
+	// Moves orig's magnitudes into *this, which must not own any allocated storage and must use an
+	// allocator equal to orig's, and leaves orig with no dimensions. Allocated storage is handed
+	// over; inline magnitudes have to be copied.
+	auto euclidean_vector::take_magnitudes(euclidean_vector& orig) noexcept -> void {
+		stats::count(stats::counter::moves);
+		dimensions_ = orig.dimensions_;
+		if (orig.magnitudes_ == orig.inline_magnitudes_.data()) {
+			std::copy_n(orig.inline_magnitudes_.begin(), dimensions_, inline_magnitudes_.begin());
+			magnitudes_ = inline_magnitudes_.data();
+		}
+		else {
+			magnitudes_ = orig.magnitudes_;
+		}
 		orig.dimensions_ = 0;
+		orig.magnitudes_ = orig.inline_magnitudes_.data();
+		orig.invalidate_norm();
+	}
+
+	//------------------------------released storage---------------------------------------------
+	magnitude_storage::magnitude_storage(double* magnitudes,
+	                                     int dimensions,
+	                                     allocator_type const& alloc) noexcept
+	: magnitudes_{magnitudes}
+	, dimensions_{dimensions}
+	, resource_{alloc.resource()} {}
+
+	magnitude_storage::magnitude_storage(magnitude_storage&& orig) noexcept
+	: magnitudes_{std::exchange(orig.magnitudes_, nullptr)}
+	, dimensions_{std::exchange(orig.dimensions_, 0)}
+	, resource_{orig.resource_} {}
+
+	magnitude_storage::~magnitude_storage() {
+		reset();
+	}
+
+	auto magnitude_storage::operator=(magnitude_storage&& oth) noexcept -> magnitude_storage& {
+		if (this != &oth) {
+			reset();
+			magnitudes_ = std::exchange(oth.magnitudes_, nullptr);
+			dimensions_ = std::exchange(oth.dimensions_, 0);
+			resource_ = oth.resource_;
+		}
+		return *this;
+	}
+
+	auto magnitude_storage::magnitudes() const noexcept -> std::span<double> {
+		return {magnitudes_, gsl_lite::narrow_cast<std::size_t>(dimensions_)};
+	}
+
+	auto magnitude_storage::get_allocator() const noexcept -> allocator_type {
+		return allocator_type(resource_);
+	}
+
+	auto magnitude_storage::reset() noexcept -> void {
+		if (magnitudes_ != nullptr) {
+			resource_->deallocate(magnitudes_,
+			                      storage_bytes(dimensions_),
+			                      euclidean_vector::storage_alignment);
+		}
+		magnitudes_ = nullptr;
+		dimensions_ = 0;
+	}
+
+	euclidean_vector::euclidean_vector(magnitude_storage&& storage) noexcept
+	: allocator_{storage.resource_} {
+		if (storage.dimensions_ <= inline_capacity) {
+			allocate(storage.dimensions_);
+			std::copy_n(storage.magnitudes_, storage.dimensions_, inline_magnitudes_.begin());
+			storage.reset();
+		}
+		else {
+			dimensions_ = std::exchange(storage.dimensions_, 0);
+			magnitudes_ = std::exchange(storage.magnitudes_, nullptr);
+		}
+	}
+
+	auto euclidean_vector::release() -> magnitude_storage {
+		if (dimensions_ == 0) {
+			return magnitude_storage();
+		}
+		if (magnitudes_ == inline_magnitudes_.data()) {
+			auto* const storage = static_cast<double*>(
+			   allocator_.allocate_bytes(storage_bytes(dimensions_), storage_alignment));
+			stats::count(stats::counter::allocations);
+			stats::count(stats::counter::allocated_bytes, storage_bytes(dimensions_));
+			std::copy_n(inline_magnitudes_.begin(), dimensions_, storage);
+			magnitudes_ = storage;
+		}
+		auto result = magnitude_storage(magnitudes_, dimensions_, allocator_);
+		dimensions_ = 0;
+		magnitudes_ = inline_magnitudes_.data();
+		invalidate_norm();
+		return result;
+	}
+
+	// copies orig's magnitudes into *this, which must already have orig's dimensions
+	auto euclidean_vector::copy_magnitudes(euclidean_vector const& orig) -> void {
+		stats::count(stats::counter::deep_copies);
+		auto const dim_size = gsl_lite::narrow_cast<unsigned int>(dimensions_);
+		auto usable_data = std::span<double>(aligned_magnitudes(), dim_size);
+		auto const orig_data = std::span<double>(orig.aligned_magnitudes(), dim_size);
+		ranges::copy(orig_data.begin(), orig_data.end(), usable_data.begin());
 	}
 
 	//--------------------------------operations---------------------------------------------------
-	auto euclidean_vector::operator=(euclidean_vector const& oth) noexcept -> euclidean_vector& {
+	auto euclidean_vector::operator=(euclidean_vector const& oth) -> euclidean_vector& {
 		// if I instead use std::addressof(*this) == std::addressof(orig), a error message regarding
 		// self-assignment will occur
 		if (this == &oth) {
 			return *this;
 		}
-		auto const new_dim_size = gsl_lite::narrow_cast<unsigned int>(oth.dimensions_);
+		// our resource is kept; only the magnitudes are copied
 		if (dimensions_ != oth.dimensions_) {
-			dimensions_ = oth.dimensions_;
-			// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-			magnitudes_ = std::make_unique<double[]>(new_dim_size);
+			// if allocate throws, *this is left empty rather than with a norm it no longer has
+			invalidate_norm();
+			deallocate();
+			allocate(oth.dimensions_);
 		}
-		auto usable_data = std::span<double>(magnitudes_.get(), new_dim_size);
-		auto const orig_data = std::span<double>(oth.magnitudes_.get(), new_dim_size);
-		ranges::copy(orig_data.begin(), orig_data.end(), usable_data.begin());
+		copy_magnitudes(oth);
+		norm_cache_.store(oth.norm_cache_.load(std::memory_order_relaxed), std::memory_order_relaxed);
 		return *this;
 	}
 
-	auto euclidean_vector::operator=(euclidean_vector&& oth) noexcept -> euclidean_vector& {
+	auto euclidean_vector::operator=(euclidean_vector&& oth) -> euclidean_vector& {
 		if (this == &oth) { // same object
 			return *this;
 		}
-		dimensions_ = oth.dimensions_;
-		magnitudes_ = std::move(oth.magnitudes_);
-		oth.dimensions_ = 0;
+		// Our resource is kept, so oth's storage can only be taken over if it came from an equal
+		// resource; otherwise this is a copy into our own storage.
+		if (allocator_ != oth.allocator_) {
+			return *this = static_cast<euclidean_vector const&>(oth);
+		}
+		deallocate();
+		norm_cache_.store(oth.norm_cache_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		take_magnitudes(oth);
 		return *this;
 	}
 	auto euclidean_vector::operator[](int i) noexcept -> double& {
 		assert(i >= 0 and i < dimensions_);
+		// the caller may write through the returned reference, so the cached norm can't be trusted
+		invalidate_norm();
 		return magnitudes_[gsl_lite::narrow_cast<unsigned int>(i)];
 	}
 	auto euclidean_vector::operator[](int i) const noexcept -> double {
@@ -105,54 +306,87 @@ namespace comp6771 {
 		return magnitudes_[gsl_lite::narrow_cast<unsigned int>(i)];
 	}
 
-	auto euclidean_vector::operator+() const noexcept -> euclidean_vector {
+	auto euclidean_vector::operator+() const& noexcept -> euclidean_vector {
 		return *this;
 	}
-	auto euclidean_vector::operator-() const noexcept -> euclidean_vector {
-		auto v = static_cast<std::vector<double>>(*this);
-		ranges::transform(v, v.begin(), std::negate<>());
-		return euclidean_vector(v.begin(), v.end());
+	auto euclidean_vector::operator+() && noexcept -> euclidean_vector {
+		return std::move(*this);
+	}
+	auto euclidean_vector::operator-() const& noexcept -> euclidean_vector {
+		return detail::negate_expression<euclidean_vector const&>(*this);
+	}
+	auto euclidean_vector::operator-() && noexcept -> euclidean_vector {
+		auto const recording = record(stats::operation::negate, dimensions_);
+		auto usable_data =
+		   std::span<double>(aligned_magnitudes(), gsl_lite::narrow_cast<unsigned int>(dimensions_));
+		// ||-v|| == ||v||, so the cached norm is still right
+		kernels::scale(-1.0, usable_data);
+		return std::move(*this);
 	}
 
 	auto euclidean_vector::operator+=(euclidean_vector const& oth) -> euclidean_vector& {
 		if (dimensions_ != oth.dimensions_) {
+			stats::count(stats::counter::dimension_mismatches);
 			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
 		}
+		auto const recording = record(stats::operation::add, dimensions_);
 		auto const dim_size = gsl_lite::narrow_cast<unsigned int>(dimensions_);
-		auto usable_data = std::span<double>(magnitudes_.get(), dim_size);
-		auto const oth_data = std::span<double>(oth.magnitudes_.get(), dim_size);
-		ranges::transform(usable_data, oth_data, usable_data.begin(), std::plus<>());
+		auto usable_data = std::span<double>(aligned_magnitudes(), dim_size);
+		auto const oth_data = std::span<double const>(oth.aligned_magnitudes(), dim_size);
+		kernels::axpy(1.0, oth_data, usable_data);
+		invalidate_norm();
 		return *this;
 	}
 	auto euclidean_vector::operator-=(euclidean_vector const& oth) -> euclidean_vector& {
-		return (*this) += (-oth);
+		if (dimensions_ != oth.dimensions_) {
+			stats::count(stats::counter::dimension_mismatches);
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		auto const recording = record(stats::operation::subtract, dimensions_);
+		auto const dim_size = gsl_lite::narrow_cast<unsigned int>(dimensions_);
+		auto usable_data = std::span<double>(aligned_magnitudes(), dim_size);
+		auto const oth_data = std::span<double const>(oth.aligned_magnitudes(), dim_size);
+		kernels::axpy(-1.0, oth_data, usable_data); // no negated temporary of oth
+		invalidate_norm();
+		return *this;
 	}
 	auto euclidean_vector::operator*=(double factor) noexcept -> euclidean_vector& {
+		auto const recording = record(stats::operation::multiply, dimensions_);
 		auto usable_data =
-		   std::span<double>(magnitudes_.get(), gsl_lite::narrow_cast<unsigned int>(dimensions_));
-		// usable_data = usable_data | views::transform([&factor](double& d) { return d * factor; });
-		ranges::transform(usable_data, usable_data.begin(), [&factor](double& d) { return d * factor; });
+		   std::span<double>(aligned_magnitudes(), gsl_lite::narrow_cast<unsigned int>(dimensions_));
+		kernels::scale(factor, usable_data);
+		// not rescaled by |factor|: a norm that overflowed or underflowed would stay wrong
+		invalidate_norm();
 		return *this;
 	}
 	auto euclidean_vector::operator/=(double dividend) -> euclidean_vector& {
 		if (dividend == 0) {
 			throw euclidean_vector_error("Invalid vector division by 0");
 		}
+		auto const recording = record(stats::operation::divide, dimensions_);
 		auto usable_data =
-		   std::span<double>(magnitudes_.get(), gsl_lite::narrow_cast<unsigned int>(dimensions_));
-		ranges::transform(usable_data, usable_data.begin(), [&dividend](double& d) {
-			return d / dividend;
-		});
-
+		   std::span<double>(aligned_magnitudes(), gsl_lite::narrow_cast<unsigned int>(dimensions_));
+		kernels::divide(dividend, usable_data);
+		invalidate_norm();
 		return *this;
 	}
-	euclidean_vector::operator std::vector<double>() const noexcept {
-		return std::span<double>(magnitudes_.get(), gsl_lite::narrow_cast<unsigned int>(dimensions_))
-		       | ranges::to<std::vector>;
+	euclidean_vector::operator std::vector<double>() const& noexcept {
+		return magnitudes() | ranges::to<std::vector>;
+	}
+	euclidean_vector::operator std::list<double>() const& noexcept {
+		return magnitudes() | ranges::to<std::list>;
 	}
-	euclidean_vector::operator std::list<double>() const noexcept {
-		return std::span<double>(magnitudes_.get(), gsl_lite::narrow_cast<unsigned int>(dimensions_))
-		       | ranges::to<std::list>;
+	euclidean_vector::operator std::vector<double>() && noexcept {
+		auto result = static_cast<std::vector<double>>(std::as_const(*this));
+		deallocate();
+		invalidate_norm();
+		return result;
+	}
+	euclidean_vector::operator std::list<double>() && noexcept {
+		auto result = static_cast<std::list<double>>(std::as_const(*this));
+		deallocate();
+		invalidate_norm();
+		return result;
 	}
 
 	//---------------------------------Member Functions--------------------------------------------
@@ -163,14 +397,97 @@ namespace comp6771 {
 		return magnitudes_[gsl_lite::narrow_cast<unsigned int>(index)];
 	}
 	auto euclidean_vector::at(int index) -> double& {
-		if (index < 0 or index > gsl_lite::narrow_cast<int>(dimensions_)) {
+		if (index < 0 or index >= gsl_lite::narrow_cast<int>(dimensions_)) {
 			throw euclidean_vector_error("Index X is not valid for this euclidean_vector object");
 		}
+		invalidate_norm();
 		return magnitudes_[gsl_lite::narrow_cast<unsigned int>(index)];
 	}
 	auto euclidean_vector::dimensions() const noexcept -> int {
 		return dimensions_;
 	}
+	auto euclidean_vector::get_allocator() const noexcept -> allocator_type {
+		return allocator_;
+	}
+	auto euclidean_vector::magnitudes() noexcept -> std::span<double> {
+		invalidate_norm();
+		return std::span<double>(aligned_magnitudes(),
+		                         gsl_lite::narrow_cast<std::size_t>(dimensions_));
+	}
+	auto euclidean_vector::magnitudes() const noexcept -> std::span<double const> {
+		return std::span<double const>(aligned_magnitudes(),
+		                               gsl_lite::narrow_cast<std::size_t>(dimensions_));
+	}
+	auto euclidean_vector::axpy(double alpha, euclidean_vector const& x) -> euclidean_vector& {
+		if (dimensions_ != x.dimensions_) {
+			stats::count(stats::counter::dimension_mismatches);
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		auto const recording = record(stats::operation::axpy, dimensions_);
+		kernels::axpy(alpha, x.magnitudes(), magnitudes());
+		return *this;
+	}
+	auto euclidean_vector::axpby(double alpha, euclidean_vector const& x, double beta)
+	   -> euclidean_vector& {
+		if (dimensions_ != x.dimensions_) {
+			stats::count(stats::counter::dimension_mismatches);
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		auto const recording = record(stats::operation::axpby, dimensions_);
+		kernels::axpby(alpha, x.magnitudes(), beta, magnitudes());
+		return *this;
+	}
+	auto euclidean_vector::lerp(euclidean_vector const& other, double t) -> euclidean_vector& {
+		if (dimensions_ != other.dimensions_) {
+			stats::count(stats::counter::dimension_mismatches);
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		auto const recording = record(stats::operation::lerp, dimensions_);
+		kernels::axpby(t, other.magnitudes(), 1.0 - t, magnitudes());
+		return *this;
+	}
+	auto euclidean_vector::normalize() -> euclidean_vector& {
+		if (dimensions_ == 0) {
+			throw euclidean_vector_error("euclidean_vector with no dimensions does not have a unit "
+			                             "vector");
+		}
+		auto const recording = record(stats::operation::normalize, dimensions_);
+		auto const norm = euclidean_norm(*this);
+		if (norm == 0) {
+			throw euclidean_vector_error("euclidean_vector with zero euclidean normal does not "
+			                             "have a unit vector");
+		}
+		// the same division as *this /= norm, so normalize() and unit() give the same bits; done
+		// here so that it's counted once, as a normalize
+		auto usable_data =
+		   std::span<double>(aligned_magnitudes(), gsl_lite::narrow_cast<unsigned int>(dimensions_));
+		kernels::divide(norm, usable_data);
+		invalidate_norm();
+		return *this;
+	}
+	auto euclidean_vector::scale_add(double alpha, double beta) noexcept -> euclidean_vector& {
+		auto const recording = record(stats::operation::scale_add, dimensions_);
+		kernels::scale_add(alpha, beta, magnitudes());
+		return *this;
+	}
+	auto euclidean_vector::hadamard(euclidean_vector const& x) -> euclidean_vector& {
+		if (dimensions_ != x.dimensions_) {
+			stats::count(stats::counter::dimension_mismatches);
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		auto const recording = record(stats::operation::hadamard, dimensions_);
+		kernels::multiply_elementwise(x.magnitudes(), magnitudes());
+		return *this;
+	}
+	auto euclidean_vector::divide(euclidean_vector const& x) -> euclidean_vector& {
+		if (dimensions_ != x.dimensions_) {
+			stats::count(stats::counter::dimension_mismatches);
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		auto const recording = record(stats::operation::divide_elementwise, dimensions_);
+		kernels::divide_elementwise(x.magnitudes(), magnitudes());
+		return *this;
+	}
 	//----------------------------------friends----------------------------------------------------
 	auto operator==(euclidean_vector const& lhs, euclidean_vector const& rhs) noexcept -> bool {
 		if (std::addressof(lhs) == std::addressof(rhs)) { // same object
@@ -180,8 +497,8 @@ namespace comp6771 {
 			return false;
 		}
 		auto const dim_size = gsl_lite::narrow_cast<unsigned int>(lhs.dimensions_);
-		auto const data_lhs = std::span<double>(lhs.magnitudes_.get(), dim_size);
-		auto const data_rhs = std::span<double>(rhs.magnitudes_.get(), dim_size);
+		auto const data_lhs = std::span<double>(lhs.aligned_magnitudes(), dim_size);
+		auto const data_rhs = std::span<double>(rhs.aligned_magnitudes(), dim_size);
 		auto const epsilon = euclidean_vector::epsilon;
 		return ranges::equal(data_lhs, data_rhs, [&epsilon](double const& l, double const& r) {
 			return std::abs(l - r) <= epsilon;
@@ -190,30 +507,12 @@ namespace comp6771 {
 	auto operator!=(euclidean_vector const& lhs, euclidean_vector const& rhs) noexcept -> bool {
 		return not(lhs == rhs);
 	}
-	auto operator+(euclidean_vector const& lhs, euclidean_vector const& rhs) -> euclidean_vector {
-		auto result = euclidean_vector(lhs);
-		result += rhs; // dimension not match exception can raise inside "+="
-		return result;
-	}
-	auto operator-(euclidean_vector const& lhs, euclidean_vector const& rhs) -> euclidean_vector {
-		return lhs + (-rhs);
-	}
-	auto operator*(euclidean_vector const& vec, double factor) noexcept -> euclidean_vector {
-		auto result = euclidean_vector(vec);
-		result *= factor;
-		return result;
-	}
-	auto operator/(euclidean_vector const& vec, double divident) -> euclidean_vector {
-		auto result = euclidean_vector(vec);
-		result /= divident;
-		return result;
-	}
 	auto operator<<(std::ostream& os, euclidean_vector const& vec) noexcept -> std::ostream& {
 		if (vec.dimensions() == 0) {
 			return os << "[]";
 		}
 		os << '[';
-		auto usable_data = std::span<double>(vec.magnitudes_.get(),
+		auto usable_data = std::span<double>(vec.aligned_magnitudes(),
 		                                     gsl_lite::narrow_cast<unsigned int>(vec.dimensions_));
 		// ranges::copy() doesn't work here
 		std::copy(usable_data.begin(), usable_data.end() - 1, std::ostream_iterator<double>(os, " "));
@@ -225,7 +524,15 @@ namespace comp6771 {
 		if (v.dimensions() == 0) {
 			throw euclidean_vector_error("euclidean_vector with no dimensions does not have a norm");
 		}
-		return std::sqrt(dot(v, v));
+		auto const cached = v.norm_cache_.load(std::memory_order_relaxed);
+		if (cached >= 0) {
+			stats::count(stats::counter::norm_cache_hits);
+			return cached;
+		}
+		auto const recording = record(stats::operation::euclidean_norm, v.dimensions_);
+		auto const norm = std::sqrt(kernels::squared_norm(v.magnitudes()));
+		v.norm_cache_.store(norm, std::memory_order_relaxed);
+		return norm;
 	}
 
 	auto unit(euclidean_vector const& v) -> euclidean_vector {
@@ -233,6 +540,7 @@ namespace comp6771 {
 			throw euclidean_vector_error("euclidean_vector with no dimensions does not have a unit "
 			                             "vector");
 		}
+		auto const recording = record(stats::operation::unit, v.dimensions_);
 		auto const norm = euclidean_norm(v);
 		if (norm == 0) {
 			throw euclidean_vector_error("euclidean_vector with zero euclidean normal does not "
@@ -243,15 +551,13 @@ namespace comp6771 {
 
 	auto dot(euclidean_vector const& x, euclidean_vector const& y) -> double {
 		if (x.dimensions() != y.dimensions()) {
+			stats::count(stats::counter::dimension_mismatches);
 			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
 		}
+		auto const recording = record(stats::operation::dot, x.dimensions_);
 		auto const dim_size = gsl_lite::narrow_cast<unsigned int>(x.dimensions_);
-		auto const x_data = std::span<double>(x.magnitudes_.get(), dim_size);
-		auto const y_data = std::span<double>(y.magnitudes_.get(), dim_size);
-
-		auto element_wise_mult = std::vector<double>(dim_size);
-		ranges::transform(x_data, y_data, element_wise_mult.begin(), std::multiplies<>());
-
-		return ranges::accumulate(element_wise_mult, 0);
+		auto const x_data = std::span<double const>(x.aligned_magnitudes(), dim_size);
+		auto const y_data = std::span<double const>(y.aligned_magnitudes(), dim_size);
+		return kernels::dot(x_data, y_data);
 	}
 } // namespace comp6771
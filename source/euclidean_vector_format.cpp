@@ -0,0 +1,144 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_format.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+namespace comp6771 {
+	namespace {
+		auto is_blank(char c) noexcept -> bool {
+			return c == ' ' or c == '\t' or c == '\r';
+		}
+
+		auto is_space(char c) noexcept -> bool {
+			return is_blank(c) or c == '\n' or c == '\f' or c == '\v';
+		}
+
+		// the separators that the formatter can write, other than a space
+		auto is_separator(char c) noexcept -> bool {
+			return c == ',' or c == ';' or c == '|';
+		}
+
+		// a magnitude's text runs up to the next separator or closing bracket
+		auto magnitude_end(char const* first, char const* last) noexcept -> char const* {
+			return std::find_if(first, last, [](char c) {
+				return is_space(c) or is_separator(c) or c == ']';
+			});
+		}
+
+		// Calls on_magnitude(first, last) for the text of each magnitude in a euclidean_vector,
+		// stopping at the first error it returns. Both passes of from_chars go through here, so
+		// they agree on where every magnitude is.
+		template<typename F>
+		auto for_each_magnitude(char const* first, char const* last, F on_magnitude)
+		   -> std::from_chars_result {
+			auto p = std::find_if_not(first, last, is_space);
+			if (p == last) {
+				return {first, std::errc::invalid_argument};
+			}
+			auto const bracketed = *p == '[';
+			auto const skip = bracketed ? is_space : is_blank;
+			if (bracketed) {
+				p = std::find_if_not(p + 1, last, is_space);
+				if (p != last and *p == ']') {
+					return {p + 1, std::errc()};
+				}
+			}
+			while (true) {
+				auto const end = magnitude_end(p, last);
+				if (end == p) {
+					return {p, std::errc::invalid_argument};
+				}
+				if (auto const ec = on_magnitude(p, end); ec != std::errc()) {
+					return {p, ec};
+				}
+				p = std::find_if_not(end, last, skip);
+				auto const comma = p != last and is_separator(*p);
+				if (comma) {
+					p = std::find_if_not(p + 1, last, skip);
+				}
+				if (not bracketed and not comma) {
+					return {end, std::errc()};
+				}
+				if (bracketed and p == last) {
+					return {p, std::errc::invalid_argument};
+				}
+				if (bracketed and *p == ']') {
+					return comma ? std::from_chars_result{p, std::errc::invalid_argument}
+					             : std::from_chars_result{p + 1, std::errc()};
+				}
+			}
+		}
+	} // namespace
+
+	auto to_chars(char* first,
+	              char* last,
+	              const_euclidean_vector_view v,
+	              text_format const& format) noexcept -> std::to_chars_result {
+		auto const too_large = std::to_chars_result{last, std::errc::value_too_large};
+		if (first == last) {
+			return too_large;
+		}
+		*first++ = '[';
+		auto separator = false;
+		for (auto const m : v.magnitudes()) {
+			if (std::exchange(separator, true)) {
+				if (first == last) {
+					return too_large;
+				}
+				*first++ = format.separator;
+			}
+			auto const result = detail::magnitude_to_chars(first, last, m, format);
+			if (result.ec != std::errc()) {
+				return too_large;
+			}
+			first = result.ptr;
+		}
+		if (first == last) {
+			return too_large;
+		}
+		*first++ = ']';
+		return {first, std::errc()};
+	}
+
+	auto from_chars(char const* first, char const* last, euclidean_vector& value)
+	   -> std::from_chars_result {
+		auto dimensions = 0;
+		auto const counted = for_each_magnitude(first, last, [&dimensions](char const*, char const*) {
+			++dimensions;
+			return std::errc();
+		});
+		if (counted.ec != std::errc()) {
+			return counted;
+		}
+
+		auto result = euclidean_vector(uninitialized, dimensions, value.get_allocator());
+		auto out = result.magnitudes().begin();
+		auto const parse = [&out](char const* begin, char const* end) {
+			auto const [ptr, ec] = std::from_chars(begin, end, *out++);
+			if (ec != std::errc()) {
+				return ec;
+			}
+			return ptr == end ? std::errc() : std::errc::invalid_argument;
+		};
+		auto const parsed = for_each_magnitude(first, last, parse);
+		if (parsed.ec == std::errc()) {
+			value = std::move(result);
+		}
+		return parsed;
+	}
+
+	auto parse_euclidean_vector(std::string_view text, euclidean_vector::allocator_type const& alloc)
+	   -> euclidean_vector {
+		auto result = euclidean_vector(alloc);
+		auto const last = text.data() + text.size();
+		auto const [ptr, ec] = from_chars(text.data(), last, result);
+		if (ec != std::errc() or std::find_if_not(ptr, last, is_space) != last) {
+			throw euclidean_vector_error("Text is not a valid euclidean_vector");
+		}
+		return result;
+	}
+} // namespace comp6771
@@ -0,0 +1,272 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_io.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace comp6771 {
+	namespace {
+		auto constexpr fnv_offset_basis = std::uint64_t{0xcbf2'9ce4'8422'2325};
+		auto constexpr fnv_prime = std::uint64_t{0x0000'0100'0000'01b3};
+
+		auto constexpr doubles_per_alignment = binary_header::alignment / sizeof(double);
+
+		// Vectors with no dimensions take up no payload, so a truncated stream can't expose a
+		// corrupt count of them; this bounds what reading one can allocate instead.
+		auto constexpr max_empty_vectors = std::uint64_t{1} << 20;
+
+		// continues a checksum over more of a payload
+		auto checksum(std::uint64_t hash, std::span<double const> payload) noexcept -> std::uint64_t {
+			for (auto const d : payload) {
+				hash = (hash ^ std::bit_cast<std::uint64_t>(d)) * fnv_prime;
+			}
+			return hash;
+		}
+
+		// zeros that pad a vector out to the stride
+		auto padding_of(std::uint64_t dimensions, std::uint64_t stride) noexcept
+		   -> std::span<double const> {
+			static auto constexpr zeros = std::array<double, doubles_per_alignment>{};
+			return std::span(zeros).first(static_cast<std::size_t>(stride - dimensions));
+		}
+
+		auto stride_for(std::uint64_t dimensions) noexcept -> std::uint64_t {
+			return (dimensions + doubles_per_alignment - 1) / doubles_per_alignment
+			       * doubles_per_alignment;
+		}
+
+		// everything about a header that can be checked without the payload
+		auto check_header(binary_header const& header) -> void {
+			if (header.magic != binary_header::expected_magic) {
+				throw euclidean_vector_error("Data is not in the euclidean_vector binary format");
+			}
+			if (header.byte_order != binary_header::expected_byte_order) {
+				throw euclidean_vector_error("euclidean_vector data was written with a different "
+				                             "byte order");
+			}
+			if (header.element_type != binary_element_type::float64
+			    or header.vector_alignment != binary_header::alignment
+			    or header.stride != stride_for(header.dimensions)
+			    or header.dimensions > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+				throw euclidean_vector_error("euclidean_vector data has an unsupported layout");
+			}
+		}
+
+		auto write_batch(std::ostream& os,
+		                 std::span<const_euclidean_vector_view const> vectors,
+		                 std::uint64_t dimensions) -> std::ostream& {
+			auto header = binary_header();
+			header.count = vectors.size();
+			header.dimensions = dimensions;
+			header.stride = stride_for(dimensions);
+			auto const padding = padding_of(header.dimensions, header.stride);
+			header.checksum = fnv_offset_basis;
+			for (auto const v : vectors) {
+				header.checksum = checksum(checksum(header.checksum, v.magnitudes()), padding);
+			}
+
+			os.write(reinterpret_cast<char const*>(&header), sizeof(header));
+			for (auto const v : vectors) {
+				auto const magnitudes = v.magnitudes();
+				os.write(reinterpret_cast<char const*>(magnitudes.data()),
+				         static_cast<std::streamsize>(magnitudes.size_bytes()));
+				os.write(reinterpret_cast<char const*>(padding.data()),
+				         static_cast<std::streamsize>(padding.size_bytes()));
+			}
+			return os;
+		}
+
+		auto read_exactly(std::istream& is, void* out, std::size_t bytes) -> void {
+			if (not is.read(static_cast<char*>(out), static_cast<std::streamsize>(bytes))) {
+				throw euclidean_vector_error("euclidean_vector data is truncated");
+			}
+		}
+
+		auto read_header(std::istream& is) -> binary_header {
+			auto header = binary_header();
+			read_exactly(is, &header, sizeof(header));
+			check_header(header);
+			return header;
+		}
+
+		[[noreturn]] auto throw_system_error(std::filesystem::path const& path) -> void {
+			throw std::system_error(errno, std::generic_category(), path.string());
+		}
+	} // namespace
+
+	auto binary_checksum(std::span<double const> payload) noexcept -> std::uint64_t {
+		return checksum(fnv_offset_basis, payload);
+	}
+
+	//---------------------------------streams-----------------------------------------------------
+	auto write_binary(std::ostream& os, const_euclidean_vector_view v) -> std::ostream& {
+		return write_batch(os, std::span(&v, 1), static_cast<std::uint64_t>(v.dimensions()));
+	}
+
+	auto write_binary(std::ostream& os, std::span<euclidean_vector const> vectors)
+	   -> std::ostream& {
+		auto const dimensions = vectors.empty() ? 0 : vectors.front().dimensions();
+		if (std::ranges::any_of(vectors, [dimensions](euclidean_vector const& v) {
+			    return v.dimensions() != dimensions;
+		    }))
+		{
+			throw euclidean_vector_error("euclidean_vectors in a batch must all have the same "
+			                             "dimensions");
+		}
+		auto const views = std::vector<const_euclidean_vector_view>(vectors.begin(), vectors.end());
+		return write_batch(os, views, static_cast<std::uint64_t>(dimensions));
+	}
+
+	auto read_binary(std::istream& is, euclidean_vector::allocator_type const& alloc)
+	   -> euclidean_vector {
+		auto result = read_binary_batch(is, alloc);
+		if (result.size() != 1) {
+			throw euclidean_vector_error("euclidean_vector data does not hold exactly one vector");
+		}
+		return std::move(result.front());
+	}
+
+	auto read_binary_batch(std::istream& is, euclidean_vector::allocator_type const& alloc)
+	   -> std::vector<euclidean_vector> {
+		auto const header = read_header(is);
+		if (header.dimensions == 0 and header.count > max_empty_vectors) {
+			throw euclidean_vector_error("euclidean_vector data holds too many vectors with no "
+			                             "dimensions");
+		}
+		auto const dimensions = static_cast<int>(header.dimensions);
+		auto padding = std::array<double, doubles_per_alignment>{};
+		auto const padding_size = static_cast<std::size_t>(header.stride - header.dimensions);
+		auto hash = fnv_offset_basis;
+		auto result = std::vector<euclidean_vector>();
+		// a corrupt count mustn't make us reserve terabytes before noticing the stream is short
+		result.reserve(static_cast<std::size_t>(std::min(header.count, max_empty_vectors)));
+		for (auto i = std::uint64_t{0}; i < header.count; ++i) {
+			auto& v = result.emplace_back(uninitialized, dimensions, alloc);
+			auto const magnitudes = v.magnitudes();
+			read_exactly(is, magnitudes.data(), magnitudes.size_bytes());
+			read_exactly(is, padding.data(), padding_size * sizeof(double));
+			hash = checksum(checksum(hash, magnitudes), std::span(padding).first(padding_size));
+		}
+		if (hash != header.checksum) {
+			throw euclidean_vector_error("euclidean_vector data does not match its checksum");
+		}
+		return result;
+	}
+
+	//-------------------------------mapped store--------------------------------------------------
+	mapped_euclidean_vectors::mapped_euclidean_vectors(std::filesystem::path const& path) {
+		auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd == -1) {
+			throw_system_error(path);
+		}
+		struct ::stat status = {};
+		if (::fstat(fd, &status) == -1) {
+			auto const error = errno;
+			::close(fd);
+			errno = error;
+			throw_system_error(path);
+		}
+		mapping_bytes_ = static_cast<std::size_t>(status.st_size);
+		if (mapping_bytes_ < sizeof(binary_header)) {
+			::close(fd);
+			throw euclidean_vector_error("euclidean_vector data is truncated");
+		}
+		mapping_ = ::mmap(nullptr, mapping_bytes_, PROT_READ, MAP_SHARED, fd, 0);
+		auto const error = errno;
+		// the mapping keeps the file open
+		::close(fd);
+		if (mapping_ == MAP_FAILED) {
+			mapping_ = nullptr;
+			errno = error;
+			throw_system_error(path);
+		}
+
+		try {
+			std::memcpy(&header_, mapping_, sizeof(header_));
+			check_header(header_);
+			// checked as a division, because a corrupt count could overflow the multiplication
+			auto const payload_doubles = (mapping_bytes_ - sizeof(header_)) / sizeof(double);
+			if (header_.stride != 0 and header_.count > payload_doubles / header_.stride) {
+				throw euclidean_vector_error("euclidean_vector data is truncated");
+			}
+		} catch (...) {
+			unmap();
+			throw;
+		}
+	}
+
+	mapped_euclidean_vectors::mapped_euclidean_vectors(mapped_euclidean_vectors&& orig) noexcept
+	: mapping_{std::exchange(orig.mapping_, nullptr)}
+	, mapping_bytes_{std::exchange(orig.mapping_bytes_, 0)}
+	, header_{std::exchange(orig.header_, binary_header())} {}
+
+	mapped_euclidean_vectors::~mapped_euclidean_vectors() {
+		unmap();
+	}
+
+	auto mapped_euclidean_vectors::operator=(mapped_euclidean_vectors&& oth) noexcept
+	   -> mapped_euclidean_vectors& {
+		if (this != &oth) {
+			unmap();
+			mapping_ = std::exchange(oth.mapping_, nullptr);
+			mapping_bytes_ = std::exchange(oth.mapping_bytes_, 0);
+			header_ = std::exchange(oth.header_, binary_header());
+		}
+		return *this;
+	}
+
+	auto mapped_euclidean_vectors::operator[](std::size_t i) const noexcept
+	   -> const_euclidean_vector_view {
+		auto const stride = static_cast<std::size_t>(header_.stride);
+		auto const dimensions = static_cast<std::size_t>(header_.dimensions);
+		return const_euclidean_vector_view(payload().subspan(i * stride, dimensions));
+	}
+
+	auto mapped_euclidean_vectors::at(std::size_t i) const -> const_euclidean_vector_view {
+		if (i >= size()) {
+			throw euclidean_vector_error("Index X is not valid for this euclidean_vector object");
+		}
+		return (*this)[i];
+	}
+
+	auto mapped_euclidean_vectors::size() const noexcept -> std::size_t {
+		return static_cast<std::size_t>(header_.count);
+	}
+
+	auto mapped_euclidean_vectors::dimensions() const noexcept -> int {
+		return static_cast<int>(header_.dimensions);
+	}
+
+	auto mapped_euclidean_vectors::verify() const noexcept -> bool {
+		return binary_checksum(payload()) == header_.checksum;
+	}
+
+	auto mapped_euclidean_vectors::payload() const noexcept -> std::span<double const> {
+		if (mapping_ == nullptr) {
+			return {};
+		}
+		auto const* first = static_cast<std::byte const*>(mapping_) + sizeof(header_);
+		return {reinterpret_cast<double const*>(first),
+		        static_cast<std::size_t>(header_.count * header_.stride)};
+	}
+
+	auto mapped_euclidean_vectors::unmap() noexcept -> void {
+		if (mapping_ != nullptr) {
+			::munmap(mapping_, mapping_bytes_);
+			mapping_ = nullptr;
+			mapping_bytes_ = 0;
+		}
+	}
+} // namespace comp6771
@@ -0,0 +1,1920 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// The SIMD paths rely on GCC/Clang function multiversioning (per-function target attributes and
+// __builtin_cpu_supports), so the rest of the library is still built for the baseline ISA.
+#if defined(__x86_64__) and (defined(__GNUC__) or defined(__clang__))
+#	define COMP6771_HAS_X86_KERNELS 1
+#	include <immintrin.h>
+#	define COMP6771_TARGET(isa) __attribute__((target(isa)))
+#else
+#	define COMP6771_HAS_X86_KERNELS 0
+#endif
+
+namespace comp6771::kernels {
+	namespace {
+		//---------------------------reproducible reductions-----------------------------------
+		// reduction::blocked, pairwise and compensated always use 32 lanes, whatever the
+		// instruction set: element i goes to lane i % 32, and the lanes are combined in a fixed
+		// order. Each width below instantiates the same code, which the compiler lowers to one
+		// AVX-512 instruction, two AVX2 instructions or four SSE2 instructions per group of
+		// eight lanes, so every width gives the same bits. (This is also why this file is
+		// compiled with -ffp-contract=off: a fused multiply-add rounds differently.)
+		using lanes = double __attribute__((vector_size(8 * sizeof(double))));
+		// Passing lanes by value would have a different ABI with and without AVX-512, but the
+		// helpers that do are internal and always inlined, so there's no ABI to disagree on.
+#if defined(__GNUC__) and not defined(__clang__)
+#	pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+		auto constexpr lane_count = std::size_t{8};
+		auto constexpr accumulators = std::size_t{4};
+
+		[[gnu::always_inline]] inline auto load(double const* p) noexcept -> lanes {
+			auto result = lanes{};
+			std::memcpy(&result, p, sizeof(result));
+			return result;
+		}
+
+		// the last n < 8 elements, with the other lanes zero
+		[[gnu::always_inline]] inline auto load_partial(double const* p, std::size_t n) noexcept
+		   -> lanes {
+			auto result = lanes{};
+			std::memcpy(&result, p, n * sizeof(double));
+			return result;
+		}
+
+		[[gnu::always_inline]] inline auto
+		combine(std::array<lanes, accumulators> const& acc) noexcept -> double {
+			auto const v = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+			return ((v[0] + v[4]) + (v[2] + v[6])) + ((v[1] + v[5]) + (v[3] + v[7]));
+		}
+
+		[[gnu::always_inline]] inline auto blocked_dot_lanes(std::span<double const> x,
+		                                                     std::span<double const> y) noexcept
+		   -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto acc = std::array<lanes, accumulators>{};
+			auto i = std::size_t{0};
+			for (; i + accumulators * lane_count <= n; i += accumulators * lane_count) {
+				for (auto a = std::size_t{0}; a < accumulators; ++a) {
+					auto const k = i + a * lane_count;
+					acc[a] += load(xp + k) * load(yp + k);
+				}
+			}
+			auto a = std::size_t{0};
+			for (; i + lane_count <= n; i += lane_count, ++a) {
+				acc[a] += load(xp + i) * load(yp + i);
+			}
+			acc[a % accumulators] += load_partial(xp + i, n - i) * load_partial(yp + i, n - i);
+			return combine(acc);
+		}
+
+		// Sums blocks of pairwise_block_size left to right, keeping a binary counter of finished
+		// subtrees: whenever two subtrees cover the same number of blocks they're merged. What's
+		// left at the end is merged right to left, which is the same tree as recursively
+		// splitting n at the largest power-of-two number of blocks below it.
+		[[gnu::always_inline]] inline auto pairwise_dot_lanes(std::span<double const> x,
+		                                                      std::span<double const> y) noexcept
+		   -> double {
+			auto subtrees = std::array<double, 64>{};
+			auto top = std::size_t{0};
+			auto blocks = std::size_t{0};
+			for (auto first = std::size_t{0}; first < x.size(); first += pairwise_block_size) {
+				auto const size = std::min(pairwise_block_size, x.size() - first);
+				auto sum = blocked_dot_lanes(x.subspan(first, size), y.subspan(first, size));
+				for (auto b = blocks; (b & 1U) != 0; b >>= 1U) {
+					sum = subtrees[--top] + sum;
+				}
+				subtrees[top++] = sum;
+				++blocks;
+			}
+			auto total = 0.0;
+			if (top != 0) {
+				total = subtrees[--top];
+				while (top != 0) {
+					total = subtrees[--top] + total;
+				}
+			}
+			return total;
+		}
+
+		// Knuth's TwoSum: sum += value exactly, with the rounding error added to error. Unlike
+		// Kahan's or Neumaier's formulation it has no branch, so it vectorises.
+		[[gnu::always_inline]] inline auto two_sum(lanes& sum, lanes& error, lanes value) noexcept
+		   -> void {
+			auto const t = sum + value;
+			auto const z = t - sum;
+			error += (sum - (t - z)) + (value - z);
+			sum = t;
+		}
+
+		[[gnu::always_inline]] inline auto two_sum(double& sum, double& error, double value) noexcept
+		   -> void {
+			auto const t = sum + value;
+			auto const z = t - sum;
+			error += (sum - (t - z)) + (value - z);
+			sum = t;
+		}
+
+		[[gnu::always_inline]] inline auto compensated_dot_lanes(std::span<double const> x,
+		                                                         std::span<double const> y) noexcept
+		   -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto sum = std::array<lanes, accumulators>{};
+			auto error = std::array<lanes, accumulators>{};
+			auto i = std::size_t{0};
+			for (; i + accumulators * lane_count <= n; i += accumulators * lane_count) {
+				for (auto a = std::size_t{0}; a < accumulators; ++a) {
+					auto const k = i + a * lane_count;
+					two_sum(sum[a], error[a], load(xp + k) * load(yp + k));
+				}
+			}
+			auto a = std::size_t{0};
+			for (; i + lane_count <= n; i += lane_count, ++a) {
+				two_sum(sum[a], error[a], load(xp + i) * load(yp + i));
+			}
+			two_sum(sum[a % accumulators],
+			        error[a % accumulators],
+			        load_partial(xp + i, n - i) * load_partial(yp + i, n - i));
+
+			// the 32 lane sums are added with TwoSum too, in lane order
+			auto total = 0.0;
+			auto total_error = combine(error);
+			for (auto const& s : sum) {
+				for (auto lane = std::size_t{0}; lane < lane_count; ++lane) {
+					two_sum(total, total_error, s[lane]);
+				}
+			}
+			return total + total_error;
+		}
+
+		//-----------------------------------scalar--------------------------------------------
+		// Four independent accumulators break the loop-carried dependency on a single sum, which
+		// is what limits a naive reduction to one add per FP-add latency.
+		auto dot_scalar(std::span<double const> x, std::span<double const> y) noexcept -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				s0 += xp[i] * yp[i];
+				s1 += xp[i + 1] * yp[i + 1];
+				s2 += xp[i + 2] * yp[i + 2];
+				s3 += xp[i + 3] * yp[i + 3];
+			}
+			for (; i < n; ++i) {
+				s0 += xp[i] * yp[i];
+			}
+			return (s0 + s1) + (s2 + s3);
+		}
+
+		auto squared_norm_scalar(std::span<double const> x) noexcept -> double {
+			return dot_scalar(x, x);
+		}
+
+		auto squared_distance_scalar(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				auto const d0 = xp[i] - yp[i];
+				auto const d1 = xp[i + 1] - yp[i + 1];
+				auto const d2 = xp[i + 2] - yp[i + 2];
+				auto const d3 = xp[i + 3] - yp[i + 3];
+				s0 += d0 * d0;
+				s1 += d1 * d1;
+				s2 += d2 * d2;
+				s3 += d3 * d3;
+			}
+			for (; i < n; ++i) {
+				auto const d = xp[i] - yp[i];
+				s0 += d * d;
+			}
+			return (s0 + s1) + (s2 + s3);
+		}
+
+		auto manhattan_distance_scalar(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				s0 += std::abs(xp[i] - yp[i]);
+				s1 += std::abs(xp[i + 1] - yp[i + 1]);
+				s2 += std::abs(xp[i + 2] - yp[i + 2]);
+				s3 += std::abs(xp[i + 3] - yp[i + 3]);
+			}
+			for (; i < n; ++i) {
+				s0 += std::abs(xp[i] - yp[i]);
+			}
+			return (s0 + s1) + (s2 + s3);
+		}
+
+		// Two sets of accumulators for the three sums, which keeps the loop from being bound by
+		// the latency of any one of them.
+		auto cosine_scalar(std::span<double const> x, std::span<double const> y) noexcept
+		   -> cosine_terms {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			double xy0 = 0, xy1 = 0, xx0 = 0, xx1 = 0, yy0 = 0, yy1 = 0;
+			auto i = std::size_t{0};
+			for (; i + 2 <= n; i += 2) {
+				xy0 += xp[i] * yp[i];
+				xx0 += xp[i] * xp[i];
+				yy0 += yp[i] * yp[i];
+				xy1 += xp[i + 1] * yp[i + 1];
+				xx1 += xp[i + 1] * xp[i + 1];
+				yy1 += yp[i + 1] * yp[i + 1];
+			}
+			for (; i < n; ++i) {
+				xy0 += xp[i] * yp[i];
+				xx0 += xp[i] * xp[i];
+				yy0 += yp[i] * yp[i];
+			}
+			return {xy0 + xy1, xx0 + xx1, yy0 + yy1};
+		}
+
+		// Each x[i] is loaded once and used for four rows, with one accumulator per row.
+		auto dot4_scalar(std::span<double const> x,
+		                 double const* y,
+		                 std::size_t stride,
+		                 std::span<double, 4> result) noexcept -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* y0 = y;
+			auto const* y1 = y0 + stride;
+			auto const* y2 = y1 + stride;
+			auto const* y3 = y2 + stride;
+			double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				auto const xi = xp[i];
+				s0 += xi * y0[i];
+				s1 += xi * y1[i];
+				s2 += xi * y2[i];
+				s3 += xi * y3[i];
+			}
+			result[0] += s0;
+			result[1] += s1;
+			result[2] += s2;
+			result[3] += s3;
+		}
+
+		auto axpy_scalar(double alpha, std::span<double const> x, std::span<double> y) noexcept
+		   -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				yp[i] += alpha * xp[i];
+			}
+		}
+
+		auto scale_scalar(double alpha, std::span<double> x) noexcept -> void {
+			for (auto& d : x) {
+				d *= alpha;
+			}
+		}
+
+		auto divide_scalar(double divisor, std::span<double> x) noexcept -> void {
+			for (auto& d : x) {
+				d /= divisor;
+			}
+		}
+
+		auto axpby_scalar(double alpha,
+		                  std::span<double const> x,
+		                  double beta,
+		                  std::span<double> y) noexcept -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				yp[i] = alpha * xp[i] + beta * yp[i];
+			}
+		}
+
+		auto scale_add_scalar(double alpha, double beta, std::span<double> x) noexcept -> void {
+			for (auto& d : x) {
+				d = std::fma(d, alpha, beta);
+			}
+		}
+
+		auto multiply_elementwise_scalar(std::span<double const> x, std::span<double> y) noexcept
+		   -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				yp[i] *= xp[i];
+			}
+		}
+
+		auto divide_elementwise_scalar(std::span<double const> x, std::span<double> y) noexcept
+		   -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				yp[i] /= xp[i];
+			}
+		}
+
+		auto blocked_dot_scalar(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			return blocked_dot_lanes(x, y);
+		}
+
+		auto pairwise_dot_scalar(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			return pairwise_dot_lanes(x, y);
+		}
+
+		auto compensated_dot_scalar(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			return compensated_dot_lanes(x, y);
+		}
+
+		//---------------------------reduced precision storage---------------------------------
+		// The int8 kernels sum products in 32-bit integer lanes, which would overflow after about
+		// a million elements, so they move the lanes into a 64-bit total after every block of
+		// this many elements.
+		auto constexpr int8_block = std::size_t{1} << 16;
+
+		// every float and bfloat16 is exactly representable as a double
+		template<typename T>
+		[[gnu::always_inline]] inline auto widen(T value) noexcept -> double {
+			return static_cast<double>(static_cast<float>(value));
+		}
+
+		template<typename T>
+		auto widening_dot_scalar(std::span<T const> x, std::span<T const> y) noexcept -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				s0 += widen(xp[i]) * widen(yp[i]);
+				s1 += widen(xp[i + 1]) * widen(yp[i + 1]);
+				s2 += widen(xp[i + 2]) * widen(yp[i + 2]);
+				s3 += widen(xp[i + 3]) * widen(yp[i + 3]);
+			}
+			for (; i < n; ++i) {
+				s0 += widen(xp[i]) * widen(yp[i]);
+			}
+			return (s0 + s1) + (s2 + s3);
+		}
+
+		auto int8_dot_scalar(std::span<std::int8_t const> x, std::span<std::int8_t const> y) noexcept
+		   -> std::int64_t {
+			auto sum = std::int64_t{0};
+			for (auto i = std::size_t{0}; i < x.size(); ++i) {
+				sum += x[i] * y[i];
+			}
+			return sum;
+		}
+
+		template<typename T, std::size_t N>
+		auto sum_lanes(std::array<T, N> const& partial) noexcept -> std::int64_t {
+			auto sum = std::int64_t{0};
+			for (auto const lane : partial) {
+				sum += lane;
+			}
+			return sum;
+		}
+
+		auto const scalar_table = kernel_table{
+		   dot_scalar,
+		   blocked_dot_scalar,
+		   pairwise_dot_scalar,
+		   compensated_dot_scalar,
+		   dot4_scalar,
+		   squared_norm_scalar,
+		   axpy_scalar,
+		   scale_scalar,
+		   divide_scalar,
+		   widening_dot_scalar<float>,
+		   widening_dot_scalar<bfloat16>,
+		   int8_dot_scalar,
+		   squared_distance_scalar,
+		   manhattan_distance_scalar,
+		   cosine_scalar,
+		   axpby_scalar,
+		   scale_add_scalar,
+		   multiply_elementwise_scalar,
+		   divide_elementwise_scalar,
+		};
+
+#if COMP6771_HAS_X86_KERNELS
+		//-----------------------------------SSE2----------------------------------------------
+		COMP6771_TARGET("sse2") auto hsum(__m128d v) noexcept -> double {
+			return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+		}
+
+		COMP6771_TARGET("sse2")
+		auto dot_sse2(std::span<double const> x, std::span<double const> y) noexcept -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto s0 = _mm_setzero_pd();
+			auto s1 = _mm_setzero_pd();
+			auto s2 = _mm_setzero_pd();
+			auto s3 = _mm_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(xp + i), _mm_loadu_pd(yp + i)));
+				s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(xp + i + 2), _mm_loadu_pd(yp + i + 2)));
+				s2 = _mm_add_pd(s2, _mm_mul_pd(_mm_loadu_pd(xp + i + 4), _mm_loadu_pd(yp + i + 4)));
+				s3 = _mm_add_pd(s3, _mm_mul_pd(_mm_loadu_pd(xp + i + 6), _mm_loadu_pd(yp + i + 6)));
+			}
+			auto sum = hsum(_mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3)));
+			for (; i < n; ++i) {
+				sum += xp[i] * yp[i];
+			}
+			return sum;
+		}
+
+		COMP6771_TARGET("sse2")
+		auto dot4_sse2(std::span<double const> x,
+		               double const* y,
+		               std::size_t stride,
+		               std::span<double, 4> result) noexcept -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* y0 = y;
+			auto const* y1 = y0 + stride;
+			auto const* y2 = y1 + stride;
+			auto const* y3 = y2 + stride;
+			auto s0 = _mm_setzero_pd();
+			auto s1 = _mm_setzero_pd();
+			auto s2 = _mm_setzero_pd();
+			auto s3 = _mm_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 2 <= n; i += 2) {
+				auto const xi = _mm_loadu_pd(xp + i);
+				s0 = _mm_add_pd(s0, _mm_mul_pd(xi, _mm_loadu_pd(y0 + i)));
+				s1 = _mm_add_pd(s1, _mm_mul_pd(xi, _mm_loadu_pd(y1 + i)));
+				s2 = _mm_add_pd(s2, _mm_mul_pd(xi, _mm_loadu_pd(y2 + i)));
+				s3 = _mm_add_pd(s3, _mm_mul_pd(xi, _mm_loadu_pd(y3 + i)));
+			}
+			auto r0 = hsum(s0);
+			auto r1 = hsum(s1);
+			auto r2 = hsum(s2);
+			auto r3 = hsum(s3);
+			for (; i < n; ++i) {
+				r0 += xp[i] * y0[i];
+				r1 += xp[i] * y1[i];
+				r2 += xp[i] * y2[i];
+				r3 += xp[i] * y3[i];
+			}
+			result[0] += r0;
+			result[1] += r1;
+			result[2] += r2;
+			result[3] += r3;
+		}
+
+		COMP6771_TARGET("sse2") auto squared_norm_sse2(std::span<double const> x) noexcept -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto s0 = _mm_setzero_pd();
+			auto s1 = _mm_setzero_pd();
+			auto s2 = _mm_setzero_pd();
+			auto s3 = _mm_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const v0 = _mm_loadu_pd(xp + i);
+				auto const v1 = _mm_loadu_pd(xp + i + 2);
+				auto const v2 = _mm_loadu_pd(xp + i + 4);
+				auto const v3 = _mm_loadu_pd(xp + i + 6);
+				s0 = _mm_add_pd(s0, _mm_mul_pd(v0, v0));
+				s1 = _mm_add_pd(s1, _mm_mul_pd(v1, v1));
+				s2 = _mm_add_pd(s2, _mm_mul_pd(v2, v2));
+				s3 = _mm_add_pd(s3, _mm_mul_pd(v3, v3));
+			}
+			auto sum = hsum(_mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3)));
+			for (; i < n; ++i) {
+				sum += xp[i] * xp[i];
+			}
+			return sum;
+		}
+
+		COMP6771_TARGET("sse2")
+		auto squared_distance_sse2(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto s0 = _mm_setzero_pd();
+			auto s1 = _mm_setzero_pd();
+			auto s2 = _mm_setzero_pd();
+			auto s3 = _mm_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const d0 = _mm_sub_pd(_mm_loadu_pd(xp + i), _mm_loadu_pd(yp + i));
+				auto const d1 = _mm_sub_pd(_mm_loadu_pd(xp + i + 2), _mm_loadu_pd(yp + i + 2));
+				auto const d2 = _mm_sub_pd(_mm_loadu_pd(xp + i + 4), _mm_loadu_pd(yp + i + 4));
+				auto const d3 = _mm_sub_pd(_mm_loadu_pd(xp + i + 6), _mm_loadu_pd(yp + i + 6));
+				s0 = _mm_add_pd(s0, _mm_mul_pd(d0, d0));
+				s1 = _mm_add_pd(s1, _mm_mul_pd(d1, d1));
+				s2 = _mm_add_pd(s2, _mm_mul_pd(d2, d2));
+				s3 = _mm_add_pd(s3, _mm_mul_pd(d3, d3));
+			}
+			auto sum = hsum(_mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3)));
+			for (; i < n; ++i) {
+				auto const d = xp[i] - yp[i];
+				sum += d * d;
+			}
+			return sum;
+		}
+
+		COMP6771_TARGET("sse2")
+		auto manhattan_distance_sse2(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			// clearing the sign bit is the absolute value
+			auto const sign = _mm_set1_pd(-0.0);
+			auto s0 = _mm_setzero_pd();
+			auto s1 = _mm_setzero_pd();
+			auto s2 = _mm_setzero_pd();
+			auto s3 = _mm_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const d0 = _mm_sub_pd(_mm_loadu_pd(xp + i), _mm_loadu_pd(yp + i));
+				auto const d1 = _mm_sub_pd(_mm_loadu_pd(xp + i + 2), _mm_loadu_pd(yp + i + 2));
+				auto const d2 = _mm_sub_pd(_mm_loadu_pd(xp + i + 4), _mm_loadu_pd(yp + i + 4));
+				auto const d3 = _mm_sub_pd(_mm_loadu_pd(xp + i + 6), _mm_loadu_pd(yp + i + 6));
+				s0 = _mm_add_pd(s0, _mm_andnot_pd(sign, d0));
+				s1 = _mm_add_pd(s1, _mm_andnot_pd(sign, d1));
+				s2 = _mm_add_pd(s2, _mm_andnot_pd(sign, d2));
+				s3 = _mm_add_pd(s3, _mm_andnot_pd(sign, d3));
+			}
+			auto sum = hsum(_mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3)));
+			for (; i < n; ++i) {
+				sum += std::abs(xp[i] - yp[i]);
+			}
+			return sum;
+		}
+
+		COMP6771_TARGET("sse2")
+		auto cosine_sse2(std::span<double const> x, std::span<double const> y) noexcept
+		   -> cosine_terms {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto xy0 = _mm_setzero_pd();
+			auto xy1 = _mm_setzero_pd();
+			auto xx0 = _mm_setzero_pd();
+			auto xx1 = _mm_setzero_pd();
+			auto yy0 = _mm_setzero_pd();
+			auto yy1 = _mm_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				auto const x0 = _mm_loadu_pd(xp + i);
+				auto const x1 = _mm_loadu_pd(xp + i + 2);
+				auto const y0 = _mm_loadu_pd(yp + i);
+				auto const y1 = _mm_loadu_pd(yp + i + 2);
+				xy0 = _mm_add_pd(xy0, _mm_mul_pd(x0, y0));
+				xy1 = _mm_add_pd(xy1, _mm_mul_pd(x1, y1));
+				xx0 = _mm_add_pd(xx0, _mm_mul_pd(x0, x0));
+				xx1 = _mm_add_pd(xx1, _mm_mul_pd(x1, x1));
+				yy0 = _mm_add_pd(yy0, _mm_mul_pd(y0, y0));
+				yy1 = _mm_add_pd(yy1, _mm_mul_pd(y1, y1));
+			}
+			auto result = cosine_terms{hsum(_mm_add_pd(xy0, xy1)),
+			                           hsum(_mm_add_pd(xx0, xx1)),
+			                           hsum(_mm_add_pd(yy0, yy1))};
+			for (; i < n; ++i) {
+				result.dot += xp[i] * yp[i];
+				result.x_squared_norm += xp[i] * xp[i];
+				result.y_squared_norm += yp[i] * yp[i];
+			}
+			return result;
+		}
+
+		COMP6771_TARGET("sse2")
+		auto axpy_sse2(double alpha, std::span<double const> x, std::span<double> y) noexcept
+		   -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			auto const a = _mm_set1_pd(alpha);
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				auto const r0 = _mm_add_pd(_mm_loadu_pd(yp + i), _mm_mul_pd(a, _mm_loadu_pd(xp + i)));
+				auto const r1 =
+				   _mm_add_pd(_mm_loadu_pd(yp + i + 2), _mm_mul_pd(a, _mm_loadu_pd(xp + i + 2)));
+				_mm_storeu_pd(yp + i, r0);
+				_mm_storeu_pd(yp + i + 2, r1);
+			}
+			for (; i < n; ++i) {
+				yp[i] += alpha * xp[i];
+			}
+		}
+
+		COMP6771_TARGET("sse2") auto scale_sse2(double alpha, std::span<double> x) noexcept -> void {
+			auto const n = x.size();
+			auto* xp = x.data();
+			auto const a = _mm_set1_pd(alpha);
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				_mm_storeu_pd(xp + i, _mm_mul_pd(_mm_loadu_pd(xp + i), a));
+				_mm_storeu_pd(xp + i + 2, _mm_mul_pd(_mm_loadu_pd(xp + i + 2), a));
+			}
+			for (; i < n; ++i) {
+				xp[i] *= alpha;
+			}
+		}
+
+		COMP6771_TARGET("sse2")
+		auto divide_sse2(double divisor, std::span<double> x) noexcept -> void {
+			auto const n = x.size();
+			auto* xp = x.data();
+			auto const d = _mm_set1_pd(divisor);
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				_mm_storeu_pd(xp + i, _mm_div_pd(_mm_loadu_pd(xp + i), d));
+				_mm_storeu_pd(xp + i + 2, _mm_div_pd(_mm_loadu_pd(xp + i + 2), d));
+			}
+			for (; i < n; ++i) {
+				xp[i] /= divisor;
+			}
+		}
+
+		COMP6771_TARGET("sse2")
+		auto axpby_sse2(double alpha,
+		                std::span<double const> x,
+		                double beta,
+		                std::span<double> y) noexcept -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			auto const a = _mm_set1_pd(alpha);
+			auto const b = _mm_set1_pd(beta);
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				auto const r0 = _mm_add_pd(_mm_mul_pd(a, _mm_loadu_pd(xp + i)),
+				                           _mm_mul_pd(b, _mm_loadu_pd(yp + i)));
+				auto const r1 = _mm_add_pd(_mm_mul_pd(a, _mm_loadu_pd(xp + i + 2)),
+				                           _mm_mul_pd(b, _mm_loadu_pd(yp + i + 2)));
+				_mm_storeu_pd(yp + i, r0);
+				_mm_storeu_pd(yp + i + 2, r1);
+			}
+			for (; i < n; ++i) {
+				yp[i] = alpha * xp[i] + beta * yp[i];
+			}
+		}
+
+		// SSE2 has no FMA instruction, so this is std::fma one element at a time: slower than a
+		// multiply and an add, but rounded once like the AVX2 and AVX-512 kernels
+		COMP6771_TARGET("sse2")
+		auto scale_add_sse2(double alpha, double beta, std::span<double> x) noexcept -> void {
+			for (auto& d : x) {
+				d = std::fma(d, alpha, beta);
+			}
+		}
+
+		COMP6771_TARGET("sse2")
+		auto multiply_elementwise_sse2(std::span<double const> x, std::span<double> y) noexcept
+		   -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				auto const r0 = _mm_mul_pd(_mm_loadu_pd(yp + i), _mm_loadu_pd(xp + i));
+				auto const r1 = _mm_mul_pd(_mm_loadu_pd(yp + i + 2), _mm_loadu_pd(xp + i + 2));
+				_mm_storeu_pd(yp + i, r0);
+				_mm_storeu_pd(yp + i + 2, r1);
+			}
+			for (; i < n; ++i) {
+				yp[i] *= xp[i];
+			}
+		}
+
+		COMP6771_TARGET("sse2")
+		auto divide_elementwise_sse2(std::span<double const> x, std::span<double> y) noexcept
+		   -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				auto const r0 = _mm_div_pd(_mm_loadu_pd(yp + i), _mm_loadu_pd(xp + i));
+				auto const r1 = _mm_div_pd(_mm_loadu_pd(yp + i + 2), _mm_loadu_pd(xp + i + 2));
+				_mm_storeu_pd(yp + i, r0);
+				_mm_storeu_pd(yp + i + 2, r1);
+			}
+			for (; i < n; ++i) {
+				yp[i] /= xp[i];
+			}
+		}
+
+		COMP6771_TARGET("sse2")
+		auto blocked_dot_sse2(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			return blocked_dot_lanes(x, y);
+		}
+
+		COMP6771_TARGET("sse2")
+		auto pairwise_dot_sse2(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			return pairwise_dot_lanes(x, y);
+		}
+
+		COMP6771_TARGET("sse2")
+		auto compensated_dot_sse2(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			return compensated_dot_lanes(x, y);
+		}
+
+		// four elements, widened to float
+		COMP6771_TARGET("sse2") auto load4_ps(float const* p) noexcept -> __m128 {
+			return _mm_loadu_ps(p);
+		}
+
+		// a bfloat16 is the top half of a float, so interleaving it with zeros widens it
+		COMP6771_TARGET("sse2") auto load4_ps(bfloat16 const* p) noexcept -> __m128 {
+			auto const bits = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(p));
+			return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), bits));
+		}
+
+		template<typename T>
+		COMP6771_TARGET("sse2")
+		auto widening_dot_sse2(std::span<T const> x, std::span<T const> y) noexcept -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto s0 = _mm_setzero_pd();
+			auto s1 = _mm_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				auto const xf = load4_ps(xp + i);
+				auto const yf = load4_ps(yp + i);
+				s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_cvtps_pd(xf), _mm_cvtps_pd(yf)));
+				s1 = _mm_add_pd(s1,
+				                _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(xf, xf)),
+				                           _mm_cvtps_pd(_mm_movehl_ps(yf, yf))));
+			}
+			auto sum = hsum(_mm_add_pd(s0, s1));
+			for (; i < n; ++i) {
+				sum += widen(xp[i]) * widen(yp[i]);
+			}
+			return sum;
+		}
+
+		// SSE2 has no sign extension, but an arithmetic shift right of each byte duplicated into
+		// both halves of a 16-bit lane does the same thing
+		COMP6771_TARGET("sse2")
+		auto int8_dot_sse2(std::span<std::int8_t const> x, std::span<std::int8_t const> y) noexcept
+		   -> std::int64_t {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto sum = std::int64_t{0};
+			auto i = std::size_t{0};
+			while (i + 16 <= n) {
+				auto const block_end = std::min(n, i + int8_block);
+				auto acc = _mm_setzero_si128();
+				for (; i + 16 <= block_end; i += 16) {
+					auto const xb = _mm_loadu_si128(reinterpret_cast<__m128i const*>(xp + i));
+					auto const yb = _mm_loadu_si128(reinterpret_cast<__m128i const*>(yp + i));
+					auto const lo = _mm_madd_epi16(_mm_srai_epi16(_mm_unpacklo_epi8(xb, xb), 8),
+					                               _mm_srai_epi16(_mm_unpacklo_epi8(yb, yb), 8));
+					auto const hi = _mm_madd_epi16(_mm_srai_epi16(_mm_unpackhi_epi8(xb, xb), 8),
+					                               _mm_srai_epi16(_mm_unpackhi_epi8(yb, yb), 8));
+					acc = _mm_add_epi32(acc, _mm_add_epi32(lo, hi));
+				}
+				auto partial = std::array<std::int32_t, 4>{};
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(partial.data()), acc);
+				sum += sum_lanes(partial);
+			}
+			for (; i < n; ++i) {
+				sum += xp[i] * yp[i];
+			}
+			return sum;
+		}
+
+		auto const sse2_table = kernel_table{
+		   dot_sse2,
+		   blocked_dot_sse2,
+		   pairwise_dot_sse2,
+		   compensated_dot_sse2,
+		   dot4_sse2,
+		   squared_norm_sse2,
+		   axpy_sse2,
+		   scale_sse2,
+		   divide_sse2,
+		   widening_dot_sse2<float>,
+		   widening_dot_sse2<bfloat16>,
+		   int8_dot_sse2,
+		   squared_distance_sse2,
+		   manhattan_distance_sse2,
+		   cosine_sse2,
+		   axpby_sse2,
+		   scale_add_sse2,
+		   multiply_elementwise_sse2,
+		   divide_elementwise_sse2,
+		};
+
+		//-----------------------------------AVX2----------------------------------------------
+		COMP6771_TARGET("avx2,fma") auto hsum(__m256d v) noexcept -> double {
+			auto const pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+			return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+		}
+
+		COMP6771_TARGET("avx2,fma")
+		auto dot_avx2(std::span<double const> x, std::span<double const> y) noexcept -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto s0 = _mm256_setzero_pd();
+			auto s1 = _mm256_setzero_pd();
+			auto s2 = _mm256_setzero_pd();
+			auto s3 = _mm256_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				s0 = _mm256_fmadd_pd(_mm256_loadu_pd(xp + i), _mm256_loadu_pd(yp + i), s0);
+				s1 = _mm256_fmadd_pd(_mm256_loadu_pd(xp + i + 4), _mm256_loadu_pd(yp + i + 4), s1);
+				s2 = _mm256_fmadd_pd(_mm256_loadu_pd(xp + i + 8), _mm256_loadu_pd(yp + i + 8), s2);
+				s3 = _mm256_fmadd_pd(_mm256_loadu_pd(xp + i + 12), _mm256_loadu_pd(yp + i + 12), s3);
+			}
+			for (; i + 4 <= n; i += 4) {
+				s0 = _mm256_fmadd_pd(_mm256_loadu_pd(xp + i), _mm256_loadu_pd(yp + i), s0);
+			}
+			auto sum = hsum(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+			for (; i < n; ++i) {
+				sum += xp[i] * yp[i];
+			}
+			return sum;
+		}
+
+		// Two accumulators per row give eight independent FMA chains, enough to cover FMA latency
+		// on two ports.
+		COMP6771_TARGET("avx2,fma")
+		auto dot4_avx2(std::span<double const> x,
+		               double const* y,
+		               std::size_t stride,
+		               std::span<double, 4> result) noexcept -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* y0 = y;
+			auto const* y1 = y0 + stride;
+			auto const* y2 = y1 + stride;
+			auto const* y3 = y2 + stride;
+			auto a0 = _mm256_setzero_pd();
+			auto a1 = _mm256_setzero_pd();
+			auto a2 = _mm256_setzero_pd();
+			auto a3 = _mm256_setzero_pd();
+			auto b0 = _mm256_setzero_pd();
+			auto b1 = _mm256_setzero_pd();
+			auto b2 = _mm256_setzero_pd();
+			auto b3 = _mm256_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const xa = _mm256_loadu_pd(xp + i);
+				auto const xb = _mm256_loadu_pd(xp + i + 4);
+				a0 = _mm256_fmadd_pd(xa, _mm256_loadu_pd(y0 + i), a0);
+				a1 = _mm256_fmadd_pd(xa, _mm256_loadu_pd(y1 + i), a1);
+				a2 = _mm256_fmadd_pd(xa, _mm256_loadu_pd(y2 + i), a2);
+				a3 = _mm256_fmadd_pd(xa, _mm256_loadu_pd(y3 + i), a3);
+				b0 = _mm256_fmadd_pd(xb, _mm256_loadu_pd(y0 + i + 4), b0);
+				b1 = _mm256_fmadd_pd(xb, _mm256_loadu_pd(y1 + i + 4), b1);
+				b2 = _mm256_fmadd_pd(xb, _mm256_loadu_pd(y2 + i + 4), b2);
+				b3 = _mm256_fmadd_pd(xb, _mm256_loadu_pd(y3 + i + 4), b3);
+			}
+			for (; i + 4 <= n; i += 4) {
+				auto const xa = _mm256_loadu_pd(xp + i);
+				a0 = _mm256_fmadd_pd(xa, _mm256_loadu_pd(y0 + i), a0);
+				a1 = _mm256_fmadd_pd(xa, _mm256_loadu_pd(y1 + i), a1);
+				a2 = _mm256_fmadd_pd(xa, _mm256_loadu_pd(y2 + i), a2);
+				a3 = _mm256_fmadd_pd(xa, _mm256_loadu_pd(y3 + i), a3);
+			}
+			auto r0 = hsum(_mm256_add_pd(a0, b0));
+			auto r1 = hsum(_mm256_add_pd(a1, b1));
+			auto r2 = hsum(_mm256_add_pd(a2, b2));
+			auto r3 = hsum(_mm256_add_pd(a3, b3));
+			for (; i < n; ++i) {
+				r0 += xp[i] * y0[i];
+				r1 += xp[i] * y1[i];
+				r2 += xp[i] * y2[i];
+				r3 += xp[i] * y3[i];
+			}
+			result[0] += r0;
+			result[1] += r1;
+			result[2] += r2;
+			result[3] += r3;
+		}
+
+		COMP6771_TARGET("avx2,fma")
+		auto squared_norm_avx2(std::span<double const> x) noexcept -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto s0 = _mm256_setzero_pd();
+			auto s1 = _mm256_setzero_pd();
+			auto s2 = _mm256_setzero_pd();
+			auto s3 = _mm256_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				auto const v0 = _mm256_loadu_pd(xp + i);
+				auto const v1 = _mm256_loadu_pd(xp + i + 4);
+				auto const v2 = _mm256_loadu_pd(xp + i + 8);
+				auto const v3 = _mm256_loadu_pd(xp + i + 12);
+				s0 = _mm256_fmadd_pd(v0, v0, s0);
+				s1 = _mm256_fmadd_pd(v1, v1, s1);
+				s2 = _mm256_fmadd_pd(v2, v2, s2);
+				s3 = _mm256_fmadd_pd(v3, v3, s3);
+			}
+			for (; i + 4 <= n; i += 4) {
+				auto const v = _mm256_loadu_pd(xp + i);
+				s0 = _mm256_fmadd_pd(v, v, s0);
+			}
+			auto sum = hsum(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+			for (; i < n; ++i) {
+				sum += xp[i] * xp[i];
+			}
+			return sum;
+		}
+
+		COMP6771_TARGET("avx2,fma")
+		auto squared_distance_avx2(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto s0 = _mm256_setzero_pd();
+			auto s1 = _mm256_setzero_pd();
+			auto s2 = _mm256_setzero_pd();
+			auto s3 = _mm256_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				auto const d0 = _mm256_sub_pd(_mm256_loadu_pd(xp + i), _mm256_loadu_pd(yp + i));
+				auto const d1 = _mm256_sub_pd(_mm256_loadu_pd(xp + i + 4), _mm256_loadu_pd(yp + i + 4));
+				auto const d2 = _mm256_sub_pd(_mm256_loadu_pd(xp + i + 8), _mm256_loadu_pd(yp + i + 8));
+				auto const d3 =
+				   _mm256_sub_pd(_mm256_loadu_pd(xp + i + 12), _mm256_loadu_pd(yp + i + 12));
+				s0 = _mm256_fmadd_pd(d0, d0, s0);
+				s1 = _mm256_fmadd_pd(d1, d1, s1);
+				s2 = _mm256_fmadd_pd(d2, d2, s2);
+				s3 = _mm256_fmadd_pd(d3, d3, s3);
+			}
+			for (; i + 4 <= n; i += 4) {
+				auto const d = _mm256_sub_pd(_mm256_loadu_pd(xp + i), _mm256_loadu_pd(yp + i));
+				s0 = _mm256_fmadd_pd(d, d, s0);
+			}
+			auto sum = hsum(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+			for (; i < n; ++i) {
+				auto const d = xp[i] - yp[i];
+				sum += d * d;
+			}
+			return sum;
+		}
+
+		COMP6771_TARGET("avx2,fma")
+		auto manhattan_distance_avx2(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto const sign = _mm256_set1_pd(-0.0);
+			auto s0 = _mm256_setzero_pd();
+			auto s1 = _mm256_setzero_pd();
+			auto s2 = _mm256_setzero_pd();
+			auto s3 = _mm256_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				auto const d0 = _mm256_sub_pd(_mm256_loadu_pd(xp + i), _mm256_loadu_pd(yp + i));
+				auto const d1 = _mm256_sub_pd(_mm256_loadu_pd(xp + i + 4), _mm256_loadu_pd(yp + i + 4));
+				auto const d2 = _mm256_sub_pd(_mm256_loadu_pd(xp + i + 8), _mm256_loadu_pd(yp + i + 8));
+				auto const d3 =
+				   _mm256_sub_pd(_mm256_loadu_pd(xp + i + 12), _mm256_loadu_pd(yp + i + 12));
+				s0 = _mm256_add_pd(s0, _mm256_andnot_pd(sign, d0));
+				s1 = _mm256_add_pd(s1, _mm256_andnot_pd(sign, d1));
+				s2 = _mm256_add_pd(s2, _mm256_andnot_pd(sign, d2));
+				s3 = _mm256_add_pd(s3, _mm256_andnot_pd(sign, d3));
+			}
+			for (; i + 4 <= n; i += 4) {
+				auto const d = _mm256_sub_pd(_mm256_loadu_pd(xp + i), _mm256_loadu_pd(yp + i));
+				s0 = _mm256_add_pd(s0, _mm256_andnot_pd(sign, d));
+			}
+			auto sum = hsum(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+			for (; i < n; ++i) {
+				sum += std::abs(xp[i] - yp[i]);
+			}
+			return sum;
+		}
+
+		COMP6771_TARGET("avx2,fma")
+		auto cosine_avx2(std::span<double const> x, std::span<double const> y) noexcept
+		   -> cosine_terms {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto xy0 = _mm256_setzero_pd();
+			auto xy1 = _mm256_setzero_pd();
+			auto xx0 = _mm256_setzero_pd();
+			auto xx1 = _mm256_setzero_pd();
+			auto yy0 = _mm256_setzero_pd();
+			auto yy1 = _mm256_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const x0 = _mm256_loadu_pd(xp + i);
+				auto const x1 = _mm256_loadu_pd(xp + i + 4);
+				auto const y0 = _mm256_loadu_pd(yp + i);
+				auto const y1 = _mm256_loadu_pd(yp + i + 4);
+				xy0 = _mm256_fmadd_pd(x0, y0, xy0);
+				xy1 = _mm256_fmadd_pd(x1, y1, xy1);
+				xx0 = _mm256_fmadd_pd(x0, x0, xx0);
+				xx1 = _mm256_fmadd_pd(x1, x1, xx1);
+				yy0 = _mm256_fmadd_pd(y0, y0, yy0);
+				yy1 = _mm256_fmadd_pd(y1, y1, yy1);
+			}
+			for (; i + 4 <= n; i += 4) {
+				auto const x0 = _mm256_loadu_pd(xp + i);
+				auto const y0 = _mm256_loadu_pd(yp + i);
+				xy0 = _mm256_fmadd_pd(x0, y0, xy0);
+				xx0 = _mm256_fmadd_pd(x0, x0, xx0);
+				yy0 = _mm256_fmadd_pd(y0, y0, yy0);
+			}
+			auto result = cosine_terms{hsum(_mm256_add_pd(xy0, xy1)),
+			                           hsum(_mm256_add_pd(xx0, xx1)),
+			                           hsum(_mm256_add_pd(yy0, yy1))};
+			for (; i < n; ++i) {
+				result.dot += xp[i] * yp[i];
+				result.x_squared_norm += xp[i] * xp[i];
+				result.y_squared_norm += yp[i] * yp[i];
+			}
+			return result;
+		}
+
+		COMP6771_TARGET("avx2,fma")
+		auto axpy_avx2(double alpha, std::span<double const> x, std::span<double> y) noexcept
+		   -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			auto const a = _mm256_set1_pd(alpha);
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				// a multiply and an add, not an FMA, so that every kernel rounds the same way
+				auto const r0 =
+				   _mm256_add_pd(_mm256_loadu_pd(yp + i), _mm256_mul_pd(a, _mm256_loadu_pd(xp + i)));
+				auto const r1 = _mm256_add_pd(_mm256_loadu_pd(yp + i + 4),
+				                              _mm256_mul_pd(a, _mm256_loadu_pd(xp + i + 4)));
+				_mm256_storeu_pd(yp + i, r0);
+				_mm256_storeu_pd(yp + i + 4, r1);
+			}
+			for (; i < n; ++i) {
+				yp[i] += alpha * xp[i];
+			}
+		}
+
+		COMP6771_TARGET("avx2,fma")
+		auto scale_avx2(double alpha, std::span<double> x) noexcept -> void {
+			auto const n = x.size();
+			auto* xp = x.data();
+			auto const a = _mm256_set1_pd(alpha);
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				_mm256_storeu_pd(xp + i, _mm256_mul_pd(_mm256_loadu_pd(xp + i), a));
+				_mm256_storeu_pd(xp + i + 4, _mm256_mul_pd(_mm256_loadu_pd(xp + i + 4), a));
+			}
+			for (; i < n; ++i) {
+				xp[i] *= alpha;
+			}
+		}
+
+		COMP6771_TARGET("avx2,fma")
+		auto divide_avx2(double divisor, std::span<double> x) noexcept -> void {
+			auto const n = x.size();
+			auto* xp = x.data();
+			auto const d = _mm256_set1_pd(divisor);
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				_mm256_storeu_pd(xp + i, _mm256_div_pd(_mm256_loadu_pd(xp + i), d));
+				_mm256_storeu_pd(xp + i + 4, _mm256_div_pd(_mm256_loadu_pd(xp + i + 4), d));
+			}
+			for (; i < n; ++i) {
+				xp[i] /= divisor;
+			}
+		}
+
+		COMP6771_TARGET("avx2,fma")
+		auto axpby_avx2(double alpha,
+		                std::span<double const> x,
+		                double beta,
+		                std::span<double> y) noexcept -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			auto const a = _mm256_set1_pd(alpha);
+			auto const b = _mm256_set1_pd(beta);
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				// no FMA here either; see axpy_avx2
+				auto const r0 = _mm256_add_pd(_mm256_mul_pd(a, _mm256_loadu_pd(xp + i)),
+				                              _mm256_mul_pd(b, _mm256_loadu_pd(yp + i)));
+				auto const r1 = _mm256_add_pd(_mm256_mul_pd(a, _mm256_loadu_pd(xp + i + 4)),
+				                              _mm256_mul_pd(b, _mm256_loadu_pd(yp + i + 4)));
+				_mm256_storeu_pd(yp + i, r0);
+				_mm256_storeu_pd(yp + i + 4, r1);
+			}
+			for (; i < n; ++i) {
+				yp[i] = alpha * xp[i] + beta * yp[i];
+			}
+		}
+
+		COMP6771_TARGET("avx2,fma")
+		auto scale_add_avx2(double alpha, double beta, std::span<double> x) noexcept -> void {
+			auto const n = x.size();
+			auto* xp = x.data();
+			auto const a = _mm256_set1_pd(alpha);
+			auto const b = _mm256_set1_pd(beta);
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				_mm256_storeu_pd(xp + i, _mm256_fmadd_pd(_mm256_loadu_pd(xp + i), a, b));
+				_mm256_storeu_pd(xp + i + 4, _mm256_fmadd_pd(_mm256_loadu_pd(xp + i + 4), a, b));
+			}
+			for (; i < n; ++i) {
+				xp[i] = std::fma(xp[i], alpha, beta);
+			}
+		}
+
+		COMP6771_TARGET("avx2,fma")
+		auto multiply_elementwise_avx2(std::span<double const> x, std::span<double> y) noexcept
+		   -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const r0 = _mm256_mul_pd(_mm256_loadu_pd(yp + i), _mm256_loadu_pd(xp + i));
+				auto const r1 = _mm256_mul_pd(_mm256_loadu_pd(yp + i + 4), _mm256_loadu_pd(xp + i + 4));
+				_mm256_storeu_pd(yp + i, r0);
+				_mm256_storeu_pd(yp + i + 4, r1);
+			}
+			for (; i < n; ++i) {
+				yp[i] *= xp[i];
+			}
+		}
+
+		COMP6771_TARGET("avx2,fma")
+		auto divide_elementwise_avx2(std::span<double const> x, std::span<double> y) noexcept
+		   -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const r0 = _mm256_div_pd(_mm256_loadu_pd(yp + i), _mm256_loadu_pd(xp + i));
+				auto const r1 = _mm256_div_pd(_mm256_loadu_pd(yp + i + 4), _mm256_loadu_pd(xp + i + 4));
+				_mm256_storeu_pd(yp + i, r0);
+				_mm256_storeu_pd(yp + i + 4, r1);
+			}
+			for (; i < n; ++i) {
+				yp[i] /= xp[i];
+			}
+		}
+
+		COMP6771_TARGET("avx2")
+		auto blocked_dot_avx2(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			return blocked_dot_lanes(x, y);
+		}
+
+		COMP6771_TARGET("avx2")
+		auto pairwise_dot_avx2(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			return pairwise_dot_lanes(x, y);
+		}
+
+		COMP6771_TARGET("avx2")
+		auto compensated_dot_avx2(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			return compensated_dot_lanes(x, y);
+		}
+
+		template<typename T>
+		COMP6771_TARGET("avx2,fma")
+		auto widening_dot_avx2(std::span<T const> x, std::span<T const> y) noexcept -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto s0 = _mm256_setzero_pd();
+			auto s1 = _mm256_setzero_pd();
+			auto s2 = _mm256_setzero_pd();
+			auto s3 = _mm256_setzero_pd();
+			auto const product = [xp, yp](std::size_t i, __m256d s) COMP6771_TARGET("avx2,fma") {
+				return _mm256_fmadd_pd(_mm256_cvtps_pd(load4_ps(xp + i)),
+				                       _mm256_cvtps_pd(load4_ps(yp + i)),
+				                       s);
+			};
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				s0 = product(i, s0);
+				s1 = product(i + 4, s1);
+				s2 = product(i + 8, s2);
+				s3 = product(i + 12, s3);
+			}
+			for (; i + 4 <= n; i += 4) {
+				s0 = product(i, s0);
+			}
+			auto sum = hsum(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+			for (; i < n; ++i) {
+				sum += widen(xp[i]) * widen(yp[i]);
+			}
+			return sum;
+		}
+
+		COMP6771_TARGET("avx2")
+		auto int8_dot_avx2(std::span<std::int8_t const> x, std::span<std::int8_t const> y) noexcept
+		   -> std::int64_t {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto const product = [xp, yp](std::size_t i) COMP6771_TARGET("avx2") {
+				auto const xb = _mm_loadu_si128(reinterpret_cast<__m128i const*>(xp + i));
+				auto const yb = _mm_loadu_si128(reinterpret_cast<__m128i const*>(yp + i));
+				return _mm256_madd_epi16(_mm256_cvtepi8_epi16(xb), _mm256_cvtepi8_epi16(yb));
+			};
+			auto sum = std::int64_t{0};
+			auto i = std::size_t{0};
+			while (i + 32 <= n) {
+				auto const block_end = std::min(n, i + int8_block);
+				auto acc0 = _mm256_setzero_si256();
+				auto acc1 = _mm256_setzero_si256();
+				for (; i + 32 <= block_end; i += 32) {
+					acc0 = _mm256_add_epi32(acc0, product(i));
+					acc1 = _mm256_add_epi32(acc1, product(i + 16));
+				}
+				auto partial = std::array<std::int32_t, 8>{};
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(partial.data()),
+				                    _mm256_add_epi32(acc0, acc1));
+				sum += sum_lanes(partial);
+			}
+			for (; i < n; ++i) {
+				sum += xp[i] * yp[i];
+			}
+			return sum;
+		}
+
+		auto const avx2_table = kernel_table{
+		   dot_avx2,
+		   blocked_dot_avx2,
+		   pairwise_dot_avx2,
+		   compensated_dot_avx2,
+		   dot4_avx2,
+		   squared_norm_avx2,
+		   axpy_avx2,
+		   scale_avx2,
+		   divide_avx2,
+		   widening_dot_avx2<float>,
+		   widening_dot_avx2<bfloat16>,
+		   int8_dot_avx2,
+		   squared_distance_avx2,
+		   manhattan_distance_avx2,
+		   cosine_avx2,
+		   axpby_avx2,
+		   scale_add_avx2,
+		   multiply_elementwise_avx2,
+		   divide_elementwise_avx2,
+		};
+
+		//----------------------------------AVX-512--------------------------------------------
+		COMP6771_TARGET("avx512f")
+		auto dot_avx512(std::span<double const> x, std::span<double const> y) noexcept -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto s0 = _mm512_setzero_pd();
+			auto s1 = _mm512_setzero_pd();
+			auto s2 = _mm512_setzero_pd();
+			auto s3 = _mm512_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 32 <= n; i += 32) {
+				s0 = _mm512_fmadd_pd(_mm512_loadu_pd(xp + i), _mm512_loadu_pd(yp + i), s0);
+				s1 = _mm512_fmadd_pd(_mm512_loadu_pd(xp + i + 8), _mm512_loadu_pd(yp + i + 8), s1);
+				s2 = _mm512_fmadd_pd(_mm512_loadu_pd(xp + i + 16), _mm512_loadu_pd(yp + i + 16), s2);
+				s3 = _mm512_fmadd_pd(_mm512_loadu_pd(xp + i + 24), _mm512_loadu_pd(yp + i + 24), s3);
+			}
+			for (; i + 8 <= n; i += 8) {
+				s0 = _mm512_fmadd_pd(_mm512_loadu_pd(xp + i), _mm512_loadu_pd(yp + i), s0);
+			}
+			// the remaining 0-7 elements go through a masked load instead of a scalar loop
+			auto const mask = static_cast<__mmask8>((1U << (n - i)) - 1U);
+			s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, xp + i),
+			                     _mm512_maskz_loadu_pd(mask, yp + i),
+			                     s1);
+			return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+		}
+
+		COMP6771_TARGET("avx512f")
+		auto dot4_avx512(std::span<double const> x,
+		                 double const* y,
+		                 std::size_t stride,
+		                 std::span<double, 4> result) noexcept -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* y0 = y;
+			auto const* y1 = y0 + stride;
+			auto const* y2 = y1 + stride;
+			auto const* y3 = y2 + stride;
+			auto a0 = _mm512_setzero_pd();
+			auto a1 = _mm512_setzero_pd();
+			auto a2 = _mm512_setzero_pd();
+			auto a3 = _mm512_setzero_pd();
+			auto b0 = _mm512_setzero_pd();
+			auto b1 = _mm512_setzero_pd();
+			auto b2 = _mm512_setzero_pd();
+			auto b3 = _mm512_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				auto const xa = _mm512_loadu_pd(xp + i);
+				auto const xb = _mm512_loadu_pd(xp + i + 8);
+				a0 = _mm512_fmadd_pd(xa, _mm512_loadu_pd(y0 + i), a0);
+				a1 = _mm512_fmadd_pd(xa, _mm512_loadu_pd(y1 + i), a1);
+				a2 = _mm512_fmadd_pd(xa, _mm512_loadu_pd(y2 + i), a2);
+				a3 = _mm512_fmadd_pd(xa, _mm512_loadu_pd(y3 + i), a3);
+				b0 = _mm512_fmadd_pd(xb, _mm512_loadu_pd(y0 + i + 8), b0);
+				b1 = _mm512_fmadd_pd(xb, _mm512_loadu_pd(y1 + i + 8), b1);
+				b2 = _mm512_fmadd_pd(xb, _mm512_loadu_pd(y2 + i + 8), b2);
+				b3 = _mm512_fmadd_pd(xb, _mm512_loadu_pd(y3 + i + 8), b3);
+			}
+			for (; i + 8 <= n; i += 8) {
+				auto const xa = _mm512_loadu_pd(xp + i);
+				a0 = _mm512_fmadd_pd(xa, _mm512_loadu_pd(y0 + i), a0);
+				a1 = _mm512_fmadd_pd(xa, _mm512_loadu_pd(y1 + i), a1);
+				a2 = _mm512_fmadd_pd(xa, _mm512_loadu_pd(y2 + i), a2);
+				a3 = _mm512_fmadd_pd(xa, _mm512_loadu_pd(y3 + i), a3);
+			}
+			auto const mask = static_cast<__mmask8>((1U << (n - i)) - 1U);
+			auto const xt = _mm512_maskz_loadu_pd(mask, xp + i);
+			b0 = _mm512_fmadd_pd(xt, _mm512_maskz_loadu_pd(mask, y0 + i), b0);
+			b1 = _mm512_fmadd_pd(xt, _mm512_maskz_loadu_pd(mask, y1 + i), b1);
+			b2 = _mm512_fmadd_pd(xt, _mm512_maskz_loadu_pd(mask, y2 + i), b2);
+			b3 = _mm512_fmadd_pd(xt, _mm512_maskz_loadu_pd(mask, y3 + i), b3);
+			result[0] += _mm512_reduce_add_pd(_mm512_add_pd(a0, b0));
+			result[1] += _mm512_reduce_add_pd(_mm512_add_pd(a1, b1));
+			result[2] += _mm512_reduce_add_pd(_mm512_add_pd(a2, b2));
+			result[3] += _mm512_reduce_add_pd(_mm512_add_pd(a3, b3));
+		}
+
+		COMP6771_TARGET("avx512f")
+		auto squared_norm_avx512(std::span<double const> x) noexcept -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto s0 = _mm512_setzero_pd();
+			auto s1 = _mm512_setzero_pd();
+			auto s2 = _mm512_setzero_pd();
+			auto s3 = _mm512_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 32 <= n; i += 32) {
+				auto const v0 = _mm512_loadu_pd(xp + i);
+				auto const v1 = _mm512_loadu_pd(xp + i + 8);
+				auto const v2 = _mm512_loadu_pd(xp + i + 16);
+				auto const v3 = _mm512_loadu_pd(xp + i + 24);
+				s0 = _mm512_fmadd_pd(v0, v0, s0);
+				s1 = _mm512_fmadd_pd(v1, v1, s1);
+				s2 = _mm512_fmadd_pd(v2, v2, s2);
+				s3 = _mm512_fmadd_pd(v3, v3, s3);
+			}
+			for (; i + 8 <= n; i += 8) {
+				auto const v = _mm512_loadu_pd(xp + i);
+				s0 = _mm512_fmadd_pd(v, v, s0);
+			}
+			auto const mask = static_cast<__mmask8>((1U << (n - i)) - 1U);
+			auto const tail = _mm512_maskz_loadu_pd(mask, xp + i);
+			s1 = _mm512_fmadd_pd(tail, tail, s1);
+			return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+		}
+
+		COMP6771_TARGET("avx512f")
+		auto squared_distance_avx512(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto s0 = _mm512_setzero_pd();
+			auto s1 = _mm512_setzero_pd();
+			auto s2 = _mm512_setzero_pd();
+			auto s3 = _mm512_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 32 <= n; i += 32) {
+				auto const d0 = _mm512_sub_pd(_mm512_loadu_pd(xp + i), _mm512_loadu_pd(yp + i));
+				auto const d1 = _mm512_sub_pd(_mm512_loadu_pd(xp + i + 8), _mm512_loadu_pd(yp + i + 8));
+				auto const d2 =
+				   _mm512_sub_pd(_mm512_loadu_pd(xp + i + 16), _mm512_loadu_pd(yp + i + 16));
+				auto const d3 =
+				   _mm512_sub_pd(_mm512_loadu_pd(xp + i + 24), _mm512_loadu_pd(yp + i + 24));
+				s0 = _mm512_fmadd_pd(d0, d0, s0);
+				s1 = _mm512_fmadd_pd(d1, d1, s1);
+				s2 = _mm512_fmadd_pd(d2, d2, s2);
+				s3 = _mm512_fmadd_pd(d3, d3, s3);
+			}
+			for (; i + 8 <= n; i += 8) {
+				auto const d = _mm512_sub_pd(_mm512_loadu_pd(xp + i), _mm512_loadu_pd(yp + i));
+				s0 = _mm512_fmadd_pd(d, d, s0);
+			}
+			auto const mask = static_cast<__mmask8>((1U << (n - i)) - 1U);
+			auto const tail =
+			   _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, xp + i), _mm512_maskz_loadu_pd(mask, yp + i));
+			s1 = _mm512_fmadd_pd(tail, tail, s1);
+			return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+		}
+
+		COMP6771_TARGET("avx512f")
+		auto manhattan_distance_avx512(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto s0 = _mm512_setzero_pd();
+			auto s1 = _mm512_setzero_pd();
+			auto s2 = _mm512_setzero_pd();
+			auto s3 = _mm512_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 32 <= n; i += 32) {
+				auto const d0 = _mm512_sub_pd(_mm512_loadu_pd(xp + i), _mm512_loadu_pd(yp + i));
+				auto const d1 = _mm512_sub_pd(_mm512_loadu_pd(xp + i + 8), _mm512_loadu_pd(yp + i + 8));
+				auto const d2 =
+				   _mm512_sub_pd(_mm512_loadu_pd(xp + i + 16), _mm512_loadu_pd(yp + i + 16));
+				auto const d3 =
+				   _mm512_sub_pd(_mm512_loadu_pd(xp + i + 24), _mm512_loadu_pd(yp + i + 24));
+				s0 = _mm512_add_pd(s0, _mm512_abs_pd(d0));
+				s1 = _mm512_add_pd(s1, _mm512_abs_pd(d1));
+				s2 = _mm512_add_pd(s2, _mm512_abs_pd(d2));
+				s3 = _mm512_add_pd(s3, _mm512_abs_pd(d3));
+			}
+			for (; i + 8 <= n; i += 8) {
+				auto const d = _mm512_sub_pd(_mm512_loadu_pd(xp + i), _mm512_loadu_pd(yp + i));
+				s0 = _mm512_add_pd(s0, _mm512_abs_pd(d));
+			}
+			auto const mask = static_cast<__mmask8>((1U << (n - i)) - 1U);
+			auto const tail =
+			   _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, xp + i), _mm512_maskz_loadu_pd(mask, yp + i));
+			s1 = _mm512_add_pd(s1, _mm512_abs_pd(tail));
+			return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+		}
+
+		COMP6771_TARGET("avx512f")
+		auto cosine_avx512(std::span<double const> x, std::span<double const> y) noexcept
+		   -> cosine_terms {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto xy0 = _mm512_setzero_pd();
+			auto xy1 = _mm512_setzero_pd();
+			auto xx0 = _mm512_setzero_pd();
+			auto xx1 = _mm512_setzero_pd();
+			auto yy0 = _mm512_setzero_pd();
+			auto yy1 = _mm512_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				auto const x0 = _mm512_loadu_pd(xp + i);
+				auto const x1 = _mm512_loadu_pd(xp + i + 8);
+				auto const y0 = _mm512_loadu_pd(yp + i);
+				auto const y1 = _mm512_loadu_pd(yp + i + 8);
+				xy0 = _mm512_fmadd_pd(x0, y0, xy0);
+				xy1 = _mm512_fmadd_pd(x1, y1, xy1);
+				xx0 = _mm512_fmadd_pd(x0, x0, xx0);
+				xx1 = _mm512_fmadd_pd(x1, x1, xx1);
+				yy0 = _mm512_fmadd_pd(y0, y0, yy0);
+				yy1 = _mm512_fmadd_pd(y1, y1, yy1);
+			}
+			for (; i + 8 <= n; i += 8) {
+				auto const x0 = _mm512_loadu_pd(xp + i);
+				auto const y0 = _mm512_loadu_pd(yp + i);
+				xy0 = _mm512_fmadd_pd(x0, y0, xy0);
+				xx0 = _mm512_fmadd_pd(x0, x0, xx0);
+				yy0 = _mm512_fmadd_pd(y0, y0, yy0);
+			}
+			auto const mask = static_cast<__mmask8>((1U << (n - i)) - 1U);
+			auto const x_tail = _mm512_maskz_loadu_pd(mask, xp + i);
+			auto const y_tail = _mm512_maskz_loadu_pd(mask, yp + i);
+			xy1 = _mm512_fmadd_pd(x_tail, y_tail, xy1);
+			xx1 = _mm512_fmadd_pd(x_tail, x_tail, xx1);
+			yy1 = _mm512_fmadd_pd(y_tail, y_tail, yy1);
+			return {_mm512_reduce_add_pd(_mm512_add_pd(xy0, xy1)),
+			        _mm512_reduce_add_pd(_mm512_add_pd(xx0, xx1)),
+			        _mm512_reduce_add_pd(_mm512_add_pd(yy0, yy1))};
+		}
+
+		COMP6771_TARGET("avx512f")
+		auto axpy_avx512(double alpha, std::span<double const> x, std::span<double> y) noexcept
+		   -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			auto const a = _mm512_set1_pd(alpha);
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				// a multiply and an add, not an FMA, so that every kernel rounds the same way
+				auto const r0 =
+				   _mm512_add_pd(_mm512_loadu_pd(yp + i), _mm512_mul_pd(a, _mm512_loadu_pd(xp + i)));
+				auto const r1 = _mm512_add_pd(_mm512_loadu_pd(yp + i + 8),
+				                              _mm512_mul_pd(a, _mm512_loadu_pd(xp + i + 8)));
+				_mm512_storeu_pd(yp + i, r0);
+				_mm512_storeu_pd(yp + i + 8, r1);
+			}
+			for (; i + 8 <= n; i += 8) {
+				_mm512_storeu_pd(yp + i,
+				                 _mm512_add_pd(_mm512_loadu_pd(yp + i),
+				                               _mm512_mul_pd(a, _mm512_loadu_pd(xp + i))));
+			}
+			auto const mask = static_cast<__mmask8>((1U << (n - i)) - 1U);
+			auto const r = _mm512_add_pd(_mm512_maskz_loadu_pd(mask, yp + i),
+			                             _mm512_mul_pd(a, _mm512_maskz_loadu_pd(mask, xp + i)));
+			_mm512_mask_storeu_pd(yp + i, mask, r);
+		}
+
+		COMP6771_TARGET("avx512f")
+		auto scale_avx512(double alpha, std::span<double> x) noexcept -> void {
+			auto const n = x.size();
+			auto* xp = x.data();
+			auto const a = _mm512_set1_pd(alpha);
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				_mm512_storeu_pd(xp + i, _mm512_mul_pd(_mm512_loadu_pd(xp + i), a));
+				_mm512_storeu_pd(xp + i + 8, _mm512_mul_pd(_mm512_loadu_pd(xp + i + 8), a));
+			}
+			for (; i + 8 <= n; i += 8) {
+				_mm512_storeu_pd(xp + i, _mm512_mul_pd(_mm512_loadu_pd(xp + i), a));
+			}
+			auto const mask = static_cast<__mmask8>((1U << (n - i)) - 1U);
+			_mm512_mask_storeu_pd(xp + i, mask, _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, xp + i), a));
+		}
+
+		COMP6771_TARGET("avx512f")
+		auto divide_avx512(double divisor, std::span<double> x) noexcept -> void {
+			auto const n = x.size();
+			auto* xp = x.data();
+			auto const d = _mm512_set1_pd(divisor);
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				_mm512_storeu_pd(xp + i, _mm512_div_pd(_mm512_loadu_pd(xp + i), d));
+				_mm512_storeu_pd(xp + i + 8, _mm512_div_pd(_mm512_loadu_pd(xp + i + 8), d));
+			}
+			for (; i + 8 <= n; i += 8) {
+				_mm512_storeu_pd(xp + i, _mm512_div_pd(_mm512_loadu_pd(xp + i), d));
+			}
+			auto const mask = static_cast<__mmask8>((1U << (n - i)) - 1U);
+			// masked-off lanes are 0 / divisor, which may raise FP flags but is never stored
+			_mm512_mask_storeu_pd(xp + i,
+			                      mask,
+			                      _mm512_div_pd(_mm512_maskz_loadu_pd(mask, xp + i), d));
+		}
+
+		COMP6771_TARGET("avx512f")
+		auto axpby_avx512(double alpha,
+		                  std::span<double const> x,
+		                  double beta,
+		                  std::span<double> y) noexcept -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			auto const a = _mm512_set1_pd(alpha);
+			auto const b = _mm512_set1_pd(beta);
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				// no FMA here either; see axpy_avx512
+				_mm512_storeu_pd(yp + i,
+				                 _mm512_add_pd(_mm512_mul_pd(a, _mm512_loadu_pd(xp + i)),
+				                               _mm512_mul_pd(b, _mm512_loadu_pd(yp + i))));
+			}
+			auto const mask = static_cast<__mmask8>((1U << (n - i)) - 1U);
+			auto const r = _mm512_add_pd(_mm512_mul_pd(a, _mm512_maskz_loadu_pd(mask, xp + i)),
+			                             _mm512_mul_pd(b, _mm512_maskz_loadu_pd(mask, yp + i)));
+			_mm512_mask_storeu_pd(yp + i, mask, r);
+		}
+
+		COMP6771_TARGET("avx512f")
+		auto scale_add_avx512(double alpha, double beta, std::span<double> x) noexcept -> void {
+			auto const n = x.size();
+			auto* xp = x.data();
+			auto const a = _mm512_set1_pd(alpha);
+			auto const b = _mm512_set1_pd(beta);
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				_mm512_storeu_pd(xp + i, _mm512_fmadd_pd(_mm512_loadu_pd(xp + i), a, b));
+			}
+			auto const mask = static_cast<__mmask8>((1U << (n - i)) - 1U);
+			auto const r = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, xp + i), a, b);
+			_mm512_mask_storeu_pd(xp + i, mask, r);
+		}
+
+		COMP6771_TARGET("avx512f")
+		auto multiply_elementwise_avx512(std::span<double const> x, std::span<double> y) noexcept
+		   -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const r = _mm512_mul_pd(_mm512_loadu_pd(yp + i), _mm512_loadu_pd(xp + i));
+				_mm512_storeu_pd(yp + i, r);
+			}
+			auto const mask = static_cast<__mmask8>((1U << (n - i)) - 1U);
+			auto const r =
+			   _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, yp + i), _mm512_maskz_loadu_pd(mask, xp + i));
+			_mm512_mask_storeu_pd(yp + i, mask, r);
+		}
+
+		// the tail only divides the lanes it loads, so the rest never raise a 0 / 0 exception
+		COMP6771_TARGET("avx512f")
+		auto divide_elementwise_avx512(std::span<double const> x, std::span<double> y) noexcept
+		   -> void {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto* yp = y.data();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const r = _mm512_div_pd(_mm512_loadu_pd(yp + i), _mm512_loadu_pd(xp + i));
+				_mm512_storeu_pd(yp + i, r);
+			}
+			auto const mask = static_cast<__mmask8>((1U << (n - i)) - 1U);
+			auto const r = _mm512_maskz_div_pd(mask,
+			                                   _mm512_maskz_loadu_pd(mask, yp + i),
+			                                   _mm512_maskz_loadu_pd(mask, xp + i));
+			_mm512_mask_storeu_pd(yp + i, mask, r);
+		}
+
+		COMP6771_TARGET("avx512f")
+		auto blocked_dot_avx512(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			return blocked_dot_lanes(x, y);
+		}
+
+		COMP6771_TARGET("avx512f")
+		auto pairwise_dot_avx512(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			return pairwise_dot_lanes(x, y);
+		}
+
+		COMP6771_TARGET("avx512f")
+		auto compensated_dot_avx512(std::span<double const> x, std::span<double const> y) noexcept
+		   -> double {
+			return compensated_dot_lanes(x, y);
+		}
+
+		// eight elements, widened to float
+		COMP6771_TARGET("avx512f") auto load8_ps(float const* p) noexcept -> __m256 {
+			return _mm256_loadu_ps(p);
+		}
+
+		COMP6771_TARGET("avx512f") auto load8_ps(bfloat16 const* p) noexcept -> __m256 {
+			auto const bits = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+			return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(bits), 16));
+		}
+
+		template<typename T>
+		COMP6771_TARGET("avx512f")
+		auto widening_dot_avx512(std::span<T const> x, std::span<T const> y) noexcept -> double {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto s0 = _mm512_setzero_pd();
+			auto s1 = _mm512_setzero_pd();
+			auto s2 = _mm512_setzero_pd();
+			auto s3 = _mm512_setzero_pd();
+			auto const product = [xp, yp](std::size_t i, __m512d s) COMP6771_TARGET("avx512f") {
+				return _mm512_fmadd_pd(_mm512_cvtps_pd(load8_ps(xp + i)),
+				                       _mm512_cvtps_pd(load8_ps(yp + i)),
+				                       s);
+			};
+			auto i = std::size_t{0};
+			for (; i + 32 <= n; i += 32) {
+				s0 = product(i, s0);
+				s1 = product(i + 8, s1);
+				s2 = product(i + 16, s2);
+				s3 = product(i + 24, s3);
+			}
+			for (; i + 8 <= n; i += 8) {
+				s0 = product(i, s0);
+			}
+			auto sum =
+			   _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+			for (; i < n; ++i) {
+				sum += widen(xp[i]) * widen(yp[i]);
+			}
+			return sum;
+		}
+
+		// AVX-512F has no 16-bit multiply-add, so the bytes are widened to 32 bits and multiplied
+		// there
+		COMP6771_TARGET("avx512f")
+		auto int8_dot_avx512(std::span<std::int8_t const> x, std::span<std::int8_t const> y) noexcept
+		   -> std::int64_t {
+			auto const n = x.size();
+			auto const* xp = x.data();
+			auto const* yp = y.data();
+			auto const product = [xp, yp](std::size_t i) COMP6771_TARGET("avx512f") {
+				auto const xb = _mm_loadu_si128(reinterpret_cast<__m128i const*>(xp + i));
+				auto const yb = _mm_loadu_si128(reinterpret_cast<__m128i const*>(yp + i));
+				return _mm512_mullo_epi32(_mm512_cvtepi8_epi32(xb), _mm512_cvtepi8_epi32(yb));
+			};
+			auto sum = std::int64_t{0};
+			auto i = std::size_t{0};
+			while (i + 32 <= n) {
+				auto const block_end = std::min(n, i + int8_block);
+				auto acc0 = _mm512_setzero_si512();
+				auto acc1 = _mm512_setzero_si512();
+				for (; i + 32 <= block_end; i += 32) {
+					acc0 = _mm512_add_epi32(acc0, product(i));
+					acc1 = _mm512_add_epi32(acc1, product(i + 16));
+				}
+				auto partial = std::array<std::int32_t, 16>{};
+				_mm512_storeu_si512(partial.data(), _mm512_add_epi32(acc0, acc1));
+				sum += sum_lanes(partial);
+			}
+			for (; i < n; ++i) {
+				sum += xp[i] * yp[i];
+			}
+			return sum;
+		}
+
+		auto const avx512_table = kernel_table{
+		   dot_avx512,
+		   blocked_dot_avx512,
+		   pairwise_dot_avx512,
+		   compensated_dot_avx512,
+		   dot4_avx512,
+		   squared_norm_avx512,
+		   axpy_avx512,
+		   scale_avx512,
+		   divide_avx512,
+		   widening_dot_avx512<float>,
+		   widening_dot_avx512<bfloat16>,
+		   int8_dot_avx512,
+		   squared_distance_avx512,
+		   manhattan_distance_avx512,
+		   cosine_avx512,
+		   axpby_avx512,
+		   scale_add_avx512,
+		   multiply_elementwise_avx512,
+		   divide_elementwise_avx512,
+		};
+#endif // COMP6771_HAS_X86_KERNELS
+
+		auto active_kernels() noexcept -> kernel_table const& {
+			// resolved once; the function-local static makes the first call thread-safe
+			static auto const& table = kernels_for(detected_simd_width());
+			return table;
+		}
+	} // namespace
+
+	auto is_supported(simd_width width) noexcept -> bool {
+		switch (width) {
+		case simd_width::scalar: return true;
+#if COMP6771_HAS_X86_KERNELS
+		case simd_width::sse2: return __builtin_cpu_supports("sse2") != 0;
+		case simd_width::avx2:
+			return __builtin_cpu_supports("avx2") != 0 and __builtin_cpu_supports("fma") != 0;
+		case simd_width::avx512: return __builtin_cpu_supports("avx512f") != 0;
+#else
+		case simd_width::sse2:
+		case simd_width::avx2:
+		case simd_width::avx512: return false;
+#endif
+		}
+		return false;
+	}
+
+	auto detected_simd_width() noexcept -> simd_width {
+		for (auto const width : {simd_width::avx512, simd_width::avx2, simd_width::sse2}) {
+			if (is_supported(width)) {
+				return width;
+			}
+		}
+		return simd_width::scalar;
+	}
+
+	auto kernels_for(simd_width width) noexcept -> kernel_table const& {
+#if COMP6771_HAS_X86_KERNELS
+		switch (width) {
+		case simd_width::scalar: return scalar_table;
+		case simd_width::sse2: return sse2_table;
+		case simd_width::avx2: return avx2_table;
+		case simd_width::avx512: return avx512_table;
+		}
+#endif
+		static_cast<void>(width);
+		return scalar_table;
+	}
+
+	auto dot(std::span<double const> x, std::span<double const> y) noexcept -> double {
+		assert(x.size() == y.size());
+		return active_kernels().dot(x, y);
+	}
+
+	auto dot(std::span<double const> x, std::span<double const> y, reduction mode) noexcept
+	   -> double {
+		assert(x.size() == y.size());
+		auto const& kernels = active_kernels();
+		switch (mode) {
+		case reduction::unordered: return kernels.dot(x, y);
+		case reduction::blocked: return kernels.blocked_dot(x, y);
+		case reduction::pairwise: return kernels.pairwise_dot(x, y);
+		case reduction::compensated: return kernels.compensated_dot(x, y);
+		}
+		return kernels.dot(x, y);
+	}
+
+	auto dot4(std::span<double const> x,
+	          double const* y,
+	          std::size_t stride,
+	          std::span<double, 4> result) noexcept -> void {
+		assert(stride >= x.size());
+		active_kernels().dot4(x, y, stride, result);
+	}
+
+	auto squared_norm(std::span<double const> x) noexcept -> double {
+		return active_kernels().squared_norm(x);
+	}
+
+	auto squared_distance(std::span<double const> x, std::span<double const> y) noexcept -> double {
+		assert(x.size() == y.size());
+		return active_kernels().squared_distance(x, y);
+	}
+
+	auto manhattan_distance(std::span<double const> x, std::span<double const> y) noexcept
+	   -> double {
+		assert(x.size() == y.size());
+		return active_kernels().manhattan_distance(x, y);
+	}
+
+	auto cosine(std::span<double const> x, std::span<double const> y) noexcept -> cosine_terms {
+		assert(x.size() == y.size());
+		return active_kernels().cosine(x, y);
+	}
+
+	auto axpy(double alpha, std::span<double const> x, std::span<double> y) noexcept -> void {
+		assert(x.size() == y.size());
+		active_kernels().axpy(alpha, x, y);
+	}
+
+	auto scale(double alpha, std::span<double> x) noexcept -> void {
+		active_kernels().scale(alpha, x);
+	}
+
+	auto divide(double divisor, std::span<double> x) noexcept -> void {
+		active_kernels().divide(divisor, x);
+	}
+
+	auto axpby(double alpha, std::span<double const> x, double beta, std::span<double> y) noexcept
+	   -> void {
+		assert(x.size() == y.size());
+		active_kernels().axpby(alpha, x, beta, y);
+	}
+
+	auto scale_add(double alpha, double beta, std::span<double> x) noexcept -> void {
+		active_kernels().scale_add(alpha, beta, x);
+	}
+
+	auto multiply_elementwise(std::span<double const> x, std::span<double> y) noexcept -> void {
+		assert(x.size() == y.size());
+		active_kernels().multiply_elementwise(x, y);
+	}
+
+	auto divide_elementwise(std::span<double const> x, std::span<double> y) noexcept -> void {
+		assert(x.size() == y.size());
+		active_kernels().divide_elementwise(x, y);
+	}
+
+	auto dot(std::span<float const> x, std::span<float const> y) noexcept -> double {
+		assert(x.size() == y.size());
+		return active_kernels().float_dot(x, y);
+	}
+
+	auto dot(std::span<bfloat16 const> x, std::span<bfloat16 const> y) noexcept -> double {
+		assert(x.size() == y.size());
+		return active_kernels().bfloat16_dot(x, y);
+	}
+
+	auto dot(std::span<std::int8_t const> x, std::span<std::int8_t const> y) noexcept
+	   -> std::int64_t {
+		assert(x.size() == y.size());
+		return active_kernels().int8_dot(x, y);
+	}
+} // namespace comp6771::kernels
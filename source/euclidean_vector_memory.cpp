@@ -0,0 +1,189 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_memory.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory>
+
+namespace comp6771::pmr {
+	namespace {
+		auto align_up(std::byte* p, std::size_t alignment) noexcept -> std::byte* {
+			auto const address = reinterpret_cast<std::uintptr_t>(p);
+			auto const aligned = (address + alignment - 1) & ~(alignment - 1);
+			return p + (aligned - address);
+		}
+	} // namespace
+
+	//-----------------------------------arena_resource--------------------------------------------
+	arena_resource::arena_resource(std::size_t initial_chunk_bytes,
+	                               std::pmr::memory_resource* upstream)
+	: upstream_{upstream}
+	, next_chunk_bytes_{std::max(initial_chunk_bytes, sizeof(chunk_header))} {}
+
+	arena_resource::~arena_resource() {
+		release();
+	}
+
+	auto arena_resource::rewind() noexcept -> void {
+		if (chunks_ == nullptr) {
+			return;
+		}
+		auto* largest = chunks_;
+		for (auto* chunk = chunks_->previous; chunk != nullptr; chunk = chunk->previous) {
+			if (chunk->bytes > largest->bytes) {
+				largest = chunk;
+			}
+		}
+		for (auto* chunk = chunks_; chunk != nullptr;) {
+			auto* previous = chunk->previous;
+			if (chunk != largest) {
+				free_chunk(chunk);
+			}
+			chunk = previous;
+		}
+		largest->previous = nullptr;
+		chunks_ = largest;
+		current_ = reinterpret_cast<std::byte*>(largest) + sizeof(chunk_header);
+		end_ = reinterpret_cast<std::byte*>(largest) + largest->bytes;
+	}
+
+	auto arena_resource::release() noexcept -> void {
+		for (auto* chunk = chunks_; chunk != nullptr;) {
+			auto* previous = chunk->previous;
+			free_chunk(chunk);
+			chunk = previous;
+		}
+		chunks_ = nullptr;
+		current_ = nullptr;
+		end_ = nullptr;
+	}
+
+	auto arena_resource::upstream_resource() const noexcept -> std::pmr::memory_resource* {
+		return upstream_;
+	}
+
+	auto arena_resource::do_allocate(std::size_t bytes, std::size_t alignment) -> void* {
+		auto* result = align_up(current_, alignment);
+		if (current_ == nullptr or result > end_ or static_cast<std::size_t>(end_ - result) < bytes) {
+			add_chunk(bytes + alignment);
+			result = align_up(current_, alignment);
+		}
+		current_ = result + bytes;
+		return result;
+	}
+
+	// Only the most recent allocation can be given back: that's all a vector that lives and dies
+	// between two other allocations needs to have its bytes reused.
+	auto arena_resource::do_deallocate(void* p, std::size_t bytes, std::size_t) -> void {
+		if (static_cast<std::byte*>(p) + bytes == current_) {
+			current_ = static_cast<std::byte*>(p);
+		}
+	}
+
+	auto arena_resource::do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool {
+		return this == &other;
+	}
+
+	auto arena_resource::add_chunk(std::size_t min_bytes) -> void {
+		auto const bytes = std::max(next_chunk_bytes_, sizeof(chunk_header) + min_bytes);
+		auto* chunk =
+		   static_cast<chunk_header*>(upstream_->allocate(bytes, alignof(std::max_align_t)));
+		chunk->previous = chunks_;
+		chunk->bytes = bytes;
+		chunks_ = chunk;
+		current_ = reinterpret_cast<std::byte*>(chunk) + sizeof(chunk_header);
+		end_ = reinterpret_cast<std::byte*>(chunk) + bytes;
+		next_chunk_bytes_ = bytes * 2;
+	}
+
+	auto arena_resource::free_chunk(chunk_header* chunk) noexcept -> void {
+		upstream_->deallocate(chunk, chunk->bytes, alignof(std::max_align_t));
+	}
+
+	//------------------------------------pool_resource--------------------------------------------
+	namespace {
+		// index of the smallest size class whose blocks can hold bytes
+		auto class_index_for(std::size_t bytes) noexcept -> std::size_t {
+			return static_cast<std::size_t>(
+			   std::bit_width((std::max(bytes, std::size_t{1}) - 1) / pool_resource::min_block_bytes));
+		}
+
+		auto is_pooled(std::size_t bytes, std::size_t alignment) noexcept -> bool {
+			return bytes <= pool_resource::max_block_bytes
+			       and alignment <= pool_resource::block_alignment;
+		}
+	} // namespace
+
+	pool_resource::pool_resource(std::pmr::memory_resource* upstream)
+	: upstream_{upstream} {}
+
+	pool_resource::~pool_resource() {
+		release();
+	}
+
+	auto pool_resource::release() noexcept -> void {
+		for (auto const& c : chunks_) {
+			upstream_->deallocate(c.data, c.bytes, block_alignment);
+		}
+		chunks_.clear();
+		classes_.fill(size_class{});
+	}
+
+	auto pool_resource::upstream_resource() const noexcept -> std::pmr::memory_resource* {
+		return upstream_;
+	}
+
+	auto pool_resource::do_allocate(std::size_t bytes, std::size_t alignment) -> void* {
+		if (not is_pooled(bytes, alignment)) {
+			return upstream_->allocate(bytes, alignment);
+		}
+		auto const index = class_index_for(bytes);
+		if (classes_[index].free_list == nullptr) {
+			refill(index);
+		}
+		auto* block = classes_[index].free_list;
+		classes_[index].free_list = block->next;
+		return block;
+	}
+
+	auto pool_resource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void {
+		if (not is_pooled(bytes, alignment)) {
+			upstream_->deallocate(p, bytes, alignment);
+			return;
+		}
+		auto& size = classes_[class_index_for(bytes)];
+		size.free_list = ::new (p) free_block{size.free_list};
+	}
+
+	auto pool_resource::do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool {
+		return this == &other;
+	}
+
+	// Carves a new chunk into blocks for the class. Each refill of a class gets a chunk twice as
+	// big as the last one, up to max_chunk_bytes, so rarely used classes don't waste much memory.
+	auto pool_resource::refill(std::size_t class_index) -> void {
+		auto& size = classes_[class_index];
+		auto const block_bytes = min_block_bytes << class_index;
+		auto const chunk_bytes = block_bytes * size.blocks_per_chunk;
+
+		// record the chunk first, so that can't fail after the memory has been allocated
+		auto& record = chunks_.emplace_back(chunk{nullptr, chunk_bytes});
+		auto* data = static_cast<std::byte*>(nullptr);
+		try {
+			data = static_cast<std::byte*>(upstream_->allocate(chunk_bytes, block_alignment));
+		} catch (...) {
+			chunks_.pop_back();
+			throw;
+		}
+		record.data = data;
+
+		for (auto offset = chunk_bytes; offset != 0; offset -= block_bytes) {
+			size.free_list = ::new (data + offset - block_bytes) free_block{size.free_list};
+		}
+		auto const max_blocks = std::max(std::size_t{1}, max_chunk_bytes / block_bytes);
+		size.blocks_per_chunk = std::min(size.blocks_per_chunk * 2, max_blocks);
+	}
+} // namespace comp6771::pmr
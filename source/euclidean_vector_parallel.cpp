@@ -0,0 +1,159 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_parallel.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace comp6771 {
+	namespace {
+		auto chunk_count(std::size_t size) noexcept -> std::size_t {
+			return (size + parallel_chunk_size - 1) / parallel_chunk_size;
+		}
+
+		template<typename T>
+		auto chunk(std::span<T> magnitudes, std::size_t i) noexcept -> std::span<T> {
+			auto const first = i * parallel_chunk_size;
+			return magnitudes.subspan(first, std::min(parallel_chunk_size, magnitudes.size() - first));
+		}
+
+		// Calls body(i) for every chunk of a vector of the given size, on the pool if the vector is
+		// big enough to be worth it. The chunks are the same either way.
+		template<typename F>
+		auto for_each_chunk(thread_pool& pool, std::size_t size, F body) -> void {
+			auto const chunks = chunk_count(size);
+			if (size < parallel_threshold) {
+				for (auto i = std::size_t{0}; i < chunks; ++i) {
+					body(i);
+				}
+			}
+			else {
+				pool.parallel_for(chunks, body);
+			}
+		}
+
+		// A chunk is a power-of-two number of pairwise blocks, so continuing the pairwise tree
+		// over the chunk results gives the same tree, and the same bits, as a serial pairwise sum.
+		static_assert(parallel_chunk_size % kernels::pairwise_block_size == 0
+		              and std::has_single_bit(parallel_chunk_size / kernels::pairwise_block_size));
+
+		auto pairwise_sum(std::vector<double> const& sums) -> double {
+			auto subtrees = std::vector<double>();
+			for (auto i = std::size_t{0}; i < sums.size(); ++i) {
+				auto sum = sums[i];
+				for (auto b = i; (b & 1U) != 0; b >>= 1U) {
+					sum = subtrees.back() + sum;
+					subtrees.pop_back();
+				}
+				subtrees.push_back(sum);
+			}
+			// what's left is merged right to left, as in the serial pairwise sum
+			auto total = 0.0;
+			for (auto s = subtrees.rbegin(); s != subtrees.rend(); ++s) {
+				total = *s + total;
+			}
+			return total;
+		}
+
+		auto compensated_sum(std::vector<double> const& sums) -> double {
+			auto total = 0.0;
+			auto error = 0.0;
+			for (auto const value : sums) {
+				auto const t = total + value;
+				auto const z = t - total;
+				error += (total - (t - z)) + (value - z);
+				total = t;
+			}
+			return total + error;
+		}
+
+		// sums partial(chunk i) over every chunk, combining the per-chunk results in chunk order
+		template<typename F>
+		auto reduce_chunks(thread_pool& pool, std::size_t size, reduction mode, F partial)
+		   -> double {
+			auto sums = std::vector<double>(chunk_count(size));
+			for_each_chunk(pool, size, [&sums, &partial](std::size_t i) { sums[i] = partial(i); });
+			switch (mode) {
+			case reduction::pairwise: return pairwise_sum(sums);
+			case reduction::compensated: return compensated_sum(sums);
+			case reduction::unordered:
+			case reduction::blocked: break;
+			}
+			return std::accumulate(sums.begin(), sums.end(), 0.0);
+		}
+
+		auto check_dimensions(const_euclidean_vector_view x, const_euclidean_vector_view y) -> void {
+			if (x.dimensions() != y.dimensions()) {
+				throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+			}
+		}
+	} // namespace
+
+	auto dot(thread_pool& pool,
+	         const_euclidean_vector_view x,
+	         const_euclidean_vector_view y,
+	         reduction mode) -> double {
+		check_dimensions(x, y);
+		auto const xs = x.magnitudes();
+		auto const ys = y.magnitudes();
+		return reduce_chunks(pool, xs.size(), mode, [xs, ys, mode](std::size_t i) {
+			return kernels::dot(chunk(xs, i), chunk(ys, i), mode);
+		});
+	}
+
+	auto euclidean_norm(thread_pool& pool, const_euclidean_vector_view v, reduction mode)
+	   -> double {
+		if (v.dimensions() == 0) {
+			throw euclidean_vector_error("euclidean_vector with no dimensions does not have a norm");
+		}
+		auto const vs = v.magnitudes();
+		return std::sqrt(reduce_chunks(pool, vs.size(), mode, [vs, mode](std::size_t i) {
+			auto const c = chunk(vs, i);
+			return mode == reduction::unordered ? kernels::squared_norm(c)
+			                                    : kernels::dot(c, c, mode);
+		}));
+	}
+
+	auto add_assign(thread_pool& pool, euclidean_vector_view v, const_euclidean_vector_view w)
+	   -> void {
+		check_dimensions(v, w);
+		auto const vs = v.magnitudes();
+		auto const ws = w.magnitudes();
+		for_each_chunk(pool, vs.size(), [vs, ws](std::size_t i) {
+			kernels::axpy(1.0, chunk(ws, i), chunk(vs, i));
+		});
+	}
+
+	auto subtract_assign(thread_pool& pool, euclidean_vector_view v, const_euclidean_vector_view w)
+	   -> void {
+		check_dimensions(v, w);
+		auto const vs = v.magnitudes();
+		auto const ws = w.magnitudes();
+		for_each_chunk(pool, vs.size(), [vs, ws](std::size_t i) {
+			kernels::axpy(-1.0, chunk(ws, i), chunk(vs, i));
+		});
+	}
+
+	auto multiply_assign(thread_pool& pool, euclidean_vector_view v, double scalar) -> void {
+		auto const vs = v.magnitudes();
+		for_each_chunk(pool, vs.size(), [vs, scalar](std::size_t i) {
+			kernels::scale(scalar, chunk(vs, i));
+		});
+	}
+
+	auto divide_assign(thread_pool& pool, euclidean_vector_view v, double scalar) -> void {
+		if (scalar == 0) {
+			throw euclidean_vector_error("Invalid vector division by 0");
+		}
+		auto const vs = v.magnitudes();
+		for_each_chunk(pool, vs.size(), [vs, scalar](std::size_t i) {
+			kernels::divide(scalar, chunk(vs, i));
+		});
+	}
+} // namespace comp6771
@@ -0,0 +1,372 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_search.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+
+namespace comp6771 {
+	namespace {
+		// exact_index's batch search scans the index in blocks of about this many bytes, which
+		// stay in a typical L2 cache while every query is compared with them
+		auto constexpr block_bytes = std::size_t{1} << 18;
+
+		auto check_dimensions(std::size_t x, std::size_t y) -> void {
+			if (x != y) {
+				throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+			}
+		}
+
+		// orders neighbours by distance, then by index
+		auto closer(neighbour const& x, neighbour const& y) noexcept -> bool {
+			return x.squared_distance < y.squared_distance
+			       or (x.squared_distance == y.squared_distance and x.index < y.index);
+		}
+
+		// the k closest neighbours offered so far, kept as a max-heap so the furthest is on top
+		class top_k {
+		public:
+			// no more than `candidates` are ever offered, however large k is
+			top_k(std::size_t k, std::size_t candidates)
+			: k_{k} {
+				heap_.reserve(std::min(k, candidates));
+			}
+
+			// a candidate further away than this can't get in
+			[[nodiscard]] auto bound() const noexcept -> double {
+				if (heap_.size() < k_) {
+					return std::numeric_limits<double>::infinity();
+				}
+				// with k of zero, nothing can get in
+				if (k_ == 0) {
+					return -std::numeric_limits<double>::infinity();
+				}
+				return heap_.front().squared_distance;
+			}
+
+			auto offer(neighbour candidate) -> void {
+				if (heap_.size() < k_) {
+					heap_.push_back(candidate);
+					std::push_heap(heap_.begin(), heap_.end(), closer);
+				}
+				else if (k_ != 0 and closer(candidate, heap_.front())) {
+					std::pop_heap(heap_.begin(), heap_.end(), closer);
+					heap_.back() = candidate;
+					std::push_heap(heap_.begin(), heap_.end(), closer);
+				}
+			}
+
+			// closest first
+			[[nodiscard]] auto take() && -> std::vector<neighbour> {
+				std::sort_heap(heap_.begin(), heap_.end(), closer);
+				return std::move(heap_);
+			}
+
+		private:
+			std::size_t k_;
+			std::vector<neighbour> heap_;
+		};
+	} // namespace
+
+	auto detail::vector_rows::push_back(const_euclidean_vector_view v) -> void {
+		auto const magnitudes = v.magnitudes();
+		if (size_ == 0) {
+			dimensions_ = magnitudes.size();
+		}
+		check_dimensions(dimensions_, magnitudes.size());
+		magnitudes_.insert(magnitudes_.end(), magnitudes.begin(), magnitudes.end());
+		++size_;
+	}
+
+	//-------------------------------exact search--------------------------------------------------
+	auto exact_index::search(const_euclidean_vector_view query, std::size_t k) const
+	   -> std::vector<neighbour> {
+		if (size() == 0) {
+			return {};
+		}
+		auto const q = query.magnitudes();
+		check_dimensions(rows_.dimensions(), q.size());
+		auto best = top_k(k, size());
+		for (auto i = std::size_t{0}; i < rows_.size(); ++i) {
+			best.offer({i, kernels::squared_distance(rows_[i], q)});
+		}
+		return std::move(best).take();
+	}
+
+	auto exact_index::search(std::span<euclidean_vector const> queries, std::size_t k) const
+	   -> std::vector<std::vector<neighbour>> {
+		auto result = std::vector<std::vector<neighbour>>(queries.size());
+		if (size() == 0) {
+			return result;
+		}
+		for (auto const& query : queries) {
+			check_dimensions(rows_.dimensions(), query.magnitudes().size());
+		}
+
+		auto best = std::vector<top_k>(queries.size(), top_k(k, size()));
+		auto const row_bytes = std::max(rows_.dimensions() * sizeof(double), sizeof(double));
+		auto const block = std::max(block_bytes / row_bytes, std::size_t{1});
+		for (auto first = std::size_t{0}; first < rows_.size(); first += block) {
+			auto const last = std::min(first + block, rows_.size());
+			for (auto q = std::size_t{0}; q < queries.size(); ++q) {
+				auto const query = queries[q].magnitudes();
+				for (auto i = first; i < last; ++i) {
+					best[q].offer({i, kernels::squared_distance(rows_[i], query)});
+				}
+			}
+		}
+		std::ranges::transform(best, result.begin(), [](top_k& b) { return std::move(b).take(); });
+		return result;
+	}
+
+	auto exact_index::size() const noexcept -> std::size_t {
+		return rows_.size();
+	}
+
+	auto exact_index::dimensions() const noexcept -> int {
+		return static_cast<int>(rows_.dimensions());
+	}
+
+	//---------------------------------k-d tree----------------------------------------------------
+	auto kd_tree::build(std::size_t leaf_size) -> void {
+		order_.resize(rows_.size());
+		std::iota(order_.begin(), order_.end(), std::size_t{0});
+		if (rows_.size() != 0) {
+			build(0, rows_.size(), std::max(leaf_size, std::size_t{1}));
+		}
+	}
+
+	// builds the subtree over order_[first, last) and returns the position of its root
+	auto kd_tree::build(std::size_t first, std::size_t last, std::size_t leaf_size)
+	   -> std::size_t {
+		auto const position = nodes_.size();
+		nodes_.push_back(node{first, last});
+		if (last - first <= leaf_size) {
+			return position;
+		}
+
+		auto split_dimension = std::size_t{0};
+		auto widest = 0.0;
+		for (auto d = std::size_t{0}; d < rows_.dimensions(); ++d) {
+			auto low = std::numeric_limits<double>::infinity();
+			auto high = -std::numeric_limits<double>::infinity();
+			for (auto i = first; i < last; ++i) {
+				auto const m = rows_[order_[i]][d];
+				low = std::min(low, m);
+				high = std::max(high, m);
+			}
+			if (high - low > widest) {
+				widest = high - low;
+				split_dimension = d;
+			}
+		}
+		// every vector here is the same, so there's nothing to split on
+		if (widest == 0.0) {
+			return position;
+		}
+
+		auto const middle = first + (last - first) / 2;
+		auto const begin = order_.begin();
+		std::nth_element(begin + static_cast<std::ptrdiff_t>(first),
+		                 begin + static_cast<std::ptrdiff_t>(middle),
+		                 begin + static_cast<std::ptrdiff_t>(last),
+		                 [this, split_dimension](std::size_t x, std::size_t y) {
+			                 return rows_[x][split_dimension] < rows_[y][split_dimension];
+		                 });
+		auto const split_value = rows_[order_[middle]][split_dimension];
+		auto const left = build(first, middle, leaf_size);
+		auto const right = build(middle, last, leaf_size);
+		// nodes_ may have reallocated, so this can't hold on to a reference from before
+		auto& n = nodes_[position];
+		n.left = left;
+		n.right = right;
+		n.split_dimension = split_dimension;
+		n.split_value = split_value;
+		return position;
+	}
+
+	auto kd_tree::search(const_euclidean_vector_view query, std::size_t k) const
+	   -> std::vector<neighbour> {
+		if (size() == 0) {
+			return {};
+		}
+		auto const q = query.magnitudes();
+		check_dimensions(rows_.dimensions(), q.size());
+
+		auto best = top_k(k, size());
+		// nodes still to visit, each with a lower bound on the squared distance to anything in it
+		auto pending = std::vector<std::pair<std::size_t, double>>{{0, 0.0}};
+		while (not pending.empty()) {
+			auto const [position, lower_bound] = pending.back();
+			pending.pop_back();
+			// equal distances can still get in on a smaller index
+			if (lower_bound > best.bound()) {
+				continue;
+			}
+			auto const& n = nodes_[position];
+			if (n.left == 0) {
+				for (auto i = n.first; i < n.last; ++i) {
+					best.offer({order_[i], kernels::squared_distance(rows_[order_[i]], q)});
+				}
+				continue;
+			}
+			auto const difference = q[n.split_dimension] - n.split_value;
+			auto const near = difference < 0 ? n.left : n.right;
+			auto const far = difference < 0 ? n.right : n.left;
+			// the far side is pushed first, so the near side is searched first and tightens the
+			// bound the far side is pruned against
+			pending.emplace_back(far, std::max(lower_bound, difference * difference));
+			pending.emplace_back(near, lower_bound);
+		}
+		return std::move(best).take();
+	}
+
+	auto kd_tree::size() const noexcept -> std::size_t {
+		return rows_.size();
+	}
+
+	auto kd_tree::dimensions() const noexcept -> int {
+		return static_cast<int>(rows_.dimensions());
+	}
+
+	//---------------------------inverted file index-----------------------------------------------
+	namespace {
+		// the centroid closest to row, out of the lists centroids stored back to back
+		auto nearest_centroid(std::span<double const> row,
+		                      std::span<double const> centroids,
+		                      std::size_t lists) noexcept -> std::size_t {
+			auto const d = row.size();
+			auto nearest = std::size_t{0};
+			auto nearest_distance = std::numeric_limits<double>::infinity();
+			for (auto c = std::size_t{0}; c < lists; ++c) {
+				auto const distance = kernels::squared_distance(row, centroids.subspan(c * d, d));
+				if (distance < nearest_distance) {
+					nearest = c;
+					nearest_distance = distance;
+				}
+			}
+			return nearest;
+		}
+	} // namespace
+
+	auto ivf_index::build(ivf_options const& options) -> void {
+		auto const n = rows_.size();
+		auto const d = rows_.dimensions();
+		if (n == 0) {
+			list_offsets_ = {0};
+			return;
+		}
+		auto const default_lists = static_cast<std::size_t>(std::sqrt(static_cast<double>(n)));
+		auto const lists = std::clamp(options.lists == 0 ? default_lists : options.lists,
+		                              std::size_t{1},
+		                              n);
+
+		// Lloyd's k-means, starting from distinct vectors picked at random. A cluster that ends up
+		// empty keeps its centroid.
+		auto engine = std::mt19937_64(options.seed);
+		auto all = std::vector<std::size_t>(n);
+		std::iota(all.begin(), all.end(), std::size_t{0});
+		auto initial = std::vector<std::size_t>();
+		initial.reserve(lists);
+		std::ranges::sample(all,
+		                    std::back_inserter(initial),
+		                    static_cast<std::ptrdiff_t>(lists),
+		                    engine);
+		auto centroids = std::vector<double>();
+		centroids.reserve(lists * d);
+		for (auto const i : initial) {
+			centroids.insert(centroids.end(), rows_[i].begin(), rows_[i].end());
+		}
+
+		auto assignment = std::vector<std::size_t>(n);
+		auto const assign = [&] {
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				assignment[i] = nearest_centroid(rows_[i], centroids, lists);
+			}
+		};
+		auto sums = std::vector<double>(lists * d);
+		auto counts = std::vector<std::size_t>(lists);
+		for (auto iteration = 0; iteration < options.iterations; ++iteration) {
+			assign();
+			std::ranges::fill(sums, 0.0);
+			std::ranges::fill(counts, std::size_t{0});
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				auto const c = assignment[i];
+				kernels::axpy(1.0, rows_[i], std::span(sums).subspan(c * d, d));
+				++counts[c];
+			}
+			for (auto c = std::size_t{0}; c < lists; ++c) {
+				if (counts[c] != 0) {
+					auto const sum = std::span(sums).subspan(c * d, d);
+					kernels::scale(1.0 / static_cast<double>(counts[c]), sum);
+					std::ranges::copy(sum, centroids.begin() + static_cast<std::ptrdiff_t>(c * d));
+				}
+			}
+		}
+		assign();
+
+		// a counting sort of the vectors by cluster
+		list_offsets_.assign(lists + 1, 0);
+		for (auto const c : assignment) {
+			++list_offsets_[c + 1];
+		}
+		std::partial_sum(list_offsets_.begin(), list_offsets_.end(), list_offsets_.begin());
+		ids_.resize(n);
+		auto next = std::vector<std::size_t>(list_offsets_.begin(), list_offsets_.end() - 1);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			ids_[next[assignment[i]]++] = i;
+		}
+		auto grouped = detail::vector_rows();
+		for (auto const i : ids_) {
+			grouped.push_back(const_euclidean_vector_view(rows_[i]));
+		}
+		rows_ = std::move(grouped);
+		for (auto c = std::size_t{0}; c < lists; ++c) {
+			centroids_.push_back(const_euclidean_vector_view(std::span(centroids).subspan(c * d, d)));
+		}
+	}
+
+	auto ivf_index::search(const_euclidean_vector_view query,
+	                       std::size_t k,
+	                       std::size_t probes) const -> std::vector<neighbour> {
+		if (size() == 0) {
+			return {};
+		}
+		auto const q = query.magnitudes();
+		check_dimensions(rows_.dimensions(), q.size());
+
+		auto clusters = std::vector<neighbour>(lists());
+		for (auto c = std::size_t{0}; c < clusters.size(); ++c) {
+			clusters[c] = {c, kernels::squared_distance(centroids_[c], q)};
+		}
+		probes = std::min(probes, clusters.size());
+		auto const probed = clusters.begin() + static_cast<std::ptrdiff_t>(probes);
+		std::partial_sort(clusters.begin(), probed, clusters.end(), closer);
+
+		auto best = top_k(k, size());
+		for (auto const& cluster : std::span(clusters).first(probes)) {
+			for (auto i = list_offsets_[cluster.index]; i < list_offsets_[cluster.index + 1]; ++i) {
+				best.offer({ids_[i], kernels::squared_distance(rows_[i], q)});
+			}
+		}
+		return std::move(best).take();
+	}
+
+	auto ivf_index::size() const noexcept -> std::size_t {
+		return rows_.size();
+	}
+
+	auto ivf_index::dimensions() const noexcept -> int {
+		return static_cast<int>(rows_.dimensions());
+	}
+
+	auto ivf_index::lists() const noexcept -> std::size_t {
+		return centroids_.size();
+	}
+} // namespace comp6771
@@ -0,0 +1,184 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace comp6771::stats {
+	namespace {
+		// One thread's totals. Only that thread writes them, so an increment is a relaxed load and
+		// store rather than a read-modify-write, but they're atomic so take_snapshot() can read
+		// them from any thread.
+		struct thread_totals {
+			std::array<std::atomic<std::uint64_t>, counter_count> counters{};
+			std::array<std::atomic<std::uint64_t>, operation_count> calls{};
+			std::array<std::atomic<std::uint64_t>, operation_count> elements{};
+			std::array<std::atomic<std::uint64_t>, operation_count> nanoseconds{};
+
+			auto add_to(snapshot& s) const noexcept -> void {
+				for (auto i = std::size_t{0}; i < counter_count; ++i) {
+					s.counters[i] += counters[i].load(std::memory_order_relaxed);
+				}
+				for (auto i = std::size_t{0}; i < operation_count; ++i) {
+					s.operations[i].calls += calls[i].load(std::memory_order_relaxed);
+					s.operations[i].elements += elements[i].load(std::memory_order_relaxed);
+					s.operations[i].nanoseconds += nanoseconds[i].load(std::memory_order_relaxed);
+				}
+			}
+		};
+
+		auto add(std::atomic<std::uint64_t>& total, std::uint64_t n) noexcept -> void {
+			total.store(total.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+		}
+
+		// every live thread's totals, and the sum of those of the threads that have exited
+		class registry {
+		public:
+			auto enrol(thread_totals const* totals) -> void {
+				auto const lock = std::scoped_lock(mutex_);
+				live_.push_back(totals);
+			}
+
+			auto retire(thread_totals const* totals) noexcept -> void {
+				auto const lock = std::scoped_lock(mutex_);
+				totals->add_to(retired_);
+				std::erase(live_, totals);
+			}
+
+			auto total() -> snapshot {
+				auto const lock = std::scoped_lock(mutex_);
+				auto result = retired_;
+				for (auto const* const totals : live_) {
+					totals->add_to(result);
+				}
+				return result;
+			}
+
+		private:
+			std::mutex mutex_;
+			std::vector<thread_totals const*> live_;
+			snapshot retired_;
+		};
+
+		// Never destroyed, so that threads still running during static destruction, whose totals
+		// are retired when they exit, always have a registry to retire them to.
+		auto the_registry() -> registry& {
+			static auto* const instance = new registry();
+			return *instance;
+		}
+
+		class enrolled_totals {
+		public:
+			enrolled_totals() {
+				the_registry().enrol(&totals_);
+			}
+			enrolled_totals(enrolled_totals const&) = delete;
+			auto operator=(enrolled_totals const&) -> enrolled_totals& = delete;
+			~enrolled_totals() {
+				the_registry().retire(&totals_);
+			}
+
+			auto get() noexcept -> thread_totals& {
+				return totals_;
+			}
+
+		private:
+			thread_totals totals_;
+		};
+
+		auto this_thread() -> thread_totals& {
+			thread_local auto totals = enrolled_totals();
+			return totals.get();
+		}
+	} // namespace
+
+	auto operator-(snapshot const& later, snapshot const& earlier) noexcept -> snapshot {
+		auto result = later;
+		for (auto i = std::size_t{0}; i < counter_count; ++i) {
+			result.counters[i] -= earlier.counters[i];
+		}
+		for (auto i = std::size_t{0}; i < operation_count; ++i) {
+			result.operations[i].calls -= earlier.operations[i].calls;
+			result.operations[i].elements -= earlier.operations[i].elements;
+			result.operations[i].nanoseconds -= earlier.operations[i].nanoseconds;
+		}
+		return result;
+	}
+
+	auto take_snapshot() -> snapshot {
+		return the_registry().total();
+	}
+
+	auto name(counter c) noexcept -> std::string_view {
+		switch (c) {
+		case counter::allocations: return "allocations";
+		case counter::allocated_bytes: return "allocated_bytes";
+		case counter::deep_copies: return "deep_copies";
+		case counter::moves: return "moves";
+		case counter::dimension_mismatches: return "dimension_mismatches";
+		case counter::norm_cache_hits: return "norm_cache_hits";
+		}
+		return "unknown";
+	}
+
+	auto name(operation op) noexcept -> std::string_view {
+		switch (op) {
+		case operation::dot: return "dot";
+		case operation::euclidean_norm: return "euclidean_norm";
+		case operation::unit: return "unit";
+		case operation::add: return "add";
+		case operation::subtract: return "subtract";
+		case operation::multiply: return "multiply";
+		case operation::divide: return "divide";
+		case operation::negate: return "negate";
+		case operation::evaluate: return "evaluate";
+		case operation::axpy: return "axpy";
+		case operation::axpby: return "axpby";
+		case operation::lerp: return "lerp";
+		case operation::normalize: return "normalize";
+		case operation::scale_add: return "scale_add";
+		case operation::hadamard: return "hadamard";
+		case operation::divide_elementwise: return "divide_elementwise";
+		case operation::distance: return "distance";
+		case operation::squared_distance: return "squared_distance";
+		case operation::manhattan_distance: return "manhattan_distance";
+		case operation::cosine_similarity: return "cosine_similarity";
+		}
+		return "unknown";
+	}
+
+	auto operator<<(std::ostream& os, snapshot const& s) -> std::ostream& {
+		for (auto i = std::size_t{0}; i < counter_count; ++i) {
+			os << name(static_cast<counter>(i)) << ' ' << s.counters[i] << '\n';
+		}
+		for (auto i = std::size_t{0}; i < operation_count; ++i) {
+			auto const op = name(static_cast<operation>(i));
+			auto const& totals = s.operations[i];
+			os << op << "_calls " << totals.calls << '\n';
+			os << op << "_elements " << totals.elements << '\n';
+			os << op << "_nanoseconds " << totals.nanoseconds << '\n';
+		}
+		return os;
+	}
+
+	namespace detail {
+		auto record(counter c, std::uint64_t n) noexcept -> void {
+			add(this_thread().counters[static_cast<std::size_t>(c)], n);
+		}
+
+		auto record(operation op, std::uint64_t elements) noexcept -> void {
+			auto& totals = this_thread();
+			add(totals.calls[static_cast<std::size_t>(op)], 1);
+			add(totals.elements[static_cast<std::size_t>(op)], elements);
+		}
+
+		auto record_time(operation op, std::chrono::nanoseconds elapsed) noexcept -> void {
+			add(this_thread().nanoseconds[static_cast<std::size_t>(op)],
+			    static_cast<std::uint64_t>(elapsed.count()));
+		}
+	} // namespace detail
+} // namespace comp6771::stats
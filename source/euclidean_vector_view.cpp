@@ -0,0 +1,223 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include "comp6771/euclidean_vector_stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace comp6771 {
+	namespace {
+		auto check_dimensions(const_euclidean_vector_view x, const_euclidean_vector_view y) -> void {
+			if (x.dimensions() != y.dimensions()) {
+				throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+			}
+		}
+
+		auto check_candidates(const_euclidean_vector_view query,
+		                      std::span<euclidean_vector const> candidates,
+		                      std::span<double const> result) -> void {
+			if (result.size() != candidates.size()) {
+				throw euclidean_vector_error("Size of result does not match the number of "
+				                             "candidates");
+			}
+			for (auto const& candidate : candidates) {
+				check_dimensions(query, candidate);
+			}
+		}
+
+		auto record(stats::operation op, const_euclidean_vector_view x) noexcept
+		   -> stats::scoped_operation {
+			return stats::scoped_operation(op, x.magnitudes().size());
+		}
+
+		// a batch is one call over the magnitudes of every candidate
+		auto record(stats::operation op,
+		            const_euclidean_vector_view query,
+		            std::span<euclidean_vector const> candidates) noexcept
+		   -> stats::scoped_operation {
+			return stats::scoped_operation(op, query.magnitudes().size() * candidates.size());
+		}
+
+		// result[i] = f(query, candidates[i]), which mustn't throw for checked candidates
+		template<typename F>
+		auto transform_candidates(const_euclidean_vector_view query,
+		                          std::span<euclidean_vector const> candidates,
+		                          std::span<double> result,
+		                          F f) -> void {
+			std::ranges::transform(candidates, result.begin(), [query, f](euclidean_vector const& c) {
+				return f(query.magnitudes(), c.magnitudes());
+			});
+		}
+
+		// result[i] = f(query, candidates[i]), once every candidate has been checked
+		template<typename F>
+		auto for_each_candidate(stats::operation op,
+		                        const_euclidean_vector_view query,
+		                        std::span<euclidean_vector const> candidates,
+		                        std::span<double> result,
+		                        F f) -> void {
+			check_candidates(query, candidates, result);
+			auto const recording = record(op, query, candidates);
+			transform_candidates(query, candidates, result, f);
+		}
+
+		[[noreturn]] auto throw_zero_norm() -> void {
+			throw euclidean_vector_error("euclidean_vector with zero euclidean normal does not have "
+			                             "a unit vector");
+		}
+
+		auto cosine_similarity_of(std::span<double const> x, std::span<double const> y) -> double {
+			auto const terms = kernels::cosine(x, y);
+			if (terms.x_squared_norm == 0 or terms.y_squared_norm == 0) {
+				throw_zero_norm();
+			}
+			return terms.dot / (std::sqrt(terms.x_squared_norm) * std::sqrt(terms.y_squared_norm));
+		}
+
+		auto distance_of(std::span<double const> x, std::span<double const> y) noexcept -> double {
+			return std::sqrt(kernels::squared_distance(x, y));
+		}
+	} // namespace
+
+	auto euclidean_norm(const_euclidean_vector_view v) -> double {
+		if (v.dimensions() == 0) {
+			throw euclidean_vector_error("euclidean_vector with no dimensions does not have a norm");
+		}
+		return std::sqrt(kernels::squared_norm(v.magnitudes()));
+	}
+
+	auto unit(const_euclidean_vector_view v) -> euclidean_vector {
+		if (v.dimensions() == 0) {
+			throw euclidean_vector_error("euclidean_vector with no dimensions does not have a unit "
+			                             "vector");
+		}
+		auto const norm = euclidean_norm(v);
+		if (norm == 0) {
+			throw euclidean_vector_error("euclidean_vector with zero euclidean normal does not "
+			                             "have a unit vector");
+		}
+		return v / norm;
+	}
+
+	auto dot(const_euclidean_vector_view x, const_euclidean_vector_view y) -> double {
+		if (x.dimensions() != y.dimensions()) {
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		return kernels::dot(x.magnitudes(), y.magnitudes());
+	}
+
+	auto dot(const_euclidean_vector_view x, const_euclidean_vector_view y, reduction mode)
+	   -> double {
+		if (x.dimensions() != y.dimensions()) {
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		return kernels::dot(x.magnitudes(), y.magnitudes(), mode);
+	}
+
+	auto euclidean_norm(const_euclidean_vector_view v, reduction mode) -> double {
+		if (v.dimensions() == 0) {
+			throw euclidean_vector_error("euclidean_vector with no dimensions does not have a norm");
+		}
+		return std::sqrt(kernels::dot(v.magnitudes(), v.magnitudes(), mode));
+	}
+
+	auto distance(const_euclidean_vector_view x, const_euclidean_vector_view y) -> double {
+		check_dimensions(x, y);
+		auto const recording = record(stats::operation::distance, x);
+		return distance_of(x.magnitudes(), y.magnitudes());
+	}
+
+	auto squared_distance(const_euclidean_vector_view x, const_euclidean_vector_view y) -> double {
+		check_dimensions(x, y);
+		auto const recording = record(stats::operation::squared_distance, x);
+		return kernels::squared_distance(x.magnitudes(), y.magnitudes());
+	}
+
+	auto manhattan_distance(const_euclidean_vector_view x, const_euclidean_vector_view y)
+	   -> double {
+		check_dimensions(x, y);
+		auto const recording = record(stats::operation::manhattan_distance, x);
+		return kernels::manhattan_distance(x.magnitudes(), y.magnitudes());
+	}
+
+	auto cosine_similarity(const_euclidean_vector_view x, const_euclidean_vector_view y)
+	   -> double {
+		check_dimensions(x, y);
+		auto const recording = record(stats::operation::cosine_similarity, x);
+		return cosine_similarity_of(x.magnitudes(), y.magnitudes());
+	}
+
+	//-------------------------------batches-------------------------------------------------------
+	auto distance(const_euclidean_vector_view query, std::span<euclidean_vector const> candidates)
+	   -> std::vector<double> {
+		auto result = std::vector<double>(candidates.size());
+		distance(query, candidates, result);
+		return result;
+	}
+
+	auto distance(const_euclidean_vector_view query,
+	              std::span<euclidean_vector const> candidates,
+	              std::span<double> result) -> void {
+		for_each_candidate(stats::operation::distance, query, candidates, result, distance_of);
+	}
+
+	auto squared_distance(const_euclidean_vector_view query,
+	                      std::span<euclidean_vector const> candidates) -> std::vector<double> {
+		auto result = std::vector<double>(candidates.size());
+		squared_distance(query, candidates, result);
+		return result;
+	}
+
+	auto squared_distance(const_euclidean_vector_view query,
+	                      std::span<euclidean_vector const> candidates,
+	                      std::span<double> result) -> void {
+		for_each_candidate(stats::operation::squared_distance,
+		                   query,
+		                   candidates,
+		                   result,
+		                   kernels::squared_distance);
+	}
+
+	auto manhattan_distance(const_euclidean_vector_view query,
+	                        std::span<euclidean_vector const> candidates) -> std::vector<double> {
+		auto result = std::vector<double>(candidates.size());
+		manhattan_distance(query, candidates, result);
+		return result;
+	}
+
+	auto manhattan_distance(const_euclidean_vector_view query,
+	                        std::span<euclidean_vector const> candidates,
+	                        std::span<double> result) -> void {
+		for_each_candidate(stats::operation::manhattan_distance,
+		                   query,
+		                   candidates,
+		                   result,
+		                   kernels::manhattan_distance);
+	}
+
+	auto cosine_similarity(const_euclidean_vector_view query,
+	                       std::span<euclidean_vector const> candidates) -> std::vector<double> {
+		auto result = std::vector<double>(candidates.size());
+		cosine_similarity(query, candidates, result);
+		return result;
+	}
+
+	auto cosine_similarity(const_euclidean_vector_view query,
+	                       std::span<euclidean_vector const> candidates,
+	                       std::span<double> result) -> void {
+		check_candidates(query, candidates, result);
+		// every norm is checked before anything is written; the candidates' norms are cached
+		auto const zero_norm = [](euclidean_vector const& c) { return euclidean_norm(c) == 0; };
+		if (not candidates.empty()
+		    and (kernels::squared_norm(query.magnitudes()) == 0
+		         or std::ranges::any_of(candidates, zero_norm)))
+		{
+			throw_zero_norm();
+		}
+		auto const recording = record(stats::operation::cosine_similarity, query, candidates);
+		transform_candidates(query, candidates, result, cosine_similarity_of);
+	}
+} // namespace comp6771
@@ -0,0 +1,104 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/shared_euclidean_vector.hpp"
+
+#include <utility>
+
+namespace comp6771 {
+	namespace {
+		auto check_dimensions(int x, int y) -> void {
+			if (x != y) {
+				throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+			}
+		}
+	} // namespace
+
+	//---------------------------------constructors------------------------------------------------
+	shared_euclidean_vector::shared_euclidean_vector()
+	: buffer_{new buffer{.vector = euclidean_vector()}} {}
+
+	shared_euclidean_vector::shared_euclidean_vector(euclidean_vector&& v)
+	: buffer_{new buffer{.vector = std::move(v)}} {}
+
+	shared_euclidean_vector::shared_euclidean_vector(euclidean_vector const& v)
+	: buffer_{new buffer{.vector = v}} {}
+
+	//---------------------------------operators---------------------------------------------------
+	auto shared_euclidean_vector::operator[](int i) -> double& {
+		return detach()[i];
+	}
+
+	auto shared_euclidean_vector::operator+=(euclidean_vector const& oth)
+	   -> shared_euclidean_vector& {
+		check_dimensions(dimensions(), oth.dimensions());
+		detach() += oth;
+		return *this;
+	}
+	auto shared_euclidean_vector::operator-=(euclidean_vector const& oth)
+	   -> shared_euclidean_vector& {
+		check_dimensions(dimensions(), oth.dimensions());
+		detach() -= oth;
+		return *this;
+	}
+	// Even x += x is safe: detach() only replaces a buffer that other objects still own, so the
+	// reference to oth's magnitudes stays valid.
+	auto shared_euclidean_vector::operator+=(shared_euclidean_vector const& oth)
+	   -> shared_euclidean_vector& {
+		return *this += oth.vector();
+	}
+	auto shared_euclidean_vector::operator-=(shared_euclidean_vector const& oth)
+	   -> shared_euclidean_vector& {
+		return *this -= oth.vector();
+	}
+	auto shared_euclidean_vector::operator*=(double factor) -> shared_euclidean_vector& {
+		detach() *= factor;
+		return *this;
+	}
+	auto shared_euclidean_vector::operator/=(double divisor) -> shared_euclidean_vector& {
+		if (divisor == 0) {
+			throw euclidean_vector_error("Invalid vector division by 0");
+		}
+		detach() /= divisor;
+		return *this;
+	}
+
+	//---------------------------------Member Functions--------------------------------------------
+	auto shared_euclidean_vector::at(int i) -> double& {
+		// the const at() throws for a bad index without detaching
+		static_cast<void>(std::as_const(*this).at(i));
+		return detach().at(i);
+	}
+
+	auto shared_euclidean_vector::magnitudes() -> std::span<double> {
+		return detach().magnitudes();
+	}
+
+	auto shared_euclidean_vector::release(buffer* b) noexcept -> void {
+		// The last owner must see every other owner's reads of the magnitudes before it frees
+		// them, hence acq_rel.
+		if (b != nullptr and b->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			delete b;
+		}
+	}
+
+	auto shared_euclidean_vector::empty_vector() noexcept -> euclidean_vector const& {
+		static auto const empty = euclidean_vector(0);
+		return empty;
+	}
+
+	auto shared_euclidean_vector::detach() -> euclidean_vector& {
+		if (buffer_ == nullptr) {
+			buffer_ = new buffer{.vector = euclidean_vector(0)};
+		}
+		// Acquire pairs with release(): once the other owners are gone, their reads of the buffer
+		// happen before our writes to it.
+		else if (buffer_->references.load(std::memory_order_acquire) != 1) {
+			// the copy keeps the original's memory_resource, which copy construction wouldn't
+			auto const& shared = buffer_->vector;
+			auto* const copy = new buffer{.vector = euclidean_vector(shared, shared.get_allocator())};
+			release(std::exchange(buffer_, copy));
+		}
+		return buffer_->vector;
+	}
+} // namespace comp6771
@@ -0,0 +1,405 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/sparse_euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <span>
+#include <utility>
+
+namespace comp6771 {
+	namespace {
+		// dot gallops through the longer vector once it stores this many times more magnitudes
+		// than the shorter one: a merge costs x + y comparisons, galloping about x * log2(y / x)
+		auto constexpr galloping_ratio = std::size_t{32};
+
+		auto check_dimensions(int x, int y) -> void {
+			if (x != y) {
+				throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+			}
+		}
+
+		auto close(double l, double r) noexcept -> bool {
+			return std::abs(l - r) <= euclidean_vector::epsilon;
+		}
+
+		// position of the first index in [from, indices.size()) that is >= target
+		auto gallop(std::span<int const> indices, std::size_t from, int target) noexcept
+		   -> std::size_t {
+			auto bound = from;
+			for (auto step = std::size_t{1}; bound < indices.size() and indices[bound] < target;
+			     step *= 2) {
+				from = bound + 1;
+				bound += step;
+			}
+			auto const first = indices.begin();
+			auto const last = first + static_cast<std::ptrdiff_t>(std::min(bound, indices.size()));
+			auto const found =
+			   std::lower_bound(first + static_cast<std::ptrdiff_t>(from), last, target);
+			return static_cast<std::size_t>(found - first);
+		}
+
+		// x has far fewer stored magnitudes than y
+		auto galloping_dot(sparse_euclidean_vector const& x,
+		                   sparse_euclidean_vector const& y) noexcept -> double {
+			auto const yi = y.indices();
+			auto const yv = y.values();
+			auto const xv = x.values();
+			auto result = 0.0;
+			auto j = std::size_t{0};
+			for (auto i = std::size_t{0}; i < xv.size() and j < yi.size(); ++i) {
+				j = gallop(yi, j, x.indices()[i]);
+				if (j < yi.size() and yi[j] == x.indices()[i]) {
+					result += xv[i] * yv[j];
+					++j;
+				}
+			}
+			return result;
+		}
+
+		auto merging_dot(sparse_euclidean_vector const& x,
+		                 sparse_euclidean_vector const& y) noexcept -> double {
+			auto const xi = x.indices();
+			auto const yi = y.indices();
+			auto result = 0.0;
+			auto i = std::size_t{0};
+			auto j = std::size_t{0};
+			while (i < xi.size() and j < yi.size()) {
+				if (xi[i] == yi[j]) {
+					result += x.values()[i] * y.values()[j];
+					++i;
+					++j;
+				}
+				else if (xi[i] < yi[j]) {
+					++i;
+				}
+				else {
+					++j;
+				}
+			}
+			return result;
+		}
+	} // namespace
+
+	//---------------------------------constructors------------------------------------------------
+	sparse_euclidean_vector::sparse_euclidean_vector() noexcept
+	: sparse_euclidean_vector(0) {}
+
+	sparse_euclidean_vector::sparse_euclidean_vector(int dimensions,
+	                                                 allocator_type const& alloc) noexcept
+	: dimensions_{dimensions}
+	, indices_(alloc)
+	, values_(alloc) {}
+
+	sparse_euclidean_vector::sparse_euclidean_vector(int dimensions,
+	                                                 std::span<int const> indices,
+	                                                 std::span<double const> values,
+	                                                 allocator_type const& alloc)
+	: dimensions_{dimensions}
+	, indices_(indices.begin(), indices.end(), alloc)
+	, values_(values.begin(), values.end(), alloc) {
+		if (indices.size() != values.size()) {
+			throw euclidean_vector_error("Dimensions of LHS(X) and RHS(Y) do not match");
+		}
+		if (not indices.empty() and (indices.front() < 0 or indices.back() >= dimensions)) {
+			throw euclidean_vector_error("Index X is not valid for this euclidean_vector object");
+		}
+		if (std::adjacent_find(indices.begin(), indices.end(), std::greater_equal<>())
+		    != indices.end()) {
+			throw euclidean_vector_error("Indices of a sparse_euclidean_vector must be strictly "
+			                             "increasing");
+		}
+	}
+
+	sparse_euclidean_vector::sparse_euclidean_vector(const_euclidean_vector_view v,
+	                                                 allocator_type const& alloc)
+	: sparse_euclidean_vector(v.dimensions(), alloc) {
+		auto const magnitudes = v.magnitudes();
+		auto const count = std::ranges::count_if(magnitudes, [](double m) { return m != 0.0; });
+		indices_.reserve(static_cast<std::size_t>(count));
+		values_.reserve(static_cast<std::size_t>(count));
+		for (auto i = std::size_t{0}; i < magnitudes.size(); ++i) {
+			if (magnitudes[i] != 0.0) {
+				indices_.push_back(static_cast<int>(i));
+				values_.push_back(magnitudes[i]);
+			}
+		}
+	}
+
+	sparse_euclidean_vector::sparse_euclidean_vector(sparse_euclidean_vector const& orig)
+	: sparse_euclidean_vector(orig, allocator_type()) {}
+
+	sparse_euclidean_vector::sparse_euclidean_vector(sparse_euclidean_vector const& orig,
+	                                                 allocator_type const& alloc)
+	: dimensions_{orig.dimensions_}
+	, indices_(orig.indices_, alloc)
+	, values_(orig.values_, alloc) {}
+
+	sparse_euclidean_vector::sparse_euclidean_vector(sparse_euclidean_vector&& orig) noexcept
+	: dimensions_{std::exchange(orig.dimensions_, 0)}
+	, indices_(std::move(orig.indices_))
+	, values_(std::move(orig.values_)) {}
+
+	//--------------------------------destructor---------------------------------------------------
+	sparse_euclidean_vector::~sparse_euclidean_vector() = default;
+
+	//---------------------------------operators---------------------------------------------------
+	auto sparse_euclidean_vector::operator=(sparse_euclidean_vector const&)
+	   -> sparse_euclidean_vector& = default;
+
+	auto sparse_euclidean_vector::operator=(sparse_euclidean_vector&& oth)
+	   -> sparse_euclidean_vector& {
+		if (this == &oth) {
+			return *this;
+		}
+		dimensions_ = std::exchange(oth.dimensions_, 0);
+		indices_ = std::move(oth.indices_);
+		values_ = std::move(oth.values_);
+		oth.indices_.clear();
+		oth.values_.clear();
+		return *this;
+	}
+
+	auto sparse_euclidean_vector::operator[](int i) const noexcept -> double {
+		auto const found = std::lower_bound(indices_.begin(), indices_.end(), i);
+		if (found == indices_.end() or *found != i) {
+			return 0.0;
+		}
+		return values_[static_cast<std::size_t>(found - indices_.begin())];
+	}
+
+	auto sparse_euclidean_vector::operator+=(sparse_euclidean_vector const& oth)
+	   -> sparse_euclidean_vector& {
+		merge(oth, 1.0);
+		return *this;
+	}
+
+	auto sparse_euclidean_vector::operator-=(sparse_euclidean_vector const& oth)
+	   -> sparse_euclidean_vector& {
+		merge(oth, -1.0);
+		return *this;
+	}
+
+	auto sparse_euclidean_vector::operator*=(double factor) noexcept -> sparse_euclidean_vector& {
+		kernels::scale(factor, values_);
+		return *this;
+	}
+
+	auto sparse_euclidean_vector::operator/=(double divisor) -> sparse_euclidean_vector& {
+		if (divisor == 0) {
+			throw euclidean_vector_error("Invalid vector division by 0");
+		}
+		kernels::divide(divisor, values_);
+		return *this;
+	}
+
+	sparse_euclidean_vector::operator euclidean_vector() const {
+		auto result = euclidean_vector(dimensions_);
+		auto const magnitudes = result.magnitudes();
+		for (auto k = std::size_t{0}; k < indices_.size(); ++k) {
+			magnitudes[static_cast<std::size_t>(indices_[k])] = values_[k];
+		}
+		return result;
+	}
+
+	//-------------------------------member functions----------------------------------------------
+	auto sparse_euclidean_vector::at(int i) const -> double {
+		if (i < 0 or i >= dimensions_) {
+			throw euclidean_vector_error("Index X is not valid for this euclidean_vector object");
+		}
+		return (*this)[i];
+	}
+
+	auto sparse_euclidean_vector::dimensions() const noexcept -> int {
+		return dimensions_;
+	}
+
+	auto sparse_euclidean_vector::non_zeros() const noexcept -> int {
+		return static_cast<int>(indices_.size());
+	}
+
+	auto sparse_euclidean_vector::indices() const noexcept -> std::span<int const> {
+		return indices_;
+	}
+
+	auto sparse_euclidean_vector::values() noexcept -> std::span<double> {
+		return values_;
+	}
+
+	auto sparse_euclidean_vector::values() const noexcept -> std::span<double const> {
+		return values_;
+	}
+
+	auto sparse_euclidean_vector::get_allocator() const noexcept -> allocator_type {
+		return values_.get_allocator();
+	}
+
+	// Counts the union of the two index arrays, grows to that size, and then merges from the back,
+	// so that every element is written after it has been read and no scratch storage is needed.
+	auto sparse_euclidean_vector::merge(sparse_euclidean_vector const& oth, double alpha) -> void {
+		check_dimensions(dimensions_, oth.dimensions_);
+		if (indices_ == oth.indices_) {
+			kernels::axpy(alpha, oth.values_, values_);
+			return;
+		}
+
+		auto common = std::size_t{0};
+		for (auto i = std::size_t{0}, j = std::size_t{0};
+		     i < indices_.size() and j < oth.indices_.size();) {
+			if (indices_[i] == oth.indices_[j]) {
+				++common;
+				++i;
+				++j;
+			}
+			else if (indices_[i] < oth.indices_[j]) {
+				++i;
+			}
+			else {
+				++j;
+			}
+		}
+
+		auto i = indices_.size();
+		auto j = oth.indices_.size();
+		auto k = i + j - common;
+		indices_.resize(k);
+		values_.resize(k);
+		// once oth is used up, the rest of *this is already where it belongs
+		while (j > 0) {
+			--k;
+			if (i > 0 and indices_[i - 1] > oth.indices_[j - 1]) {
+				--i;
+				indices_[k] = indices_[i];
+				values_[k] = values_[i];
+			}
+			else if (i > 0 and indices_[i - 1] == oth.indices_[j - 1]) {
+				--i;
+				--j;
+				indices_[k] = indices_[i];
+				values_[k] = values_[i] + alpha * oth.values_[j];
+			}
+			else {
+				--j;
+				indices_[k] = oth.indices_[j];
+				values_[k] = alpha * oth.values_[j];
+			}
+		}
+	}
+
+	//----------------------------------friends----------------------------------------------------
+	auto
+	operator==(sparse_euclidean_vector const& lhs, sparse_euclidean_vector const& rhs) noexcept
+	   -> bool {
+		if (lhs.dimensions_ != rhs.dimensions_) {
+			return false;
+		}
+		auto i = std::size_t{0};
+		auto j = std::size_t{0};
+		while (i < lhs.indices_.size() or j < rhs.indices_.size()) {
+			auto const l = i < lhs.indices_.size() ? lhs.indices_[i] : lhs.dimensions_;
+			auto const r = j < rhs.indices_.size() ? rhs.indices_[j] : rhs.dimensions_;
+			auto const l_value = l <= r ? lhs.values_[i++] : 0.0;
+			auto const r_value = r <= l ? rhs.values_[j++] : 0.0;
+			if (not close(l_value, r_value)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	auto operator==(sparse_euclidean_vector const& lhs, const_euclidean_vector_view rhs) noexcept
+	   -> bool {
+		if (lhs.dimensions_ != rhs.dimensions()) {
+			return false;
+		}
+		auto k = std::size_t{0};
+		for (auto i = 0; i < rhs.dimensions(); ++i) {
+			auto const stored = k < lhs.indices_.size() and lhs.indices_[k] == i;
+			if (not close(stored ? lhs.values_[k++] : 0.0, rhs[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//-------------------------------Utility functions---------------------------------------------
+	auto euclidean_norm(sparse_euclidean_vector const& v) -> double {
+		if (v.dimensions() == 0) {
+			throw euclidean_vector_error("euclidean_vector with no dimensions does not have a norm");
+		}
+		return std::sqrt(kernels::squared_norm(v.values()));
+	}
+
+	auto dot(sparse_euclidean_vector const& x, sparse_euclidean_vector const& y) -> double {
+		check_dimensions(x.dimensions(), y.dimensions());
+		auto const x_size = x.indices().size();
+		auto const y_size = y.indices().size();
+		if (x_size * galloping_ratio < y_size) {
+			return galloping_dot(x, y);
+		}
+		if (y_size * galloping_ratio < x_size) {
+			return galloping_dot(y, x);
+		}
+		return merging_dot(x, y);
+	}
+
+	// The loads from y are scattered, so four independent accumulators keep several of them in
+	// flight at once instead of waiting on each one in turn.
+	auto dot(sparse_euclidean_vector const& x, const_euclidean_vector_view y) -> double {
+		check_dimensions(x.dimensions(), y.dimensions());
+		auto const indices = x.indices();
+		auto const values = x.values();
+		auto const* const magnitudes = y.data();
+		auto sums = std::array<double, 4>{};
+		auto k = std::size_t{0};
+		for (; k + 4 <= indices.size(); k += 4) {
+			for (auto lane = std::size_t{0}; lane < 4; ++lane) {
+				sums[lane] += values[k + lane] * magnitudes[indices[k + lane]];
+			}
+		}
+		for (; k < indices.size(); ++k) {
+			sums[0] += values[k] * magnitudes[indices[k]];
+		}
+		return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+	}
+
+	auto dot(const_euclidean_vector_view x, sparse_euclidean_vector const& y) -> double {
+		return dot(y, x);
+	}
+
+	auto operator+=(euclidean_vector& v, sparse_euclidean_vector const& w) -> euclidean_vector& {
+		euclidean_vector_view(v) += w;
+		return v;
+	}
+
+	auto operator-=(euclidean_vector& v, sparse_euclidean_vector const& w) -> euclidean_vector& {
+		euclidean_vector_view(v) -= w;
+		return v;
+	}
+
+	auto operator+=(euclidean_vector_view v, sparse_euclidean_vector const& w)
+	   -> euclidean_vector_view {
+		check_dimensions(v.dimensions(), w.dimensions());
+		auto const indices = w.indices();
+		auto const values = w.values();
+		for (auto k = std::size_t{0}; k < indices.size(); ++k) {
+			v[indices[k]] += values[k];
+		}
+		return v;
+	}
+
+	auto operator-=(euclidean_vector_view v, sparse_euclidean_vector const& w)
+	   -> euclidean_vector_view {
+		check_dimensions(v.dimensions(), w.dimensions());
+		auto const indices = w.indices();
+		auto const values = w.values();
+		for (auto k = std::size_t{0}; k < indices.size(); ++k) {
+			v[indices[k]] -= values[k];
+		}
+		return v;
+	}
+} // namespace comp6771
@@ -0,0 +1,164 @@
+// Copyright (c) Christopher Di Bella.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+#include "comp6771/thread_pool.hpp"
+
+#include <algorithm>
+
+namespace comp6771 {
+	namespace {
+		// set on pool threads, and on a caller while it runs a loop, so that nested loops run
+		// serially instead of waiting on a pool that is busy with their parent
+		thread_local auto inside_loop = false;
+	} // namespace
+
+	thread_pool::thread_pool()
+	: thread_pool(std::max(1, static_cast<int>(std::thread::hardware_concurrency()))) {}
+
+	thread_pool::thread_pool(int threads)
+	: deques_{std::make_unique<work_deque[]>(static_cast<std::size_t>(std::max(threads, 1)))} {
+		auto const workers = static_cast<std::size_t>(std::max(threads, 1) - 1);
+		workers_.reserve(workers);
+		for (auto i = std::size_t{0}; i < workers; ++i) {
+			workers_.emplace_back([this, i] { worker_main(i + 1); });
+		}
+	}
+
+	thread_pool::~thread_pool() {
+		{
+			auto const lock = std::scoped_lock(mutex_);
+			stopping_ = true;
+		}
+		wake_.notify_all();
+		for (auto& worker : workers_) {
+			worker.join();
+		}
+	}
+
+	auto thread_pool::size() const noexcept -> int {
+		return static_cast<int>(workers_.size()) + 1;
+	}
+
+	auto thread_pool::shared() -> thread_pool& {
+		static auto pool = thread_pool();
+		return pool;
+	}
+
+	auto thread_pool::run(std::size_t count, task_function body, void* context) -> void {
+		if (count == 0) {
+			return;
+		}
+		if (workers_.empty() or count == 1 or inside_loop) {
+			for (auto i = std::size_t{0}; i < count; ++i) {
+				body(context, i);
+			}
+			return;
+		}
+
+		auto const submit = std::scoped_lock(submit_mutex_);
+		auto l = loop{body, context};
+		auto const threads = static_cast<std::size_t>(size());
+		for (auto i = std::size_t{0}; i < threads; ++i) {
+			deques_[i].front = count * i / threads;
+			deques_[i].back = count * (i + 1) / threads;
+		}
+		{
+			auto const lock = std::scoped_lock(mutex_);
+			loop_ = &l;
+			++generation_;
+		}
+		wake_.notify_all();
+
+		inside_loop = true;
+		work_on(l, 0);
+		inside_loop = false;
+
+		// l lives on our stack, so wait until no worker can still be touching it
+		{
+			auto lock = std::unique_lock(mutex_);
+			idle_.wait(lock, [this] { return active_ == 0; });
+			loop_ = nullptr;
+		}
+		if (l.error) {
+			std::rethrow_exception(l.error);
+		}
+	}
+
+	auto thread_pool::work_on(loop& l, std::size_t self) noexcept -> void {
+		for (auto i = take(self); i or (i = steal(self)); i = take(self)) {
+			if (l.failed.load(std::memory_order_relaxed)) {
+				return;
+			}
+			try {
+				l.body(l.context, *i);
+			} catch (...) {
+				auto const lock = std::scoped_lock(l.error_mutex);
+				if (not l.error) {
+					l.error = std::current_exception();
+				}
+				l.failed.store(true, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	auto thread_pool::take(std::size_t self) noexcept -> std::optional<std::size_t> {
+		auto& deque = deques_[self];
+		auto const lock = std::scoped_lock(deque.mutex);
+		if (deque.front == deque.back) {
+			return std::nullopt;
+		}
+		return deque.front++;
+	}
+
+	// Loop bodies never add work, so once every deque is empty the loop is finished; a thread
+	// that finds nothing to steal can stop.
+	auto thread_pool::steal(std::size_t self) noexcept -> std::optional<std::size_t> {
+		auto const threads = static_cast<std::size_t>(size());
+		for (auto offset = std::size_t{1}; offset < threads; ++offset) {
+			auto& victim = deques_[(self + offset) % threads];
+			auto first = std::size_t{0};
+			auto last = std::size_t{0};
+			{
+				auto const lock = std::scoped_lock(victim.mutex);
+				if (victim.front == victim.back) {
+					continue;
+				}
+				first = victim.front + (victim.back - victim.front) / 2;
+				last = victim.back;
+				victim.back = first;
+			}
+			// run the first stolen index now, and leave the rest where others can steal them back
+			auto& deque = deques_[self];
+			auto const lock = std::scoped_lock(deque.mutex);
+			deque.front = first + 1;
+			deque.back = last;
+			return first;
+		}
+		return std::nullopt;
+	}
+
+	auto thread_pool::worker_main(std::size_t self) -> void {
+		inside_loop = true;
+		auto seen = std::size_t{0};
+		auto lock = std::unique_lock(mutex_);
+		for (;;) {
+			wake_.wait(lock, [this, seen] { return stopping_ or generation_ != seen; });
+			if (stopping_) {
+				return;
+			}
+			seen = generation_;
+			// the loop may already have finished and been retired by the time we wake up
+			if (loop_ == nullptr) {
+				continue;
+			}
+			auto& l = *loop_;
+			++active_;
+			lock.unlock();
+			work_on(l, self);
+			lock.lock();
+			if (--active_ == 0) {
+				idle_.notify_all();
+			}
+		}
+	}
+} // namespace comp6771
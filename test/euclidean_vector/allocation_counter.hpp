@@ -0,0 +1,108 @@
+#ifndef COMP6771_TEST_ALLOCATION_COUNTER_HPP
+#define COMP6771_TEST_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions so that tests can count heap allocations. Include this
+// header in exactly one translation unit of a test executable.
+namespace comp6771::test {
+	inline auto allocations = std::size_t{0};
+
+	// counts the allocations made during its lifetime
+	class allocation_counter {
+	public:
+		allocation_counter() noexcept
+		: start_{allocations} {}
+
+		[[nodiscard]] auto count() const noexcept -> std::size_t {
+			return allocations - start_;
+		}
+
+	private:
+		std::size_t start_;
+	};
+} // namespace comp6771::test
+
+auto operator new(std::size_t size) -> void* {
+	++comp6771::test::allocations;
+	if (auto* p = std::malloc(size == 0 ? 1 : size)) { // NOLINT(cppcoreguidelines-no-malloc)
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+auto operator new[](std::size_t size) -> void* {
+	return ::operator new(size);
+}
+
+// Catch allocates through the nothrow overloads, which must free through the same functions
+auto operator new(std::size_t size, std::nothrow_t const&) noexcept -> void* {
+	try {
+		return ::operator new(size);
+	} catch (std::bad_alloc const&) {
+		return nullptr;
+	}
+}
+
+auto operator new[](std::size_t size, std::nothrow_t const& tag) noexcept -> void* {
+	return ::operator new(size, tag);
+}
+
+auto operator delete(void* p) noexcept -> void {
+	std::free(p); // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+auto operator delete[](void* p) noexcept -> void {
+	::operator delete(p);
+}
+
+auto operator delete(void* p, std::size_t) noexcept -> void {
+	::operator delete(p);
+}
+
+auto operator delete[](void* p, std::size_t) noexcept -> void {
+	::operator delete(p);
+}
+
+auto operator delete(void* p, std::nothrow_t const&) noexcept -> void {
+	::operator delete(p);
+}
+
+auto operator delete[](void* p, std::nothrow_t const&) noexcept -> void {
+	::operator delete(p);
+}
+
+// std::pmr::new_delete_resource() allocates through the aligned overloads
+auto operator new(std::size_t size, std::align_val_t alignment) -> void* {
+	++comp6771::test::allocations;
+	auto const align = static_cast<std::size_t>(alignment);
+	auto const rounded = (size + align - 1) / align * align;
+	if (auto* p = std::aligned_alloc(align, rounded == 0 ? align : rounded)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment) -> void* {
+	return ::operator new(size, alignment);
+}
+
+auto operator delete(void* p, std::align_val_t) noexcept -> void {
+	std::free(p); // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+auto operator delete[](void* p, std::align_val_t alignment) noexcept -> void {
+	::operator delete(p, alignment);
+}
+
+auto operator delete(void* p, std::size_t, std::align_val_t alignment) noexcept -> void {
+	::operator delete(p, alignment);
+}
+
+auto operator delete[](void* p, std::size_t, std::align_val_t alignment) noexcept -> void {
+	::operator delete(p, alignment);
+}
+
+#endif // COMP6771_TEST_ALLOCATION_COUNTER_HPP
@@ -0,0 +1,99 @@
+#include "comp6771/compact_euclidean_vector.hpp"
+
+#include "vector_factory.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace {
+	using comp6771::test::make_vector;
+
+	// how far a magnitude m can be from the original after conversion to v's storage: half a unit
+	// in the last place, or half a quantization step
+	template<typename T>
+	auto tolerance(comp6771::compact_euclidean_vector<T> const& v, double m) -> double {
+		if constexpr (std::same_as<T, std::int8_t>) {
+			return v.scale() / 2;
+		}
+		else {
+			auto const significant_bits = std::same_as<T, float> ? 24 : 8;
+			return std::abs(m) * std::ldexp(1.0, -significant_bits);
+		}
+	}
+} // namespace
+
+TEMPLATE_TEST_CASE("compact_euclidean_vector conversions",
+                   "",
+                   float,
+                   comp6771::bfloat16,
+                   std::int8_t) {
+	auto const original = make_vector(100, 0.0);
+	auto const compact = comp6771::compact_euclidean_vector<TestType>(original);
+	REQUIRE(compact.dimensions() == 100);
+	auto const widened = static_cast<comp6771::euclidean_vector>(compact);
+	for (auto i = 0; i < original.dimensions(); ++i) {
+		CHECK(std::abs(widened[i] - original[i]) <= tolerance(compact, original[i]));
+		CHECK(compact.at(i) == widened[i]);
+	}
+	CHECK(comp6771::compact_euclidean_vector<TestType>(widened) == compact);
+	CHECK_THROWS_MATCHES(compact.at(100),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Index X is not valid for this "
+	                                              "euclidean_vector object"));
+
+	auto moved = compact;
+	auto const taken = std::move(moved);
+	CHECK(taken == compact);
+	CHECK(moved.dimensions() == 0); // NOLINT(bugprone-use-after-move)
+}
+
+TEMPLATE_TEST_CASE("compact_euclidean_vector dot and norm accumulate in double",
+                   "",
+                   float,
+                   comp6771::bfloat16,
+                   std::int8_t) {
+	// long enough for every SIMD body and for more than one block of the int8 kernels
+	auto const dimensions = GENERATE(1, 7, 33, 70'000);
+	auto const x = comp6771::compact_euclidean_vector<TestType>(make_vector(dimensions, 0.0));
+	auto const y = comp6771::compact_euclidean_vector<TestType>(make_vector(dimensions, 1.0));
+	auto const wide_x = static_cast<comp6771::euclidean_vector>(x);
+	auto const wide_y = static_cast<comp6771::euclidean_vector>(y);
+
+	// the only error is in the conversion, so this is the dense result on the widened values
+	CHECK(comp6771::dot(x, y) == Approx(comp6771::dot(wide_x, wide_y)).epsilon(1e-12));
+	CHECK(comp6771::euclidean_norm(x)
+	      == Approx(comp6771::euclidean_norm(wide_x)).epsilon(1e-12));
+
+	CHECK_THROWS_MATCHES(comp6771::dot(x, comp6771::compact_euclidean_vector<TestType>()),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not match"));
+	CHECK_THROWS_MATCHES(comp6771::euclidean_norm(comp6771::compact_euclidean_vector<TestType>()),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("euclidean_vector with no dimensions does not "
+	                                              "have a norm"));
+}
+
+TEST_CASE("bfloat16 rounds to nearest, ties to even") {
+	using comp6771::bfloat16;
+	CHECK(static_cast<float>(bfloat16(1.0F)) == 1.0F);
+	// 1 + 2^-8 is halfway between 1 and 1 + 2^-7, and rounds to the even one
+	CHECK(static_cast<float>(bfloat16(1.0F + 0x1p-8F)) == 1.0F);
+	CHECK(static_cast<float>(bfloat16(1.0F + 0x1p-8F + 0x1p-12F)) == 1.0F + 0x1p-7F);
+	CHECK(std::isinf(static_cast<float>(bfloat16(std::numeric_limits<float>::infinity()))));
+	CHECK(std::isnan(static_cast<float>(bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST_CASE("int8_euclidean_vector quantizes against the largest magnitude") {
+	auto const v = comp6771::int8_euclidean_vector(comp6771::euclidean_vector{-63.5, 32.25, 0.0});
+	CHECK(v.scale() == 0.5);
+	CHECK(v.elements()[0] == -127);
+	CHECK(v.elements()[1] == 65); // 64.5 rounds away from zero
+	CHECK(v.elements()[2] == 0);
+
+	auto const zeros = comp6771::int8_euclidean_vector(comp6771::euclidean_vector(4));
+	CHECK(zeros.scale() == 1.0);
+	CHECK(comp6771::euclidean_norm(zeros) == 0.0);
+}
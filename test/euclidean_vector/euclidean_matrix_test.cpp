@@ -0,0 +1,251 @@
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector_memory.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+	auto is_aligned(void const* p) -> bool {
+		return reinterpret_cast<std::uintptr_t>(p) % comp6771::euclidean_matrix::storage_alignment
+		       == 0;
+	}
+
+	// rows {1, 2, 3}, {4, 5, 6}, {0, 3, 4}, {2, 2, 1}
+	auto make_vectors() -> std::vector<comp6771::euclidean_vector> {
+		return {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}, {0.0, 3.0, 4.0}, {2.0, 2.0, 1.0}};
+	}
+} // namespace
+
+TEST_CASE("euclidean_matrix construction") {
+	auto const layout = GENERATE(comp6771::matrix_layout::row_major,
+	                             comp6771::matrix_layout::column_major);
+
+	SECTION("fill") {
+		auto const m = comp6771::euclidean_matrix(5, 3, 1.5, layout);
+		CHECK(m.rows() == 5);
+		CHECK(m.dimensions() == 3);
+		CHECK(m.layout() == layout);
+		CHECK(m.stride() == 8); // padded to a cache line
+		for (auto i = 0; i < m.rows(); ++i) {
+			CHECK(m.get_row(i) == comp6771::euclidean_vector(3, 1.5));
+		}
+	}
+
+	SECTION("from vectors") {
+		auto const vectors = make_vectors();
+		auto const m = comp6771::euclidean_matrix(vectors, layout);
+		REQUIRE(m.rows() == 4);
+		CHECK(m(1, 2) == 6.0);
+		CHECK(m(3, 0) == 2.0);
+		for (auto i = 0; i < m.rows(); ++i) {
+			CHECK(m.get_row(i) == vectors[static_cast<std::size_t>(i)]);
+		}
+
+		auto mismatched = make_vectors();
+		mismatched.emplace_back(2);
+		CHECK_THROWS_MATCHES(comp6771::euclidean_matrix(mismatched, layout),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not "
+		                                              "match"));
+	}
+
+	SECTION("copy and move") {
+		auto m1 = comp6771::euclidean_matrix(make_vectors(), layout);
+		auto const m2 = m1;
+		CHECK(m2.get_row(1) == comp6771::euclidean_vector{4.0, 5.0, 6.0});
+
+		auto m3 = std::move(m1);
+		CHECK(m3.get_row(2) == comp6771::euclidean_vector{0.0, 3.0, 4.0});
+		CHECK(m1.rows() == 0); // NOLINT(bugprone-use-after-move)
+
+		m1 = m3;
+		CHECK(m1.get_row(3) == comp6771::euclidean_vector{2.0, 2.0, 1.0});
+		m3 = comp6771::euclidean_matrix(1, 2, 7.0, layout);
+		CHECK(m3.get_row(0) == comp6771::euclidean_vector{7.0, 7.0});
+	}
+
+	SECTION("through a memory resource") {
+		auto pool = comp6771::pmr::pool_resource();
+		auto const m = comp6771::euclidean_matrix(100, 7, 1.0, layout, &pool);
+		CHECK(m.get_allocator().resource() == &pool);
+		CHECK(m.get_row(99) == comp6771::euclidean_vector(7, 1.0));
+	}
+}
+
+TEST_CASE("euclidean_matrix rows and columns") {
+	auto const vectors = make_vectors();
+
+	SECTION("row-major rows are aligned views") {
+		auto m = comp6771::euclidean_matrix(vectors);
+		for (auto i = 0; i < m.rows(); ++i) {
+			CHECK(is_aligned(m.row(i).data()));
+			CHECK(m.row(i) == vectors[static_cast<std::size_t>(i)]);
+		}
+		m.row(1) += comp6771::euclidean_vector{1.0, 1.0, 1.0};
+		CHECK(m(1, 0) == 5.0);
+		CHECK(comp6771::dot(m.row(0), vectors[0]) == Approx(14.0));
+		CHECK_THROWS_MATCHES(m.column(0),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Columns of a row-major euclidean_matrix are "
+		                                              "not contiguous"));
+		CHECK_THROWS_MATCHES(m.row(4),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Index X is not valid for this "
+		                                              "euclidean_vector object"));
+	}
+
+	SECTION("column-major columns are aligned views") {
+		auto m = comp6771::euclidean_matrix(vectors, comp6771::matrix_layout::column_major);
+		CHECK(is_aligned(m.column(2).data()));
+		CHECK(m.column(2) == comp6771::euclidean_vector{3.0, 6.0, 4.0, 1.0});
+		m.column(0) *= 2.0;
+		CHECK(m.get_row(1) == comp6771::euclidean_vector{8.0, 5.0, 6.0});
+		CHECK_THROWS_MATCHES(m.row(0),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Rows of a column-major euclidean_matrix are "
+		                                              "not contiguous"));
+	}
+
+	SECTION("set_row works in either layout") {
+		auto const layout = GENERATE(comp6771::matrix_layout::row_major,
+		                             comp6771::matrix_layout::column_major);
+		auto m = comp6771::euclidean_matrix(2, 3, 0.0, layout);
+		m.set_row(1, vectors[1]);
+		CHECK(m.get_row(1) == vectors[1]);
+		CHECK(m.get_row(0) == comp6771::euclidean_vector(3));
+		CHECK_THROWS_AS(m.set_row(0, comp6771::euclidean_vector(2)),
+		                comp6771::euclidean_vector_error);
+	}
+}
+
+TEST_CASE("euclidean_matrix batched utility functions") {
+	auto const layout = GENERATE(comp6771::matrix_layout::row_major,
+	                             comp6771::matrix_layout::column_major);
+	auto const vectors = make_vectors();
+	auto const m = comp6771::euclidean_matrix(vectors, layout);
+
+	SECTION("dot") {
+		auto const query = comp6771::euclidean_vector{1.0, 0.0, 2.0};
+		auto const result = comp6771::dot(m, query);
+		REQUIRE(result.size() == vectors.size());
+		for (auto i = std::size_t{0}; i < vectors.size(); ++i) {
+			CHECK(result[i] == Approx(comp6771::dot(vectors[i], query)));
+		}
+		CHECK_THROWS_MATCHES(comp6771::dot(m, comp6771::euclidean_vector(2)),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not "
+		                                              "match"));
+	}
+
+	SECTION("euclidean_norm") {
+		auto const result = comp6771::euclidean_norm(m);
+		REQUIRE(result.size() == vectors.size());
+		for (auto i = std::size_t{0}; i < vectors.size(); ++i) {
+			CHECK(result[i] == Approx(comp6771::euclidean_norm(vectors[i])));
+		}
+	}
+
+	SECTION("unit") {
+		auto const result = comp6771::unit(m);
+		CHECK(result.layout() == layout);
+		for (auto i = 0; i < m.rows(); ++i) {
+			CHECK(result.get_row(i) == comp6771::unit(vectors[static_cast<std::size_t>(i)]));
+		}
+
+		auto zero_row = make_vectors();
+		zero_row[2] = comp6771::euclidean_vector(3);
+		CHECK_THROWS_MATCHES(comp6771::unit(comp6771::euclidean_matrix(zero_row, layout)),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("euclidean_vector with zero euclidean normal "
+		                                              "does not have a unit vector"));
+	}
+}
+
+TEST_CASE("euclidean_matrix one-to-many and many-to-many scoring") {
+	auto const layout = GENERATE(comp6771::matrix_layout::row_major,
+	                             comp6771::matrix_layout::column_major);
+	// 11 rows covers whole blocks of four and a remainder; 1500 dimensions spans two query blocks
+	auto const dimensions = GENERATE(3, 1500);
+	auto vectors = std::vector<comp6771::euclidean_vector>();
+	for (auto i = 0; i < 11; ++i) {
+		vectors.emplace_back(dimensions, [i](int j) { return std::sin(i * 7 + j); });
+	}
+	auto const m = comp6771::euclidean_matrix(vectors, layout);
+	auto const query = comp6771::euclidean_vector(dimensions, [](int j) { return std::cos(j); });
+
+	SECTION("dot into a caller's buffer") {
+		auto result = std::vector<double>(vectors.size(), 42.0);
+		comp6771::dot(m, query, result);
+		for (auto i = std::size_t{0}; i < vectors.size(); ++i) {
+			CHECK(result[i] == Approx(comp6771::dot(vectors[i], query)).margin(1e-9));
+		}
+		result.pop_back();
+		CHECK_THROWS_MATCHES(comp6771::dot(m, query, result),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not "
+		                                              "match"));
+	}
+
+	SECTION("matrix-matrix dot") {
+		auto const query_layout = GENERATE(comp6771::matrix_layout::row_major,
+		                                   comp6771::matrix_layout::column_major);
+		auto const queries = comp6771::euclidean_matrix(std::span(vectors).first(5), query_layout);
+		auto const scores = comp6771::dot(queries, m);
+		REQUIRE(scores.rows() == 5);
+		REQUIRE(scores.dimensions() == 11);
+		CHECK(scores.layout() == comp6771::matrix_layout::row_major);
+		for (auto i = 0; i < scores.rows(); ++i) {
+			for (auto j = 0; j < scores.dimensions(); ++j) {
+				auto const expected = comp6771::dot(vectors[static_cast<std::size_t>(i)],
+				                                    vectors[static_cast<std::size_t>(j)]);
+				CHECK(scores(i, j) == Approx(expected).margin(1e-9));
+			}
+		}
+		CHECK_THROWS_AS(comp6771::dot(queries, comp6771::euclidean_matrix(2, dimensions + 1)),
+		                comp6771::euclidean_vector_error);
+	}
+
+	SECTION("matrix-matrix dot of vectors with no dimensions") {
+		auto const query_layout = GENERATE(comp6771::matrix_layout::row_major,
+		                                   comp6771::matrix_layout::column_major);
+		auto const queries = comp6771::euclidean_matrix(3, 0, 0.0, query_layout);
+		auto const candidates = comp6771::euclidean_matrix(2, 0, 0.0, layout);
+		auto const scores = comp6771::dot(queries, candidates);
+		REQUIRE(scores.rows() == 3);
+		REQUIRE(scores.dimensions() == 2);
+		for (auto i = 0; i < scores.rows(); ++i) {
+			for (auto j = 0; j < scores.dimensions(); ++j) {
+				CHECK(scores(i, j) == 0.0);
+			}
+		}
+	}
+
+	SECTION("cosine similarity") {
+		auto const norms = comp6771::euclidean_norm(m);
+		auto const scores = comp6771::cosine_similarity(m, norms, query);
+		CHECK(scores == comp6771::cosine_similarity(m, query));
+		for (auto i = std::size_t{0}; i < vectors.size(); ++i) {
+			auto const expected = comp6771::dot(vectors[i], query)
+			                      / (comp6771::euclidean_norm(vectors[i])
+			                         * comp6771::euclidean_norm(query));
+			CHECK(scores[i] == Approx(expected).margin(1e-12));
+		}
+
+		auto const pairwise = comp6771::cosine_similarity(m, m);
+		for (auto i = 0; i < pairwise.rows(); ++i) {
+			CHECK(pairwise(i, i) == Approx(1.0));
+		}
+
+		CHECK_THROWS_MATCHES(comp6771::cosine_similarity(m, std::span(norms).first(3), query),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not "
+		                                              "match"));
+		CHECK_THROWS_MATCHES(comp6771::cosine_similarity(m, comp6771::euclidean_vector(dimensions)),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("euclidean_vector with zero euclidean normal "
+		                                              "does not have a unit vector"));
+	}
+}
@@ -0,0 +1,131 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+
+// The norm is cached lazily, so every test below first primes the cache with euclidean_norm(), then
+// mutates the vector, and finally checks the norm against a freshly built vector with the same
+// magnitudes (whose cache is guaranteed to be cold).
+namespace {
+	auto fresh_norm(comp6771::euclidean_vector const& v) -> double {
+		auto const magnitudes = static_cast<std::vector<double>>(v);
+		auto const copy = comp6771::euclidean_vector(magnitudes.begin(), magnitudes.end());
+		return comp6771::euclidean_norm(copy);
+	}
+} // namespace
+
+TEST_CASE("cached norm: repeated calls return the same value") {
+	auto const a1 = comp6771::euclidean_vector{3, 4};
+	CHECK(comp6771::euclidean_norm(a1) == 5);
+	CHECK(comp6771::euclidean_norm(a1) == 5);
+	CHECK(comp6771::unit(a1) == comp6771::euclidean_vector{0.6, 0.8});
+	CHECK(comp6771::euclidean_norm(a1) == 5);
+}
+
+TEST_CASE("cached norm: writes through subscripts and at() are never stale") {
+	SECTION("non-const []") {
+		auto a1 = comp6771::euclidean_vector{3, 4};
+		REQUIRE(comp6771::euclidean_norm(a1) == 5);
+		a1[0] = 6;
+		a1[1] = 8;
+		CHECK(comp6771::euclidean_norm(a1) == 10);
+	}
+	SECTION("non-const at()") {
+		auto a1 = comp6771::euclidean_vector{3, 4};
+		REQUIRE(comp6771::euclidean_norm(a1) == 5);
+		a1.at(0) = 0;
+		CHECK(comp6771::euclidean_norm(a1) == 4);
+	}
+	SECTION("const reads keep the cache") {
+		auto const a1 = comp6771::euclidean_vector{3, 4};
+		REQUIRE(comp6771::euclidean_norm(a1) == 5);
+		CHECK(a1[0] == 3);
+		CHECK(a1.at(1) == 4);
+		CHECK(comp6771::euclidean_norm(a1) == 5);
+	}
+}
+
+TEST_CASE("cached norm: compound operators are never stale") {
+	auto a1 = comp6771::euclidean_vector{3, 4};
+	auto const a2 = comp6771::euclidean_vector{3, 4};
+	REQUIRE(comp6771::euclidean_norm(a1) == 5);
+	REQUIRE(comp6771::euclidean_norm(a2) == 5);
+
+	SECTION("+=") {
+		a1 += a2;
+		CHECK(comp6771::euclidean_norm(a1) == 10);
+	}
+	SECTION("-=") {
+		a1 -= a2;
+		CHECK(comp6771::euclidean_norm(a1) == 0);
+	}
+	SECTION("*=") {
+		a1 *= -3;
+		CHECK(comp6771::euclidean_norm(a1) == Approx(fresh_norm(a1)));
+		CHECK(comp6771::euclidean_norm(a1) == Approx(15));
+	}
+	SECTION("/=") {
+		a1 /= -0.5;
+		CHECK(comp6771::euclidean_norm(a1) == Approx(fresh_norm(a1)));
+		CHECK(comp6771::euclidean_norm(a1) == Approx(10));
+	}
+	SECTION("*= after a norm that underflowed") {
+		auto tiny = comp6771::euclidean_vector{1e-200};
+		REQUIRE(comp6771::euclidean_norm(tiny) == 0);
+		tiny *= 1e200;
+		CHECK(comp6771::euclidean_norm(tiny) == fresh_norm(tiny));
+		CHECK(comp6771::euclidean_norm(tiny) == Approx(1));
+		CHECK_NOTHROW(tiny.normalize());
+	}
+	SECTION("/= after a norm that overflowed") {
+		auto huge = comp6771::euclidean_vector{1e200, 1e200};
+		REQUIRE(std::isinf(comp6771::euclidean_norm(huge)));
+		huge /= 1e200;
+		CHECK(comp6771::euclidean_norm(huge) == fresh_norm(huge));
+		CHECK(comp6771::euclidean_norm(huge) == Approx(std::sqrt(2.0)));
+	}
+	SECTION("failed compound operators leave the cache intact") {
+		CHECK_THROWS_AS(a1 += comp6771::euclidean_vector(3), comp6771::euclidean_vector_error);
+		CHECK_THROWS_AS(a1 /= 0, comp6771::euclidean_vector_error);
+		CHECK(comp6771::euclidean_norm(a1) == 5);
+	}
+}
+
+TEST_CASE("cached norm: assignment and move transfer the right norm") {
+	SECTION("copy assignment to a vector with a cached norm") {
+		auto a1 = comp6771::euclidean_vector{3, 4};
+		auto const a2 = comp6771::euclidean_vector{6, 8};
+		REQUIRE(comp6771::euclidean_norm(a1) == 5);
+		a1 = a2;
+		CHECK(comp6771::euclidean_norm(a1) == 10);
+	}
+	SECTION("copy assignment from a vector with a cached norm") {
+		auto a1 = comp6771::euclidean_vector{3, 4};
+		auto a2 = comp6771::euclidean_vector{6, 8};
+		REQUIRE(comp6771::euclidean_norm(a2) == 10);
+		a1 = a2;
+		a2[0] = 0;
+		CHECK(comp6771::euclidean_norm(a1) == 10);
+		CHECK(comp6771::euclidean_norm(a2) == 8);
+	}
+	SECTION("move assignment") {
+		auto a1 = comp6771::euclidean_vector{3, 4};
+		auto a2 = comp6771::euclidean_vector{6, 8};
+		REQUIRE(comp6771::euclidean_norm(a1) == 5);
+		REQUIRE(comp6771::euclidean_norm(a2) == 10);
+		a1 = std::move(a2);
+		CHECK(comp6771::euclidean_norm(a1) == 10);
+		// NOLINTNEXTLINE(bugprone-use-after-move)
+		CHECK_THROWS_AS(comp6771::euclidean_norm(a2), comp6771::euclidean_vector_error);
+	}
+	SECTION("copy and move construction") {
+		auto a1 = comp6771::euclidean_vector{3, 4};
+		REQUIRE(comp6771::euclidean_norm(a1) == 5);
+		auto a2 = a1;
+		a2[0] = 0;
+		CHECK(comp6771::euclidean_norm(a1) == 5);
+		CHECK(comp6771::euclidean_norm(a2) == 4);
+		auto const a3 = std::move(a1);
+		CHECK(comp6771::euclidean_norm(a3) == 5);
+	}
+}
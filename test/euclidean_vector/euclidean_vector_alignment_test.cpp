@@ -0,0 +1,77 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_memory.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace {
+	auto constexpr alignment = comp6771::euclidean_vector::storage_alignment;
+
+	auto is_aligned(comp6771::euclidean_vector const& v) -> bool {
+		return reinterpret_cast<std::uintptr_t>(v.magnitudes().data()) % alignment == 0;
+	}
+} // namespace
+
+TEST_CASE("alignment: every constructor gives aligned storage") {
+	auto const dimensions = GENERATE(1, 3, comp6771::euclidean_vector::inline_capacity,
+	                                 comp6771::euclidean_vector::inline_capacity + 1, 1000);
+	auto const values = std::vector<double>(static_cast<std::size_t>(dimensions), 1.5);
+
+	CHECK(is_aligned(comp6771::euclidean_vector(dimensions)));
+	CHECK(is_aligned(comp6771::euclidean_vector(dimensions, 2.5)));
+	CHECK(is_aligned(comp6771::euclidean_vector(values.begin(), values.end())));
+
+	auto const source = comp6771::euclidean_vector(dimensions, 2.5);
+	CHECK(is_aligned(comp6771::euclidean_vector(source)));
+	CHECK(is_aligned(comp6771::euclidean_vector(source + source)));
+	auto moved_from = comp6771::euclidean_vector(source);
+	auto const moved = comp6771::euclidean_vector(std::move(moved_from));
+	CHECK(is_aligned(moved));
+	CHECK(is_aligned(moved_from)); // NOLINT(bugprone-use-after-move)
+
+	SECTION("through memory resources that don't align by default") {
+		auto arena = comp6771::pmr::arena_resource();
+		[[maybe_unused]] auto* const misaligned = arena.allocate(8, 8);
+		CHECK(is_aligned(comp6771::euclidean_vector(dimensions, 2.5, &arena)));
+		auto pool = comp6771::pmr::pool_resource();
+		CHECK(is_aligned(comp6771::euclidean_vector(dimensions, 2.5, &pool)));
+		auto monotonic = std::pmr::monotonic_buffer_resource();
+		[[maybe_unused]] auto* const misaligned2 = monotonic.allocate(8, 8);
+		CHECK(is_aligned(comp6771::euclidean_vector(source, &monotonic)));
+	}
+}
+
+TEST_CASE("alignment: assignments keep storage aligned") {
+	auto const small = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+	auto const large = comp6771::euclidean_vector(1000, 1.5);
+
+	auto a1 = comp6771::euclidean_vector(5);
+	a1 = large;
+	CHECK(is_aligned(a1));
+	a1 = small;
+	CHECK(is_aligned(a1));
+	a1 = comp6771::euclidean_vector(large);
+	CHECK(is_aligned(a1));
+	a1 = comp6771::euclidean_vector(small);
+	CHECK(is_aligned(a1));
+	a1 = large * 2.0;
+	CHECK(is_aligned(a1));
+	a1 = small - small;
+	CHECK(is_aligned(a1));
+}
+
+TEST_CASE("alignment: magnitudes() covers the whole vector") {
+	auto a1 = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+	auto const& c1 = a1;
+	CHECK(c1.magnitudes().size() == 3);
+	CHECK(c1.magnitudes()[1] == 2.0);
+	CHECK(euclidean_norm(a1) == Approx(std::sqrt(14.0)));
+
+	a1.magnitudes()[0] = 2.0;
+	CHECK(a1[0] == 2.0);
+	CHECK(euclidean_norm(a1) == Approx(std::sqrt(17.0))); // writes invalidate the cached norm
+}
@@ -0,0 +1,102 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <array>
+#include <catch2/catch.hpp>
+#include <deque>
+#include <list>
+#include <memory_resource>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("uninitialized constructor") {
+	auto const dimensions = GENERATE(0, 3, comp6771::euclidean_vector::inline_capacity + 1);
+	auto a1 = comp6771::euclidean_vector(comp6771::uninitialized, dimensions);
+	REQUIRE(a1.dimensions() == dimensions);
+	for (auto& magnitude : a1.magnitudes()) {
+		magnitude = 2.5;
+	}
+	CHECK(a1 == comp6771::euclidean_vector(dimensions, 2.5));
+
+	auto resource = std::pmr::monotonic_buffer_resource();
+	auto const a2 = comp6771::euclidean_vector(comp6771::uninitialized, dimensions, &resource);
+	CHECK(a2.dimensions() == dimensions);
+	CHECK(a2.get_allocator().resource() == &resource);
+}
+
+TEST_CASE("generator constructor") {
+	SECTION("magnitude i is f(i)") {
+		auto const a1 = comp6771::euclidean_vector(4, [](int i) { return i * 1.5; });
+		CHECK(a1 == comp6771::euclidean_vector{0.0, 1.5, 3.0, 4.5});
+	}
+
+	SECTION("the generator is called once per magnitude, in order") {
+		auto calls = std::vector<int>();
+		auto const a1 = comp6771::euclidean_vector(50, [&calls](int i) {
+			calls.push_back(i);
+			return 1;
+		});
+		CHECK(a1 == comp6771::euclidean_vector(50, 1.0));
+		REQUIRE(calls.size() == 50);
+		for (auto i = 0; i < 50; ++i) {
+			CHECK(calls[static_cast<std::size_t>(i)] == i);
+		}
+	}
+
+	SECTION("with a memory resource") {
+		auto resource = std::pmr::monotonic_buffer_resource();
+		auto const a1 = comp6771::euclidean_vector(30, [](int i) { return -i; }, &resource);
+		CHECK(a1.get_allocator().resource() == &resource);
+		CHECK(a1[29] == -29.0);
+	}
+
+	SECTION("a throwing generator doesn't leak") {
+		auto const throws_at_20 = [](int i) {
+			if (i == 20) {
+				throw std::runtime_error("generator failed");
+			}
+			return 1.0;
+		};
+		CHECK_THROWS_AS(comp6771::euclidean_vector(30, throws_at_20), std::runtime_error);
+	}
+}
+
+TEST_CASE("sized range constructor") {
+	SECTION("from other containers") {
+		auto const expected = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+		CHECK(comp6771::euclidean_vector(std::list<double>{1.0, 2.0, 3.0}) == expected);
+		CHECK(comp6771::euclidean_vector(std::deque<double>{1.0, 2.0, 3.0}) == expected);
+		CHECK(comp6771::euclidean_vector(std::array{1.0, 2.0, 3.0}) == expected);
+		CHECK(comp6771::euclidean_vector(std::vector<double>{1.0, 2.0, 3.0}) == expected);
+	}
+
+	SECTION("converts other arithmetic types") {
+		CHECK(comp6771::euclidean_vector(std::vector<int>{1, -2, 3})
+		      == comp6771::euclidean_vector{1.0, -2.0, 3.0});
+		CHECK(comp6771::euclidean_vector(std::array{0.5F, 1.5F})
+		      == comp6771::euclidean_vector{0.5, 1.5});
+		CHECK(comp6771::euclidean_vector(std::views::iota(0, 20))
+		      == comp6771::euclidean_vector(20, [](int i) { return i; }));
+	}
+
+	SECTION("with a memory resource") {
+		auto resource = std::pmr::monotonic_buffer_resource();
+		auto const values = std::vector<double>(40, 1.5);
+		auto const a1 = comp6771::euclidean_vector(values, &resource);
+		CHECK(a1.get_allocator().resource() == &resource);
+		CHECK(a1 == comp6771::euclidean_vector(40, 1.5));
+	}
+
+	SECTION("only sized ranges of arithmetic values are accepted") {
+		auto const unsized =
+		   std::views::iota(0) | std::views::take_while([](int i) { return i < 3; });
+		STATIC_REQUIRE(
+		   not std::is_constructible_v<comp6771::euclidean_vector, decltype(unsized)>);
+		STATIC_REQUIRE(
+		   not std::is_constructible_v<comp6771::euclidean_vector, std::vector<std::string>>);
+		STATIC_REQUIRE(
+		   not std::is_convertible_v<std::vector<double>, comp6771::euclidean_vector>);
+	}
+}
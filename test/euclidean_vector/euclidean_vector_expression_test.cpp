@@ -0,0 +1,101 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include "allocation_counter.hpp"
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+TEST_CASE("expressions: evaluate to the same values as the eager operators") {
+	auto const a1 = comp6771::euclidean_vector{1, 2, 3};
+	auto const a2 = comp6771::euclidean_vector{4, 5, 6};
+	auto const a3 = comp6771::euclidean_vector{0.5, 1, 1.5};
+
+	auto const result = comp6771::euclidean_vector(a1 + a2 - a3 * 2 + a1 / 0.5);
+	CHECK(result == comp6771::euclidean_vector{6, 9, 12});
+	CHECK(-(a1 + a2) == comp6771::euclidean_vector{-5, -7, -9});
+	CHECK(fmt::format("{}", a1 + a2) == "[5 7 9]");
+}
+
+TEST_CASE("expressions: a whole expression is evaluated with a single allocation") {
+	auto const w = comp6771::euclidean_vector(1000, 1.0);
+	auto const g = comp6771::euclidean_vector(1000, 2.0);
+	auto const m = comp6771::euclidean_vector(1000, 3.0);
+
+	SECTION("constructing from an expression allocates the result only") {
+		auto const counter = comp6771::test::allocation_counter();
+		auto const result = comp6771::euclidean_vector(w + g * 0.5 - m * 0.25);
+		CHECK(counter.count() == 1);
+		CHECK(result == comp6771::euclidean_vector(1000, 1.25));
+	}
+	SECTION("assigning to a vector of the same dimension doesn't allocate") {
+		auto target = comp6771::euclidean_vector(1000);
+		auto const counter = comp6771::test::allocation_counter();
+		target = w + g * 0.5 - m * 0.25;
+		CHECK(counter.count() == 0);
+		CHECK(target == comp6771::euclidean_vector(1000, 1.25));
+	}
+	SECTION("compound assignment from an expression doesn't allocate") {
+		auto target = comp6771::euclidean_vector(1000, 1.0);
+		auto const counter = comp6771::test::allocation_counter();
+		target += g * 0.5;
+		target -= m * 0.25 - w;
+		CHECK(counter.count() == 0);
+		CHECK(target == comp6771::euclidean_vector(1000, 2.25));
+	}
+}
+
+TEST_CASE("expressions: the target may appear in its own expression") {
+	auto w = comp6771::euclidean_vector{1, 2, 3};
+	auto const g = comp6771::euclidean_vector{2, 2, 2};
+	auto const m = comp6771::euclidean_vector{4, 4, 4};
+	w = w + g * 0.5 - m * 0.25;
+	CHECK(w == comp6771::euclidean_vector{1, 2, 3});
+	w += w;
+	CHECK(w == comp6771::euclidean_vector{2, 4, 6});
+	w -= w * 0.5;
+	CHECK(w == comp6771::euclidean_vector{1, 2, 3});
+}
+
+TEST_CASE("expressions: assignment changes dimensions like copy assignment") {
+	auto a1 = comp6771::euclidean_vector{1, 2};
+	auto const a2 = comp6771::euclidean_vector{1, 2, 3};
+	a1 = a2 + a2;
+	CHECK(a1 == comp6771::euclidean_vector{2, 4, 6});
+
+	auto a3 = comp6771::euclidean_vector{1, 2};
+	a3 = comp6771::euclidean_vector{1, 1, 1} + a2;
+	CHECK(a3 == comp6771::euclidean_vector{2, 3, 4});
+}
+
+TEST_CASE("expressions: temporaries are owned by the expression") {
+	auto const a1 = comp6771::euclidean_vector{1, 2, 3};
+	auto const sum = a1 + comp6771::euclidean_vector{1, 1, 1};
+	auto const scaled = comp6771::euclidean_vector{2, 2, 2} * 2;
+	CHECK(sum.dimensions() == 3);
+	CHECK(comp6771::euclidean_vector(sum) == comp6771::euclidean_vector{2, 3, 4});
+	CHECK(comp6771::euclidean_vector(scaled - sum) == comp6771::euclidean_vector{2, 1, 0});
+}
+
+TEST_CASE("expressions: the existing exceptions are thrown when the expression is built") {
+	auto const a1 = comp6771::euclidean_vector{1, 2, 3};
+	auto const a2 = comp6771::euclidean_vector{1, 2};
+	auto const mismatch = std::string("Dimensions of LHS(X) and RHS(Y) do not match");
+	CHECK_THROWS_MATCHES(a1 + a1 - a2,
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message(mismatch));
+	CHECK_THROWS_MATCHES(a2 * 2 + a1 * 2,
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message(mismatch));
+	CHECK_THROWS_MATCHES((a1 + a1) / 0,
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Invalid vector division by 0"));
+
+	auto target = comp6771::euclidean_vector{1, 2};
+	CHECK_THROWS_MATCHES(target += a1 * 2,
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message(mismatch));
+	CHECK_THROWS_MATCHES(target -= a1 * 2,
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message(mismatch));
+	CHECK(target == comp6771::euclidean_vector{1, 2});
+}
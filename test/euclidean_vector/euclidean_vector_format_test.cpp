@@ -0,0 +1,161 @@
+#include "comp6771/euclidean_vector_format.hpp"
+
+#include <array>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <fmt/format.h>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace {
+	auto from_string(std::string_view text, comp6771::euclidean_vector& value)
+	   -> std::from_chars_result {
+		return comp6771::from_chars(text.data(), text.data() + text.size(), value);
+	}
+} // namespace
+
+TEST_CASE("fmt::format writes the shortest text that round-trips") {
+	auto const v = comp6771::euclidean_vector{0.1, 0.1 + 0.2, 1e100, -2.0};
+	CHECK(fmt::format("{}", v) == "[0.1 0.30000000000000004 1e+100 -2]");
+	CHECK(fmt::format("{}", comp6771::euclidean_vector(3)) == "[0 0 0]");
+	CHECK(fmt::format("{}", comp6771::euclidean_vector(0)) == "[]");
+
+	// every double survives, including the ones operator<< rounds
+	auto const awkward = comp6771::euclidean_vector{1.0 / 3,
+	                                                std::numeric_limits<double>::denorm_min(),
+	                                                std::numeric_limits<double>::max(),
+	                                                -0.0};
+	auto const result = comp6771::parse_euclidean_vector(fmt::format("{}", awkward));
+	for (auto i = 0; i < awkward.dimensions(); ++i) {
+		CHECK(result[i] == awkward[i]);
+		CHECK(std::signbit(result[i]) == std::signbit(awkward[i]));
+	}
+}
+
+TEST_CASE("fmt::format takes a separator, precision and notation") {
+	auto const v = comp6771::euclidean_vector{0.1, 0.1 + 0.2, 1e100};
+	CHECK(fmt::format("{:,}", v) == "[0.1,0.30000000000000004,1e+100]");
+	CHECK(fmt::format("{:,.2e}", v) == "[1.00e-01,3.00e-01,1.00e+100]");
+	CHECK(fmt::format("{:;.3}", comp6771::euclidean_vector{1.0 / 3, 2.0}) == "[0.333;2]");
+	CHECK(fmt::format("{:|f}", comp6771::euclidean_vector{0.5, 1e3}) == "[0.5|1000]");
+
+	auto buffer = std::array{1.0, 2.5};
+	CHECK(fmt::format("{:.1f}", comp6771::const_euclidean_vector_view(buffer)) == "[1.0 2.5]");
+	CHECK(fmt::format("{:.1f}", comp6771::euclidean_vector_view(buffer)) == "[1.0 2.5]");
+
+	CHECK_THROWS_AS(fmt::format(fmt::runtime("{:x}"), v), fmt::format_error);
+	CHECK_THROWS_AS(fmt::format(fmt::runtime("{:.}"), v), fmt::format_error);
+	CHECK_THROWS_AS(fmt::format(fmt::runtime("{:.100}"), v), fmt::format_error);
+}
+
+TEST_CASE("Text written with any separator parses back") {
+	auto const v = comp6771::euclidean_vector{0.1, -0.0, 1e100, 0.1 + 0.2};
+	auto const spec = GENERATE(as<std::string_view>(), "{}", "{:,}", "{:;}", "{:|}");
+	CAPTURE(spec);
+	auto const text = fmt::format(fmt::runtime(spec), v);
+	auto const result = comp6771::parse_euclidean_vector(text);
+	REQUIRE(result.dimensions() == v.dimensions());
+	for (auto i = 0; i < v.dimensions(); ++i) {
+		CHECK(result[i] == v[i]);
+		CHECK(std::signbit(result[i]) == std::signbit(v[i]));
+	}
+	if (spec != "{}") {
+		// and without the brackets, as a line of values
+		auto const line = std::string_view(text).substr(1, text.size() - 2);
+		CHECK(comp6771::parse_euclidean_vector(line).magnitudes().size() == 4);
+	}
+}
+
+TEST_CASE("to_chars writes into a caller's buffer") {
+	auto const v = comp6771::euclidean_vector{1.5, -2.0, 0.3};
+	auto buffer = std::array<char, 16>();
+	auto const [ptr, ec] = comp6771::to_chars(buffer.data(), buffer.data() + buffer.size(), v);
+	REQUIRE(ec == std::errc());
+	CHECK(std::string_view(buffer.data(), ptr) == "[1.5 -2 0.3]");
+
+	auto format = comp6771::text_format();
+	format.separator = ',';
+	format.notation = std::chars_format::fixed;
+	format.precision = 1;
+	auto const fixed = comp6771::to_chars(buffer.data(), buffer.data() + buffer.size(), v, format);
+	REQUIRE(fixed.ec == std::errc());
+	CHECK(std::string_view(buffer.data(), fixed.ptr) == "[1.5,-2.0,0.3]");
+
+	// one short, wherever the buffer runs out
+	auto const length = static_cast<std::size_t>(ptr - buffer.data());
+	for (auto size = std::size_t{0}; size < length; ++size) {
+		auto const short_result = comp6771::to_chars(buffer.data(), buffer.data() + size, v);
+		CHECK(short_result.ec == std::errc::value_too_large);
+		CHECK(short_result.ptr == buffer.data() + size);
+	}
+}
+
+TEST_CASE("from_chars reads the bracketed and CSV forms") {
+	auto v = comp6771::euclidean_vector{9.0};
+
+	SECTION("Bracketed, separated by whitespace and at most one comma") {
+		auto const text = std::string_view("  [1 -2.5e3,\t0.5 , inf\n4]tail");
+		auto const [ptr, ec] = from_string(text, v);
+		REQUIRE(ec == std::errc());
+		CHECK(std::string_view(ptr) == "tail");
+		REQUIRE(v.dimensions() == 5);
+		CHECK(v[0] == 1.0);
+		CHECK(v[1] == -2500.0);
+		CHECK(v[2] == 0.5);
+		CHECK(std::isinf(v[3]));
+		CHECK(v[4] == 4.0);
+	}
+
+	SECTION("Empty brackets") {
+		auto const [ptr, ec] = from_string("[ ]", v);
+		REQUIRE(ec == std::errc());
+		CHECK(v.dimensions() == 0);
+	}
+
+	SECTION("CSV stops at the end of the line") {
+		auto const text = std::string_view("1.5, 2,3\n4,5");
+		auto const [ptr, ec] = from_string(text, v);
+		REQUIRE(ec == std::errc());
+		CHECK(std::string_view(ptr) == "\n4,5");
+		CHECK(v == comp6771::euclidean_vector{1.5, 2.0, 3.0});
+	}
+
+	SECTION("Malformed text leaves the vector alone") {
+		auto const text = GENERATE(as<std::string_view>(),
+		                           "",
+		                           "  ",
+		                           "[",
+		                           "[1 2",
+		                           "[1,,2]",
+		                           "[1,]",
+		                           "[,1]",
+		                           "[1 two]",
+		                           "[1 2e]",
+		                           "1,",
+		                           ",1",
+		                           "[1e999]");
+		auto const [ptr, ec] = from_string(text, v);
+		CHECK(ec != std::errc());
+		CHECK(v == comp6771::euclidean_vector{9.0});
+	}
+
+	SECTION("Out of range magnitudes are reported as such") {
+		auto const text = std::string_view("[1 1e999]");
+		auto const [ptr, ec] = from_string(text, v);
+		CHECK(ec == std::errc::result_out_of_range);
+		CHECK(ptr == text.data() + 3);
+	}
+}
+
+TEST_CASE("parse_euclidean_vector wants the whole text") {
+	CHECK(comp6771::parse_euclidean_vector(" [1 2 3]\n") == comp6771::euclidean_vector{1, 2, 3});
+	CHECK(comp6771::parse_euclidean_vector("1,2,3") == comp6771::euclidean_vector{1, 2, 3});
+	CHECK_THROWS_MATCHES(comp6771::parse_euclidean_vector("[1 2 3] 4"),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Text is not a valid euclidean_vector"));
+	CHECK_THROWS_MATCHES(comp6771::parse_euclidean_vector("1 2 3"),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Text is not a valid euclidean_vector"));
+}
@@ -0,0 +1,228 @@
+#include "comp6771/euclidean_vector_io.hpp"
+
+#include "vector_factory.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+	using comp6771::test::make_vector;
+
+	// bitwise, so that -0.0 and the last bit of every magnitude have to survive the round trip
+	auto same_bits(comp6771::const_euclidean_vector_view x, comp6771::const_euclidean_vector_view y)
+	   -> bool {
+		return std::ranges::equal(x.magnitudes(), y.magnitudes(), [](double a, double b) {
+			return std::bit_cast<std::uint64_t>(a) == std::bit_cast<std::uint64_t>(b);
+		});
+	}
+
+	auto serialise(std::vector<comp6771::euclidean_vector> const& vectors) -> std::string {
+		auto out = std::ostringstream(std::ios::binary);
+		comp6771::write_binary(out, vectors);
+		return std::move(out).str();
+	}
+
+	auto deserialise(std::string data) -> std::vector<comp6771::euclidean_vector> {
+		auto in = std::istringstream(std::move(data), std::ios::binary);
+		return comp6771::read_binary_batch(in);
+	}
+
+	// a file in the temporary directory that's removed at the end of the test
+	class temporary_file {
+	public:
+		explicit temporary_file(std::string const& contents)
+		: path_{std::filesystem::temp_directory_path()
+		        / ("euclidean_vector_io_test_" + std::to_string(std::random_device()()))} {
+			auto out = std::ofstream(path_, std::ios::binary);
+			out << contents;
+		}
+
+		temporary_file(temporary_file const&) = delete;
+		auto operator=(temporary_file const&) -> temporary_file& = delete;
+
+		~temporary_file() {
+			auto error = std::error_code();
+			std::filesystem::remove(path_, error);
+		}
+
+		[[nodiscard]] auto path() const -> std::filesystem::path const& {
+			return path_;
+		}
+
+	private:
+		std::filesystem::path path_;
+	};
+} // namespace
+
+TEST_CASE("A euclidean_vector survives a binary round trip bit for bit") {
+	// inline-sized, exactly one alignment's worth, and heap-allocated
+	auto const dimensions = GENERATE(1, 8, 100);
+	auto original = make_vector(dimensions, 0.0);
+	original[0] = -0.0;
+	original[dimensions - 1] = std::numeric_limits<double>::denorm_min();
+
+	auto out = std::ostringstream(std::ios::binary);
+	comp6771::write_binary(out, original);
+	auto const data = std::move(out).str();
+	auto const stride = (static_cast<std::size_t>(dimensions) + 7) / 8 * 8;
+	CHECK(data.size() == sizeof(comp6771::binary_header) + stride * sizeof(double));
+
+	auto in = std::istringstream(data, std::ios::binary);
+	auto const result = comp6771::read_binary(in);
+	REQUIRE(result.dimensions() == dimensions);
+	CHECK(same_bits(result, original));
+}
+
+TEST_CASE("Batches are written and read as a whole") {
+	SECTION("Every vector comes back in order") {
+		auto const original =
+		   std::vector{make_vector(13, 0.0), make_vector(13, 1.0), make_vector(13, 2.0)};
+		auto const result = deserialise(serialise(original));
+		REQUIRE(result.size() == original.size());
+		for (auto i = std::size_t{0}; i < result.size(); ++i) {
+			CHECK(same_bits(result[i], original[i]));
+		}
+	}
+
+	SECTION("An empty batch is just a header") {
+		auto const data = serialise({});
+		CHECK(data.size() == sizeof(comp6771::binary_header));
+		CHECK(deserialise(data).empty());
+	}
+
+	SECTION("read_binary wants exactly one vector") {
+		auto in = std::istringstream(serialise({make_vector(4, 0.0), make_vector(4, 1.0)}),
+		                             std::ios::binary);
+		CHECK_THROWS_MATCHES(comp6771::read_binary(in),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("euclidean_vector data does not hold exactly "
+		                                              "one vector"));
+	}
+
+	SECTION("Vectors with different dimensions aren't written at all") {
+		auto out = std::ostringstream(std::ios::binary);
+		auto const mismatched = std::vector{make_vector(4, 0.0), make_vector(5, 0.0)};
+		CHECK_THROWS_MATCHES(comp6771::write_binary(out, mismatched),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("euclidean_vectors in a batch must all have "
+		                                              "the same dimensions"));
+		CHECK(out.str().empty());
+	}
+}
+
+TEST_CASE("Reading rejects data that isn't a valid batch") {
+	auto data = serialise({make_vector(20, 0.0), make_vector(20, 1.0)});
+
+	SECTION("Wrong magic") {
+		data[0] = 'X';
+		CHECK_THROWS_MATCHES(deserialise(data),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Data is not in the euclidean_vector binary "
+		                                              "format"));
+	}
+
+	SECTION("Other byte order") {
+		std::reverse(data.begin() + 8, data.begin() + 12);
+		CHECK_THROWS_MATCHES(deserialise(data),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("euclidean_vector data was written with a "
+		                                              "different byte order"));
+	}
+
+	SECTION("Truncated") {
+		data.pop_back();
+		CHECK_THROWS_MATCHES(deserialise(data),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("euclidean_vector data is truncated"));
+	}
+
+	SECTION("A corrupt count of vectors with no dimensions") {
+		auto empty = serialise({comp6771::euclidean_vector(0)});
+		auto header = comp6771::binary_header();
+		std::memcpy(&header, empty.data(), sizeof(header));
+		header.count = std::numeric_limits<std::uint64_t>::max();
+		std::memcpy(empty.data(), &header, sizeof(header));
+		CHECK_THROWS_MATCHES(deserialise(empty),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("euclidean_vector data holds too many "
+		                                              "vectors with no dimensions"));
+	}
+
+	SECTION("Corrupted magnitudes") {
+		data[sizeof(comp6771::binary_header) + 3] ^= 1;
+		CHECK_THROWS_MATCHES(deserialise(data),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("euclidean_vector data does not match its "
+		                                              "checksum"));
+	}
+}
+
+TEST_CASE("mapped_euclidean_vectors exposes a file's vectors in place") {
+	auto const original =
+	   std::vector{make_vector(20, 0.0), make_vector(20, 1.0), make_vector(20, 2.0)};
+	auto const file = temporary_file(serialise(original));
+
+	auto store = comp6771::mapped_euclidean_vectors(file.path());
+	REQUIRE(store.size() == original.size());
+	CHECK(store.dimensions() == 20);
+	CHECK(store.verify());
+	for (auto i = std::size_t{0}; i < store.size(); ++i) {
+		CHECK(same_bits(store[i], original[i]));
+		auto const address = reinterpret_cast<std::uintptr_t>(store[i].magnitudes().data());
+		CHECK(address % comp6771::euclidean_vector::storage_alignment == 0);
+	}
+	CHECK(comp6771::dot(store.at(1), original[2])
+	      == Approx(comp6771::dot(original[1], original[2])));
+	CHECK_THROWS_MATCHES(store.at(3),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Index X is not valid for this "
+	                                              "euclidean_vector object"));
+
+	auto const moved = std::move(store);
+	CHECK(moved.size() == original.size());
+	CHECK(store.size() == 0); // NOLINT(bugprone-use-after-move)
+}
+
+TEST_CASE("mapped_euclidean_vectors checks the header, and the payload on request") {
+	SECTION("verify() notices corrupted magnitudes") {
+		auto data = serialise({make_vector(20, 0.0)});
+		data.back() ^= 1;
+		auto const file = temporary_file(data);
+		CHECK_FALSE(comp6771::mapped_euclidean_vectors(file.path()).verify());
+	}
+
+	SECTION("A file that's shorter than its header says is rejected") {
+		auto data = serialise({make_vector(20, 0.0), make_vector(20, 1.0)});
+		data.resize(data.size() - sizeof(double));
+		auto const file = temporary_file(data);
+		CHECK_THROWS_MATCHES(comp6771::mapped_euclidean_vectors(file.path()),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("euclidean_vector data is truncated"));
+	}
+
+	SECTION("A file in another format is rejected") {
+		auto const file = temporary_file(std::string(256, '['));
+		CHECK_THROWS_MATCHES(comp6771::mapped_euclidean_vectors(file.path()),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Data is not in the euclidean_vector binary "
+		                                              "format"));
+	}
+
+	SECTION("A missing file is a system error") {
+		auto const missing = std::filesystem::temp_directory_path() / "euclidean_vector_io_missing";
+		CHECK_THROWS_AS(comp6771::mapped_euclidean_vectors(missing), std::system_error);
+	}
+}
@@ -0,0 +1,266 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+	using comp6771::kernels::simd_width;
+
+	auto sample(std::size_t n, double phase) -> std::vector<double> {
+		auto result = std::vector<double>(n);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			result[i] = std::sin(static_cast<double>(i) + phase) * 10;
+		}
+		return result;
+	}
+
+	// plain left-to-right reference; long double keeps its own rounding error out of the way
+	auto reference_dot(std::vector<double> const& x, std::vector<double> const& y) -> double {
+		auto sum = 0.0L;
+		for (auto i = std::size_t{0}; i < x.size(); ++i) {
+			sum += static_cast<long double>(x[i]) * static_cast<long double>(y[i]);
+		}
+		return static_cast<double>(sum);
+	}
+
+} // namespace
+
+TEST_CASE("kernels: every supported width matches the scalar reference") {
+	auto const width =
+	   GENERATE(simd_width::scalar, simd_width::sse2, simd_width::avx2, simd_width::avx512);
+	if (not comp6771::kernels::is_supported(width)) {
+		return;
+	}
+	auto const& kernels = comp6771::kernels::kernels_for(width);
+	// covers every unrolled body, every remainder loop and a size past all of them
+	auto const n =
+	   GENERATE(as<std::size_t>(), 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 100, 1027);
+	CAPTURE(static_cast<int>(width), n);
+	auto const x = sample(n, 0.0);
+	auto const y = sample(n, 1.0);
+
+	SECTION("dot") {
+		CHECK(kernels.dot(x, y) == Approx(reference_dot(x, y)).margin(1e-9));
+	}
+	SECTION("dot4") {
+		// four rows of n magnitudes, each padded to a stride of n + 3
+		auto const stride = n + 3;
+		auto rows = std::vector<double>(4 * stride, 100.0);
+		auto expected = std::array<double, 4>{};
+		for (auto r = std::size_t{0}; r < 4; ++r) {
+			auto const row = sample(n, static_cast<double>(r) + 1.0);
+			std::copy(row.begin(), row.end(), rows.begin() + static_cast<std::ptrdiff_t>(r * stride));
+			expected[r] = reference_dot(x, row) + 1.0;
+		}
+		auto result = std::array{1.0, 1.0, 1.0, 1.0};
+		kernels.dot4(x, rows.data(), stride, result);
+		for (auto r = std::size_t{0}; r < 4; ++r) {
+			CHECK(result[r] == Approx(expected[r]).margin(1e-9));
+		}
+	}
+	SECTION("squared_distance") {
+		auto difference = x;
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			difference[i] -= y[i];
+		}
+		auto const expected = reference_dot(difference, difference);
+		CHECK(kernels.squared_distance(x, y) == Approx(expected).margin(1e-9));
+		CHECK(kernels.squared_distance(x, x) == 0.0);
+	}
+	SECTION("manhattan_distance") {
+		auto expected = 0.0L;
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			expected += std::abs(static_cast<long double>(x[i]) - static_cast<long double>(y[i]));
+		}
+		CHECK(kernels.manhattan_distance(x, y) == Approx(static_cast<double>(expected)).margin(1e-9));
+		CHECK(kernels.manhattan_distance(x, x) == 0.0);
+	}
+	SECTION("cosine") {
+		auto const terms = kernels.cosine(x, y);
+		CHECK(terms.dot == Approx(reference_dot(x, y)).margin(1e-9));
+		CHECK(terms.x_squared_norm == Approx(reference_dot(x, x)).margin(1e-9));
+		CHECK(terms.y_squared_norm == Approx(reference_dot(y, y)).margin(1e-9));
+	}
+	SECTION("squared_norm") {
+		CHECK(kernels.squared_norm(x) == Approx(reference_dot(x, x)).margin(1e-9));
+	}
+	// the scalar kernel's bits exactly: no width may fuse the multiply and the add
+	auto const& scalar = comp6771::kernels::kernels_for(simd_width::scalar);
+	SECTION("axpy") {
+		auto result = y;
+		kernels.axpy(-2.5, x, result);
+		auto expected = y;
+		scalar.axpy(-2.5, x, expected);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			CHECK(result[i] == Approx(y[i] - 2.5 * x[i]));
+			CHECK(result[i] == expected[i]);
+		}
+	}
+	SECTION("axpy with alpha of 1 is exact addition") {
+		auto result = y;
+		kernels.axpy(1.0, x, result);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			CHECK(result[i] == y[i] + x[i]);
+		}
+	}
+	SECTION("axpby") {
+		auto result = y;
+		kernels.axpby(-0.3, x, 0.7, result);
+		auto expected = y;
+		scalar.axpby(-0.3, x, 0.7, expected);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			CHECK(result[i] == Approx(0.7 * y[i] - 0.3 * x[i]));
+			CHECK(result[i] == expected[i]);
+		}
+	}
+	SECTION("scale_add") {
+		auto result = x;
+		kernels.scale_add(1.5, -2.0, result);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			CHECK(result[i] == std::fma(x[i], 1.5, -2.0));
+		}
+	}
+	SECTION("multiply_elementwise and divide_elementwise") {
+		auto result = y;
+		kernels.multiply_elementwise(x, result);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			CHECK(result[i] == x[i] * y[i]);
+		}
+		kernels.divide_elementwise(y, result);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			CHECK(result[i] == Approx(x[i]));
+		}
+	}
+	SECTION("scale") {
+		auto result = x;
+		kernels.scale(3.0, result);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			CHECK(result[i] == x[i] * 3.0);
+		}
+	}
+	SECTION("divide") {
+		auto result = x;
+		kernels.divide(3.0, result);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			CHECK(result[i] == x[i] / 3.0);
+		}
+	}
+}
+
+TEST_CASE("kernels: reproducible reductions give the same bits at every width") {
+	using comp6771::reduction;
+	auto const mode = GENERATE(reduction::blocked, reduction::pairwise, reduction::compensated);
+	auto const& scalar = comp6771::kernels::kernels_for(simd_width::scalar);
+	auto const n = GENERATE(as<std::size_t>(), 0, 1, 7, 8, 9, 31, 33, 100, 255, 257, 1027, 70'000);
+	CAPTURE(static_cast<int>(mode), n);
+	auto const x = sample(n, 0.0);
+	auto const y = sample(n, 1.0);
+
+	auto const kernel_for = [mode](comp6771::kernels::kernel_table const& kernels) {
+		switch (mode) {
+		case reduction::blocked: return kernels.blocked_dot;
+		case reduction::pairwise: return kernels.pairwise_dot;
+		default: return kernels.compensated_dot;
+		}
+	};
+	auto const expected = kernel_for(scalar)(x, y);
+	CHECK(expected == Approx(reference_dot(x, y)).margin(1e-9));
+	CHECK(comp6771::kernels::dot(x, y, mode) == expected);
+	for (auto const width : {simd_width::sse2, simd_width::avx2, simd_width::avx512}) {
+		if (comp6771::kernels::is_supported(width)) {
+			CHECK(kernel_for(comp6771::kernels::kernels_for(width))(x, y) == expected);
+		}
+	}
+}
+
+TEST_CASE("kernels: compensated summation recovers what cancellation loses") {
+	// 1.0 is below half an ulp of 1e16, so adding it to a running sum of that size loses it
+	auto x = std::vector<double>();
+	for (auto i = 0; i < 1000; ++i) {
+		x.insert(x.end(), {1e16, 1.0, -1e16, 1.0});
+	}
+	auto const ones = std::vector<double>(x.size(), 1.0);
+	CHECK(comp6771::kernels::dot(x, ones, comp6771::reduction::compensated) == 2000.0);
+}
+
+TEST_CASE("kernels: reduced precision dot products match the scalar reference") {
+	auto const width =
+	   GENERATE(simd_width::scalar, simd_width::sse2, simd_width::avx2, simd_width::avx512);
+	if (not comp6771::kernels::is_supported(width)) {
+		return;
+	}
+	auto const& kernels = comp6771::kernels::kernels_for(width);
+	// 70'000 spans more than one block of the int8 kernels' 32-bit lanes
+	auto const n = GENERATE(as<std::size_t>(), 0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 1027, 70'000);
+	CAPTURE(static_cast<int>(width), n);
+	auto const x = sample(n, 0.0);
+	auto const y = sample(n, 1.0);
+
+	SECTION("float") {
+		auto const xf = std::vector<float>(x.begin(), x.end());
+		auto const yf = std::vector<float>(y.begin(), y.end());
+		auto const expected = reference_dot(std::vector<double>(xf.begin(), xf.end()),
+		                                    std::vector<double>(yf.begin(), yf.end()));
+		CHECK(kernels.float_dot(xf, yf) == Approx(expected).margin(1e-9));
+	}
+	SECTION("bfloat16") {
+		auto xb = std::vector<comp6771::bfloat16>();
+		auto yb = std::vector<comp6771::bfloat16>();
+		auto xw = std::vector<double>();
+		auto yw = std::vector<double>();
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			xb.emplace_back(static_cast<float>(x[i]));
+			yb.emplace_back(static_cast<float>(y[i]));
+			xw.push_back(static_cast<float>(xb.back()));
+			yw.push_back(static_cast<float>(yb.back()));
+		}
+		CHECK(kernels.bfloat16_dot(xb, yb) == Approx(reference_dot(xw, yw)).margin(1e-9));
+	}
+	SECTION("int8 is exact, even at the ends of the range") {
+		auto xi = std::vector<std::int8_t>(n);
+		auto yi = std::vector<std::int8_t>(n);
+		auto expected = std::int64_t{0};
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			xi[i] = static_cast<std::int8_t>(i % 3 == 0 ? -128 : static_cast<int>(x[i] * 12));
+			yi[i] = static_cast<std::int8_t>(i % 3 == 0 ? -128 : static_cast<int>(y[i] * 12));
+			expected += xi[i] * yi[i];
+		}
+		CHECK(kernels.int8_dot(xi, yi) == expected);
+	}
+}
+
+TEST_CASE("kernels: the tail of a vector is never written past its end") {
+	auto const width =
+	   GENERATE(simd_width::scalar, simd_width::sse2, simd_width::avx2, simd_width::avx512);
+	if (not comp6771::kernels::is_supported(width)) {
+		return;
+	}
+	auto const& kernels = comp6771::kernels::kernels_for(width);
+	auto buffer = std::vector<double>(40, 1.0);
+	auto const x = std::vector<double>(40, 1.0);
+	auto const live = std::span<double>(buffer.data(), 13);
+	auto const x13 = std::span<double const>(x.data(), 13);
+	kernels.axpy(1.0, x13, live);
+	kernels.scale(5.0, live);
+	kernels.divide(2.0, live);
+	kernels.axpby(1.0, x13, 1.0, live);
+	kernels.scale_add(1.0, 1.0, live);
+	kernels.multiply_elementwise(x13, live);
+	kernels.divide_elementwise(x13, live);
+	CHECK(buffer[12] == 7.0);
+	CHECK(buffer[13] == 1.0);
+	CHECK(buffer[39] == 1.0);
+}
+
+TEST_CASE("dot no longer truncates its result to an integer") {
+	auto const a1 = comp6771::euclidean_vector{1.5, 0.25};
+	auto const a2 = comp6771::euclidean_vector{1.5, 2};
+	CHECK(comp6771::dot(a1, a2) == 2.75);
+	CHECK(comp6771::euclidean_norm(a1) == Approx(std::sqrt(2.3125)));
+}
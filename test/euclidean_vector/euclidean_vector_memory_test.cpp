@@ -0,0 +1,257 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_memory.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace {
+	auto constexpr large = comp6771::euclidean_vector::inline_capacity + 1;
+
+	// forwards to new_delete_resource() and keeps track of what is outstanding
+	class counting_resource : public std::pmr::memory_resource {
+	public:
+		int allocations = 0;
+		int outstanding = 0;
+		std::size_t outstanding_bytes = 0;
+
+	private:
+		auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+			++allocations;
+			++outstanding;
+			outstanding_bytes += bytes;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+		auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override {
+			--outstanding;
+			outstanding_bytes -= bytes;
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+		[[nodiscard]] auto do_is_equal(std::pmr::memory_resource const& other) const noexcept
+		   -> bool override {
+			return this == &other;
+		}
+	};
+
+	auto is_aligned(void const* p, std::size_t alignment) -> bool {
+		return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+	}
+} // namespace
+
+TEST_CASE("pmr: allocator-extended constructors allocate from the resource") {
+	auto resource = counting_resource();
+	auto const values = std::vector<double>(large, 2.5);
+	{
+		auto const a1 = comp6771::euclidean_vector(large, &resource);
+		auto const a2 = comp6771::euclidean_vector(large, 1.5, &resource);
+		auto const a3 = comp6771::euclidean_vector(values.begin(), values.end(), &resource);
+		CHECK(resource.outstanding == 3);
+		CHECK(resource.outstanding_bytes == 3 * large * sizeof(double));
+		CHECK(a1.get_allocator().resource() == &resource);
+		CHECK(a1 == comp6771::euclidean_vector(large));
+		CHECK(a2 == comp6771::euclidean_vector(large, 1.5));
+		CHECK(a3 == comp6771::euclidean_vector(values.begin(), values.end()));
+	}
+	CHECK(resource.outstanding == 0);
+}
+
+TEST_CASE("pmr: small vectors never touch the resource") {
+	auto resource = counting_resource();
+	auto const a1 = comp6771::euclidean_vector(&resource);
+	auto const a2 = comp6771::euclidean_vector(3, 1.5, &resource);
+	auto const a3 = comp6771::euclidean_vector({1.0, 2.0, 3.0}, &resource);
+	CHECK(resource.allocations == 0);
+	CHECK(a1.dimensions() == 1);
+	CHECK(a3 == comp6771::euclidean_vector{1.0, 2.0, 3.0});
+}
+
+TEST_CASE("pmr: the default resource is used when none is given") {
+	auto const a1 = comp6771::euclidean_vector(large);
+	CHECK(a1.get_allocator().resource() == std::pmr::get_default_resource());
+}
+
+TEST_CASE("pmr: copy and move propagation") {
+	auto resource = counting_resource();
+	auto other = counting_resource();
+	auto const source = comp6771::euclidean_vector(large, 1.5, &resource);
+
+	SECTION("copy construction uses the default resource") {
+		auto const copy = comp6771::euclidean_vector(source);
+		CHECK(copy.get_allocator().resource() == std::pmr::get_default_resource());
+		CHECK(copy == source);
+		CHECK(resource.allocations == 1);
+	}
+
+	SECTION("allocator-extended copy construction uses the given resource") {
+		auto const copy = comp6771::euclidean_vector(source, &other);
+		CHECK(copy.get_allocator().resource() == &other);
+		CHECK(other.outstanding == 1);
+		CHECK(copy == source);
+	}
+
+	SECTION("move construction takes the source's resource and storage") {
+		auto a1 = comp6771::euclidean_vector(large, 2.5, &resource);
+		auto const* const data = &a1[0];
+		auto a2 = comp6771::euclidean_vector(std::move(a1));
+		CHECK(a2.get_allocator().resource() == &resource);
+		CHECK(&a2[0] == data);
+		CHECK(resource.allocations == 2);
+	}
+
+	SECTION("allocator-extended move construction copies into a different resource") {
+		auto a1 = comp6771::euclidean_vector(large, 2.5, &resource);
+		auto const a2 = comp6771::euclidean_vector(std::move(a1), &other);
+		CHECK(a2.get_allocator().resource() == &other);
+		CHECK(a2 == comp6771::euclidean_vector(large, 2.5));
+		CHECK(other.outstanding == 1);
+	}
+
+	SECTION("copy assignment keeps the target's resource") {
+		auto target = comp6771::euclidean_vector(2, &other);
+		target = source;
+		CHECK(target.get_allocator().resource() == &other);
+		CHECK(other.outstanding == 1);
+		CHECK(target == source);
+	}
+
+	SECTION("move assignment from the same resource takes the storage") {
+		auto a1 = comp6771::euclidean_vector(large, 2.5, &resource);
+		auto const* const data = &a1[0];
+		auto target = comp6771::euclidean_vector(large, &resource);
+		target = std::move(a1);
+		CHECK(&target[0] == data);
+		CHECK(resource.outstanding == 2);
+	}
+
+	SECTION("move assignment from a different resource copies") {
+		auto a1 = comp6771::euclidean_vector(large, 2.5, &resource);
+		auto target = comp6771::euclidean_vector(2, &other);
+		target = std::move(a1);
+		CHECK(target.get_allocator().resource() == &other);
+		CHECK(target == comp6771::euclidean_vector(large, 2.5));
+		CHECK(other.outstanding == 1);
+	}
+
+	SECTION("move assignment into a resource that can't allocate throws") {
+		auto a1 = comp6771::euclidean_vector(large, 2.5, &resource);
+		auto target = comp6771::euclidean_vector(2, 1.5, std::pmr::null_memory_resource());
+		CHECK_THROWS_AS(target = std::move(a1), std::bad_alloc);
+		CHECK(target.dimensions() == 0);
+		// NOLINTNEXTLINE(bugprone-use-after-move)
+		CHECK(a1 == comp6771::euclidean_vector(large, 2.5));
+	}
+	CHECK(other.outstanding <= 1);
+}
+
+TEST_CASE("pmr: std::pmr containers pass their resource to their elements") {
+	auto resource = counting_resource();
+	auto vectors = std::pmr::vector<comp6771::euclidean_vector>(&resource);
+	vectors.emplace_back(large, 1.5);
+	CHECK(vectors.front().get_allocator().resource() == &resource);
+}
+
+TEST_CASE("pmr: released storage goes back to the resource it came from") {
+	auto resource = counting_resource();
+	auto a1 = comp6771::euclidean_vector(large, 1.5, &resource);
+	auto storage = a1.release();
+	CHECK(storage.get_allocator().resource() == &resource);
+	{
+		auto const adopted = comp6771::euclidean_vector(std::move(storage));
+		CHECK(adopted.get_allocator().resource() == &resource);
+		CHECK(resource.allocations == 1);
+		CHECK(is_aligned(adopted.magnitudes().data(), comp6771::euclidean_vector::storage_alignment));
+	}
+	CHECK(resource.outstanding == 0);
+
+	auto a2 = comp6771::euclidean_vector(large, 1.5, &resource);
+	static_cast<void>(a2.release());
+	CHECK(resource.outstanding == 0);
+}
+
+TEST_CASE("arena_resource") {
+	auto upstream = counting_resource();
+	auto arena = comp6771::pmr::arena_resource(1024, &upstream);
+
+	SECTION("allocations are aligned and come from one chunk") {
+		auto* const p1 = arena.allocate(24, 8);
+		auto* const p2 = arena.allocate(100, 64);
+		auto* const p3 = arena.allocate(8, 8);
+		CHECK(is_aligned(p1, 8));
+		CHECK(is_aligned(p2, 64));
+		CHECK(is_aligned(p3, 8));
+		CHECK(upstream.allocations == 1);
+	}
+
+	SECTION("deallocating the most recent allocation reclaims it") {
+		auto* const p1 = arena.allocate(128, 8);
+		arena.deallocate(p1, 128, 8);
+		CHECK(arena.allocate(128, 8) == p1);
+	}
+
+	SECTION("chunks grow to fit large requests") {
+		auto const v = comp6771::euclidean_vector(1000, 1.5, &arena);
+		CHECK(euclidean_norm(v) > 0);
+		CHECK(upstream.outstanding == 1);
+		CHECK(upstream.outstanding_bytes >= 1000 * sizeof(double));
+	}
+
+	SECTION("rewind keeps only the largest chunk") {
+		for (auto i = 0; i < 10; ++i) {
+			[[maybe_unused]] auto* const p = arena.allocate(512, 8);
+		}
+		CHECK(upstream.outstanding > 1);
+		arena.rewind();
+		CHECK(upstream.outstanding == 1);
+		auto const allocations = upstream.allocations;
+		[[maybe_unused]] auto* const p = arena.allocate(512, 8);
+		CHECK(upstream.allocations == allocations);
+	}
+
+	SECTION("release returns everything upstream") {
+		[[maybe_unused]] auto* const p = arena.allocate(4096, 8);
+		arena.release();
+		CHECK(upstream.outstanding == 0);
+	}
+}
+
+TEST_CASE("pool_resource") {
+	auto upstream = counting_resource();
+	auto pool = comp6771::pmr::pool_resource(&upstream);
+
+	SECTION("freed blocks are reused") {
+		auto* const p1 = pool.allocate(large * sizeof(double), alignof(double));
+		CHECK(is_aligned(p1, comp6771::pmr::pool_resource::block_alignment));
+		pool.deallocate(p1, large * sizeof(double), alignof(double));
+		CHECK(pool.allocate(large * sizeof(double), alignof(double)) == p1);
+		CHECK(upstream.allocations == 1);
+	}
+
+	SECTION("vectors of similar sizes share a class") {
+		auto const allocations = [&] {
+			auto const a1 = comp6771::euclidean_vector(100, 1.5, &pool);
+			return upstream.allocations;
+		}();
+		auto const a2 = comp6771::euclidean_vector(120, 2.5, &pool);
+		CHECK(upstream.allocations == allocations);
+		CHECK(a2 == comp6771::euclidean_vector(120, 2.5));
+	}
+
+	SECTION("requests bigger than the largest class go upstream") {
+		auto const bytes = comp6771::pmr::pool_resource::max_block_bytes + 1;
+		auto* const p = pool.allocate(bytes, alignof(double));
+		CHECK(upstream.outstanding_bytes == bytes);
+		pool.deallocate(p, bytes, alignof(double));
+		CHECK(upstream.outstanding == 0);
+	}
+
+	SECTION("release returns every chunk") {
+		[[maybe_unused]] auto* const p1 = pool.allocate(64, 8);
+		[[maybe_unused]] auto* const p2 = pool.allocate(1000, 8);
+		pool.release();
+		CHECK(upstream.outstanding == 0);
+	}
+}
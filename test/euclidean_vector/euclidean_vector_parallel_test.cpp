@@ -0,0 +1,190 @@
+#include "comp6771/euclidean_vector_parallel.hpp"
+#include "comp6771/thread_pool.hpp"
+
+#include "vector_factory.hpp"
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace {
+	// long enough to go through the pool, and not a whole number of chunks
+	auto constexpr large = static_cast<int>(comp6771::parallel_threshold * 2 + 1234);
+
+	using comp6771::test::make_vector;
+} // namespace
+
+TEST_CASE("thread_pool runs every index exactly once") {
+	auto pool = comp6771::thread_pool(GENERATE(1, 2, 4));
+	auto hits = std::vector<std::atomic<int>>(1000);
+	pool.parallel_for(hits.size(), [&hits](std::size_t i) { ++hits[i]; });
+	for (auto const& hit : hits) {
+		CHECK(hit == 1);
+	}
+
+	SECTION("loops nest") {
+		auto total = std::atomic<int>(0);
+		pool.parallel_for(8, [&pool, &total](std::size_t) {
+			pool.parallel_for(8, [&total](std::size_t) { ++total; });
+		});
+		CHECK(total == 64);
+	}
+
+	SECTION("the first exception is rethrown on the caller") {
+		auto const throw_at_37 = [](std::size_t i) {
+			if (i == 37) {
+				throw comp6771::euclidean_vector_error("37");
+			}
+		};
+		CHECK_THROWS_MATCHES(pool.parallel_for(100, throw_at_37),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("37"));
+		// and the pool is still usable afterwards
+		auto count = std::atomic<int>(0);
+		pool.parallel_for(10, [&count](std::size_t) { ++count; });
+		CHECK(count == 10);
+	}
+}
+
+TEST_CASE("parallel reductions don't depend on the number of threads") {
+	auto const a = make_vector(large, 0.0);
+	auto const b = make_vector(large, 1.0);
+
+	auto serial_pool = comp6771::thread_pool(1);
+	auto const expected_dot = comp6771::dot(serial_pool, a, b);
+	auto const expected_norm = comp6771::euclidean_norm(serial_pool, a);
+	CHECK(expected_dot == Approx(comp6771::dot(a, b)));
+	CHECK(expected_norm == Approx(comp6771::euclidean_norm(a)));
+
+	auto pool = comp6771::thread_pool(GENERATE(2, 3, 8));
+	for (auto run = 0; run < 3; ++run) {
+		CHECK(comp6771::dot(pool, a, b) == expected_dot);
+		CHECK(comp6771::euclidean_norm(pool, a) == expected_norm);
+	}
+}
+
+TEST_CASE("parallel reductions honour the reduction mode") {
+	auto const a = make_vector(large, 0.0);
+	auto const b = make_vector(large, 1.0);
+	auto serial_pool = comp6771::thread_pool(1);
+	auto pool = comp6771::thread_pool(GENERATE(2, 5));
+	for (auto const mode : {comp6771::reduction::blocked, comp6771::reduction::compensated}) {
+		CHECK(comp6771::dot(pool, a, b, mode) == comp6771::dot(serial_pool, a, b, mode));
+		CHECK(comp6771::dot(pool, a, b, mode) == Approx(comp6771::dot(a, b, mode)));
+	}
+	// chunks continue the pairwise tree, so pairwise matches the serial sum exactly
+	CHECK(comp6771::dot(pool, a, b, comp6771::reduction::pairwise)
+	      == comp6771::dot(a, b, comp6771::reduction::pairwise));
+	CHECK(comp6771::euclidean_norm(pool, a, comp6771::reduction::pairwise)
+	      == comp6771::euclidean_norm(a, comp6771::reduction::pairwise));
+}
+
+TEST_CASE("small vectors give the same result as the serial operations") {
+	auto pool = comp6771::thread_pool(4);
+	auto const a = make_vector(1000, 0.0);
+	auto const b = make_vector(1000, 1.0);
+	CHECK(comp6771::dot(pool, a, b) == comp6771::dot(a, b));
+	CHECK(comp6771::euclidean_norm(pool, a) == comp6771::euclidean_norm(a));
+}
+
+TEST_CASE("parallel compound operations") {
+	auto pool = comp6771::thread_pool(3);
+	auto const dimensions = GENERATE(10, large);
+	auto const b = make_vector(dimensions, 1.0);
+	auto a = make_vector(dimensions, 0.0);
+	auto const original = a;
+
+	comp6771::add_assign(pool, a, b);
+	CHECK(a == original + b);
+	comp6771::subtract_assign(pool, a, b);
+	comp6771::multiply_assign(pool, a, 4.0);
+	CHECK(a == original * 4.0);
+	comp6771::divide_assign(pool, a, 4.0);
+	CHECK(a == original);
+	// writing through the pool invalidates the norm cache like any other write
+	auto const norm = comp6771::euclidean_norm(a);
+	comp6771::multiply_assign(pool, a, 2.0);
+	CHECK(comp6771::euclidean_norm(a) == Approx(2 * norm));
+
+	CHECK_THROWS_MATCHES(comp6771::add_assign(pool, a, comp6771::euclidean_vector(3)),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not match"));
+	CHECK_THROWS_MATCHES(comp6771::divide_assign(pool, a, 0.0),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Invalid vector division by 0"));
+}
+
+TEST_CASE("parallel_for_each balances uneven elements") {
+	auto pool = comp6771::thread_pool(GENERATE(1, 4));
+	// a few huge vectors among many tiny ones
+	auto vectors = std::vector<comp6771::euclidean_vector>();
+	for (auto i = 0; i < 200; ++i) {
+		vectors.push_back(make_vector(i % 50 == 0 ? 100'000 : 1 + i % 7, i));
+	}
+	auto const expected = [&vectors] {
+		auto result = std::vector<comp6771::euclidean_vector>();
+		for (auto const& v : vectors) {
+			result.push_back(comp6771::unit(v));
+		}
+		return result;
+	}();
+
+	comp6771::parallel_for_each(pool, vectors, [](comp6771::euclidean_vector& v) {
+		v /= comp6771::euclidean_norm(v);
+	});
+	for (auto i = std::size_t{0}; i < vectors.size(); ++i) {
+		CHECK(vectors[i] == expected[i]);
+	}
+
+	SECTION("exceptions from one element reach the caller") {
+		auto const other = comp6771::euclidean_vector(7, 1.0);
+		auto const add_other = [&other](comp6771::euclidean_vector& v) { v += other; };
+		CHECK_THROWS_MATCHES(comp6771::parallel_for_each(pool, vectors, add_other),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not "
+		                                              "match"));
+	}
+}
+
+TEST_CASE("parallel_transform_reduce is deterministic") {
+	auto vectors = std::vector<comp6771::euclidean_vector>();
+	for (auto i = 0; i < 1001; ++i) {
+		vectors.push_back(make_vector(1 + i % 13, i));
+	}
+	auto const norm = [](comp6771::euclidean_vector const& v) {
+		return comp6771::euclidean_norm(v);
+	};
+
+	auto serial_pool = comp6771::thread_pool(1);
+	auto const expected =
+	   comp6771::parallel_transform_reduce(serial_pool, vectors, 0.0, std::plus<>(), norm);
+	auto serial = 0.0;
+	for (auto const& v : vectors) {
+		serial += comp6771::euclidean_norm(v);
+	}
+	CHECK(expected == Approx(serial));
+
+	auto pool = comp6771::thread_pool(GENERATE(2, 3, 8));
+	CHECK(comp6771::parallel_transform_reduce(pool, vectors, 0.0, std::plus<>(), norm) == expected);
+
+	SECTION("reducing euclidean_vectors") {
+		auto const same_size = std::vector<comp6771::euclidean_vector>(100, make_vector(5, 0.0));
+		auto const sum = comp6771::parallel_transform_reduce(
+		   pool,
+		   same_size,
+		   comp6771::euclidean_vector(5),
+		   [](comp6771::euclidean_vector total, comp6771::euclidean_vector const& v) {
+			   total += v;
+			   return total;
+		   },
+		   [](comp6771::euclidean_vector const& v) { return v * 2.0; });
+		CHECK(sum == make_vector(5, 0.0) * 200.0);
+	}
+
+	SECTION("an empty range gives init") {
+		auto const none = std::vector<comp6771::euclidean_vector>();
+		CHECK(comp6771::parallel_transform_reduce(pool, none, 42.0, std::plus<>(), norm) == 42.0);
+	}
+}
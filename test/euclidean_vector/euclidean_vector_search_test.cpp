@@ -0,0 +1,170 @@
+#include "comp6771/euclidean_vector_search.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+	auto make_vectors(std::size_t count, int dimensions, std::uint64_t seed)
+	   -> std::vector<comp6771::euclidean_vector> {
+		auto engine = std::mt19937_64(seed);
+		auto distribution = std::uniform_real_distribution<double>(-1.0, 1.0);
+		auto result = std::vector<comp6771::euclidean_vector>();
+		result.reserve(count);
+		for (auto i = std::size_t{0}; i < count; ++i) {
+			result.emplace_back(dimensions, [&](int) { return distribution(engine); });
+		}
+		return result;
+	}
+
+	// compares the query with every vector and sorts the lot
+	auto brute_force(std::vector<comp6771::euclidean_vector> const& vectors,
+	                 comp6771::euclidean_vector const& query,
+	                 std::size_t k) -> std::vector<comp6771::neighbour> {
+		auto result = std::vector<comp6771::neighbour>();
+		for (auto i = std::size_t{0}; i < vectors.size(); ++i) {
+			auto squared_distance = 0.0;
+			for (auto j = 0; j < query.dimensions(); ++j) {
+				auto const difference = vectors[i][j] - query[j];
+				squared_distance += difference * difference;
+			}
+			result.push_back({i, squared_distance});
+		}
+		std::ranges::sort(result, [](auto const& x, auto const& y) {
+			return x.squared_distance < y.squared_distance
+			       or (x.squared_distance == y.squared_distance and x.index < y.index);
+		});
+		result.resize(std::min(k, result.size()));
+		return result;
+	}
+
+	// the kernels may sum in a different order to brute_force
+	auto check_neighbours(std::vector<comp6771::neighbour> const& actual,
+	                      std::vector<comp6771::neighbour> const& expected) -> void {
+		REQUIRE(actual.size() == expected.size());
+		for (auto i = std::size_t{0}; i < actual.size(); ++i) {
+			CHECK(actual[i].index == expected[i].index);
+			CHECK(actual[i].squared_distance == Approx(expected[i].squared_distance));
+		}
+	}
+} // namespace
+
+TEST_CASE("every index finds the same neighbours as a brute-force search") {
+	auto const dimensions = GENERATE(1, 3, 16, 67);
+	auto const vectors = make_vectors(500, dimensions, 1);
+	auto const queries = make_vectors(20, dimensions, 2);
+	auto const k = GENERATE(std::size_t{1}, std::size_t{10});
+
+	auto const exact = comp6771::exact_index(vectors);
+	auto const tree = comp6771::kd_tree(vectors, 8);
+	auto const ivf = comp6771::ivf_index(vectors);
+	CHECK(exact.size() == vectors.size());
+	CHECK(tree.size() == vectors.size());
+	CHECK(ivf.size() == vectors.size());
+	CHECK(exact.dimensions() == dimensions);
+	CHECK(tree.dimensions() == dimensions);
+	CHECK(ivf.dimensions() == dimensions);
+
+	auto const batch = exact.search(queries, k);
+	REQUIRE(batch.size() == queries.size());
+	for (auto q = std::size_t{0}; q < queries.size(); ++q) {
+		auto const expected = brute_force(vectors, queries[q], k);
+		check_neighbours(exact.search(queries[q], k), expected);
+		check_neighbours(batch[q], expected);
+		check_neighbours(tree.search(queries[q], k), expected);
+		// probing every cluster is an exhaustive search
+		check_neighbours(ivf.search(queries[q], k, ivf.lists()), expected);
+	}
+}
+
+TEST_CASE("ivf_index's recall improves with more probes") {
+	auto const vectors = make_vectors(2000, 8, 3);
+	auto const queries = make_vectors(50, 8, 4);
+	auto const ivf = comp6771::ivf_index(vectors, {.lists = 32});
+	CHECK(ivf.lists() == 32);
+
+	auto const exact = comp6771::exact_index(vectors);
+	auto const recall = [&](std::size_t probes) {
+		auto found = 0;
+		for (auto const& query : queries) {
+			auto const expected = exact.search(query, 10);
+			for (auto const& n : ivf.search(query, 10, probes)) {
+				found += static_cast<int>(std::ranges::count(expected, n));
+			}
+		}
+		return found;
+	};
+	auto const one = recall(1);
+	auto const eight = recall(8);
+	CHECK(one <= eight);
+	CHECK(eight <= recall(32));
+	CHECK(recall(32) == 10 * static_cast<int>(queries.size()));
+
+	SECTION("the same seed builds the same index") {
+		auto const again = comp6771::ivf_index(vectors, {.lists = 32});
+		for (auto const& query : queries) {
+			CHECK(again.search(query, 10, 4) == ivf.search(query, 10, 4));
+		}
+	}
+}
+
+TEST_CASE("searches handle edge cases") {
+	auto const vectors = std::vector<comp6771::euclidean_vector>{
+	   comp6771::euclidean_vector{1.0, 0.0},
+	   comp6771::euclidean_vector{0.0, 1.0},
+	   comp6771::euclidean_vector{1.0, 0.0},
+	   comp6771::euclidean_vector{-1.0, 0.0},
+	};
+	auto const exact = comp6771::exact_index(vectors);
+	auto const tree = comp6771::kd_tree(vectors, 1);
+	auto const ivf = comp6771::ivf_index(vectors, {.lists = 2});
+	auto const query = comp6771::euclidean_vector{1.0, 0.0};
+
+	SECTION("ties are broken by index") {
+		auto const expected = std::vector<comp6771::neighbour>{{0, 0.0}, {2, 0.0}, {1, 2.0}};
+		CHECK(exact.search(query, 3) == expected);
+		CHECK(tree.search(query, 3) == expected);
+		CHECK(ivf.search(query, 3, 2) == expected);
+	}
+
+	SECTION("k larger than the index returns every vector, sorted") {
+		auto const expected = brute_force(vectors, query, vectors.size());
+		// only the vectors there are get room, however large k is
+		auto const k = GENERATE(std::size_t{10}, std::numeric_limits<std::size_t>::max());
+		CHECK(exact.search(query, k) == expected);
+		CHECK(tree.search(query, k) == expected);
+		CHECK(ivf.search(query, k, 10) == expected);
+		auto const batch = exact.search(std::vector{query, query}, k);
+		CHECK(batch == std::vector{expected, expected});
+	}
+
+	SECTION("k of zero, or an empty index, returns nothing") {
+		CHECK(exact.search(query, 0).empty());
+		CHECK(tree.search(query, 0).empty());
+		CHECK(ivf.search(query, 0, 2).empty());
+		auto const none = std::vector<comp6771::euclidean_vector>();
+		CHECK(comp6771::exact_index(none).search(query, 3).empty());
+		CHECK(comp6771::kd_tree(none).search(query, 3).empty());
+		CHECK(comp6771::ivf_index(none).search(query, 3, 1).empty());
+	}
+
+	SECTION("mismatched dimensions throw") {
+		auto const wrong = comp6771::euclidean_vector{1.0, 0.0, 0.0};
+		auto const message = Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not match");
+		CHECK_THROWS_MATCHES(exact.search(wrong, 1), comp6771::euclidean_vector_error, message);
+		CHECK_THROWS_MATCHES(tree.search(wrong, 1), comp6771::euclidean_vector_error, message);
+		CHECK_THROWS_MATCHES(ivf.search(wrong, 1, 1), comp6771::euclidean_vector_error, message);
+		auto const batch = std::vector<comp6771::euclidean_vector>{query, wrong};
+		CHECK_THROWS_MATCHES(exact.search(batch, 1), comp6771::euclidean_vector_error, message);
+
+		auto mixed = vectors;
+		mixed.push_back(wrong);
+		CHECK_THROWS_MATCHES(comp6771::exact_index(mixed),
+		                     comp6771::euclidean_vector_error,
+		                     message);
+	}
+}
@@ -0,0 +1,150 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include "allocation_counter.hpp"
+#include <catch2/catch.hpp>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+	auto constexpr small = comp6771::euclidean_vector::inline_capacity;
+	auto constexpr large = comp6771::euclidean_vector::inline_capacity + 1;
+
+	auto magnitudes(int dimensions) -> std::vector<double> {
+		auto result = std::vector<double>(static_cast<std::size_t>(dimensions));
+		for (auto i = std::size_t{0}; i < result.size(); ++i) {
+			result[i] = static_cast<double>(i) + 0.5;
+		}
+		return result;
+	}
+} // namespace
+
+TEST_CASE("small buffer: vectors up to inline_capacity never allocate") {
+	auto const values = magnitudes(small);
+	auto const counter = comp6771::test::allocation_counter();
+
+	auto const a1 = comp6771::euclidean_vector();
+	auto const a2 = comp6771::euclidean_vector(small);
+	auto const a3 = comp6771::euclidean_vector(small, 1.5);
+	auto const a4 = comp6771::euclidean_vector(values.begin(), values.end());
+	auto const a5 = comp6771::euclidean_vector{1, 2, 3, 4};
+	auto a6 = a4;
+	auto a7 = std::move(a6);
+	a6 = a7;
+	a7 = std::move(a6);
+	auto const a8 = comp6771::euclidean_vector(a3 + a4 * 2);
+	auto const a9 = -a8;
+
+	CHECK(counter.count() == 0);
+	CHECK(a1.dimensions() == 1);
+	CHECK(static_cast<std::vector<double>>(a7) == values);
+	CHECK(a9[1] == -(1.5 + 1.5 * 2));
+}
+
+TEST_CASE("small buffer: larger vectors allocate exactly once") {
+	auto const values = magnitudes(large);
+	auto const counter = comp6771::test::allocation_counter();
+	auto a1 = comp6771::euclidean_vector(values.begin(), values.end());
+	CHECK(counter.count() == 1);
+	auto a2 = std::move(a1);
+	CHECK(counter.count() == 1);
+	auto const a3 = a2;
+	CHECK(counter.count() == 2);
+	CHECK(static_cast<std::vector<double>>(a3) == values);
+}
+
+TEST_CASE("small buffer: moves across the inline/heap boundary") {
+	auto const small_values = magnitudes(small);
+	auto const large_values = magnitudes(large);
+	static_assert(std::is_nothrow_move_constructible_v<comp6771::euclidean_vector>);
+
+	SECTION("heap into inline") {
+		auto a1 = comp6771::euclidean_vector(small_values.begin(), small_values.end());
+		auto a2 = comp6771::euclidean_vector(large_values.begin(), large_values.end());
+		a1 = std::move(a2);
+		CHECK(static_cast<std::vector<double>>(a1) == large_values);
+		// NOLINTNEXTLINE(bugprone-use-after-move)
+		CHECK(a2.dimensions() == 0);
+		a2 = comp6771::euclidean_vector{1, 2};
+		CHECK(a2 == comp6771::euclidean_vector{1, 2});
+	}
+	SECTION("inline into heap") {
+		auto a1 = comp6771::euclidean_vector(large_values.begin(), large_values.end());
+		auto a2 = comp6771::euclidean_vector(small_values.begin(), small_values.end());
+		a1 = std::move(a2);
+		CHECK(static_cast<std::vector<double>>(a1) == small_values);
+		// NOLINTNEXTLINE(bugprone-use-after-move)
+		CHECK(a2.dimensions() == 0);
+	}
+	SECTION("copy assignment across the boundary in both directions") {
+		auto a1 = comp6771::euclidean_vector(small_values.begin(), small_values.end());
+		auto const a2 = comp6771::euclidean_vector(large_values.begin(), large_values.end());
+		auto const a3 = comp6771::euclidean_vector(small_values.begin(), small_values.end());
+		a1 = a2;
+		CHECK(a1 == a2);
+		a1 = a3;
+		CHECK(a1 == a3);
+	}
+	SECTION("self move assignment") {
+		auto a1 = comp6771::euclidean_vector(small_values.begin(), small_values.end());
+		auto& alias = a1;
+		a1 = std::move(alias);
+		CHECK(static_cast<std::vector<double>>(a1) == small_values);
+	}
+}
+
+TEST_CASE("small buffer: rvalues hand their storage over instead of copying it") {
+	auto const large_values = magnitudes(large);
+	auto a1 = comp6771::euclidean_vector(large_values.begin(), large_values.end());
+	auto const a2 = comp6771::euclidean_vector(large, 0.5);
+	auto const* const data = a1.magnitudes().data();
+
+	SECTION("release and adopt") {
+		auto const counter = comp6771::test::allocation_counter();
+		auto storage = a1.release();
+		CHECK(a1.dimensions() == 0);
+		CHECK(storage.magnitudes().data() == data);
+		auto const adopted = comp6771::euclidean_vector(std::move(storage));
+		CHECK(counter.count() == 0);
+		CHECK(adopted.magnitudes().data() == data);
+		CHECK(static_cast<std::vector<double>>(adopted) == large_values);
+		CHECK(storage.magnitudes().empty()); // NOLINT(bugprone-use-after-move)
+	}
+	SECTION("releasing an inline vector allocates its storage") {
+		auto small_vector = comp6771::euclidean_vector{1, 2, 3};
+		auto const counter = comp6771::test::allocation_counter();
+		auto storage = small_vector.release();
+		CHECK(counter.count() == 1);
+		auto const adopted = comp6771::euclidean_vector(std::move(storage));
+		CHECK(counter.count() == 1);
+		CHECK(adopted == comp6771::euclidean_vector{1, 2, 3});
+	}
+	SECTION("unary operators on an rvalue") {
+		auto const counter = comp6771::test::allocation_counter();
+		auto negated = -std::move(a1);
+		auto const same = +std::move(negated);
+		CHECK(counter.count() == 0);
+		CHECK(same.magnitudes().data() == data);
+		CHECK(same[1] == -large_values[1]);
+	}
+	SECTION("binary operators with an rvalue on the left") {
+		auto const counter = comp6771::test::allocation_counter();
+		auto const result = std::move(a1) - a2 + a2 * 2;
+		CHECK(counter.count() == 0);
+		CHECK(result.magnitudes().data() == data);
+		CHECK(result[1] == large_values[1] + 0.5);
+	}
+	SECTION("conversions from an rvalue free the vector's storage") {
+		auto const values = static_cast<std::vector<double>>(std::move(a1));
+		CHECK(values == large_values);
+		CHECK(a1.dimensions() == 0); // NOLINT(bugprone-use-after-move)
+	}
+	SECTION("constructing from an rvalue std::vector frees it") {
+		auto source = large_values;
+		auto const counter = comp6771::test::allocation_counter();
+		auto const consumed = comp6771::euclidean_vector(std::move(source));
+		CHECK(counter.count() == 1);
+		CHECK(source.capacity() == 0); // NOLINT(bugprone-use-after-move)
+		CHECK(static_cast<std::vector<double>>(consumed) == large_values);
+	}
+}
@@ -0,0 +1,215 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_stats.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Built once for each COMP6771_EUCLIDEAN_VECTOR_STATS level, so every count is checked against
+// what that level records.
+namespace {
+	using comp6771::stats::counter;
+	using comp6771::stats::operation;
+
+	auto counted(std::uint64_t n) -> std::uint64_t {
+		return comp6771::stats::counters_enabled ? n : 0;
+	}
+
+	// what has been recorded since it was constructed
+	class recorder {
+	public:
+		[[nodiscard]] auto recorded() const -> comp6771::stats::snapshot {
+			return comp6771::stats::take_snapshot() - start_;
+		}
+
+	private:
+		comp6771::stats::snapshot start_ = comp6771::stats::take_snapshot();
+	};
+} // namespace
+
+TEST_CASE("stats: allocations are counted, and inline storage isn't one") {
+	auto const r = recorder();
+	{
+		auto const small = comp6771::euclidean_vector(comp6771::euclidean_vector::inline_capacity);
+		auto const large = comp6771::euclidean_vector(1000);
+	}
+	auto const s = r.recorded();
+	CHECK(s[counter::allocations] == counted(1));
+	CHECK(s[counter::allocated_bytes] == counted(1000 * sizeof(double)));
+}
+
+TEST_CASE("stats: deep copies and moves are counted apart") {
+	auto const a = comp6771::euclidean_vector(1000, 1.0);
+	auto const r = recorder();
+	auto b = a;
+	auto c = std::move(b);
+	auto d = comp6771::euclidean_vector(1000);
+	d = a;
+	d = std::move(c);
+	auto const s = r.recorded();
+	CHECK(s[counter::deep_copies] == counted(2));
+	CHECK(s[counter::moves] == counted(2));
+	CHECK(s[counter::allocations] == counted(2));
+}
+
+TEST_CASE("stats: dimension mismatches are counted where they're thrown") {
+	auto x = comp6771::euclidean_vector{1.0, 2.0};
+	auto const y = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+	auto const r = recorder();
+	CHECK_THROWS_AS(comp6771::dot(x, y), comp6771::euclidean_vector_error);
+	CHECK_THROWS_AS(x += y, comp6771::euclidean_vector_error);
+	CHECK_THROWS_AS(x + y, comp6771::euclidean_vector_error);
+	CHECK_THROWS_AS(x.axpy(1.0, y), comp6771::euclidean_vector_error);
+	CHECK(r.recorded()[counter::dimension_mismatches] == counted(4));
+}
+
+TEST_CASE("stats: operations count their calls and elements") {
+	auto x = comp6771::euclidean_vector(100, 1.0);
+	auto const y = comp6771::euclidean_vector(100, 2.0);
+	auto const r = recorder();
+
+	CHECK(comp6771::dot(x, y) == 200.0);
+	CHECK(comp6771::dot(x, y) == 200.0);
+	CHECK(comp6771::euclidean_norm(x) == 10.0);
+	CHECK(comp6771::euclidean_norm(x) == 10.0);
+	auto const z = comp6771::euclidean_vector(x + y);
+	x += y;
+	x -= y;
+	x *= 2.0;
+	x /= 2.0;
+	auto const s = r.recorded();
+
+	CHECK(s[operation::dot].calls == counted(2));
+	CHECK(s[operation::dot].elements == counted(200));
+	CHECK(s[operation::euclidean_norm].calls == counted(1));
+	CHECK(s[counter::norm_cache_hits] == counted(1));
+	CHECK(s[operation::evaluate].calls == counted(1));
+	CHECK(s[operation::evaluate].elements == counted(100));
+	for (auto const op :
+	     {operation::add, operation::subtract, operation::multiply, operation::divide}) {
+		CHECK(s[op].calls == counted(1));
+		CHECK(s[op].elements == counted(100));
+	}
+	CHECK(s[operation::unit].calls == 0);
+
+	SECTION("unit uses the norm that euclidean_norm cached") {
+		CHECK(comp6771::euclidean_norm(x) == 10.0);
+		auto const before = comp6771::stats::take_snapshot();
+		auto const u = comp6771::unit(x);
+		auto const t = comp6771::stats::take_snapshot() - before;
+		CHECK(t[operation::unit].calls == counted(1));
+		CHECK(t[counter::norm_cache_hits] == counted(1));
+		CHECK(t[operation::euclidean_norm].calls == 0);
+		// the division
+		CHECK(t[operation::evaluate].calls == counted(1));
+	}
+}
+
+TEST_CASE("stats: in-place updates are each counted as themselves") {
+	auto x = comp6771::euclidean_vector(100, 1.0);
+	auto const y = comp6771::euclidean_vector(100, 2.0);
+	auto const r = recorder();
+
+	x.axpy(2.0, y);
+	x.axpby(2.0, y, 0.5);
+	x.lerp(y, 0.5);
+	x.scale_add(2.0, 1.0);
+	x.hadamard(y);
+	x.divide(y);
+	x.normalize();
+	auto const s = r.recorded();
+
+	for (auto const op : {operation::axpy,
+	                      operation::axpby,
+	                      operation::lerp,
+	                      operation::scale_add,
+	                      operation::hadamard,
+	                      operation::divide_elementwise,
+	                      operation::normalize})
+	{
+		CHECK(s[op].calls == counted(1));
+		CHECK(s[op].elements == counted(100));
+	}
+	// lerp isn't also an axpby, nor normalize a divide, but normalize does need the norm
+	CHECK(s[operation::divide].calls == 0);
+	CHECK(s[operation::euclidean_norm].calls == counted(1));
+}
+
+TEST_CASE("stats: distances count every candidate's elements as one call") {
+	auto const query = comp6771::euclidean_vector(100, 1.0);
+	auto const candidates = std::vector<comp6771::euclidean_vector>(3, query);
+	auto const r = recorder();
+
+	CHECK(comp6771::distance(query, candidates[0]) == 0.0);
+	CHECK(comp6771::squared_distance(query, candidates[0]) == 0.0);
+	CHECK(comp6771::manhattan_distance(query, candidates[0]) == 0.0);
+	CHECK(comp6771::cosine_similarity(query, candidates[0]) == Approx(1.0));
+	static_cast<void>(comp6771::distance(query, candidates));
+	static_cast<void>(comp6771::squared_distance(query, candidates));
+	static_cast<void>(comp6771::manhattan_distance(query, candidates));
+	static_cast<void>(comp6771::cosine_similarity(query, candidates));
+	auto const s = r.recorded();
+
+	for (auto const op : {operation::distance,
+	                      operation::squared_distance,
+	                      operation::manhattan_distance,
+	                      operation::cosine_similarity})
+	{
+		CHECK(s[op].calls == counted(2));
+		CHECK(s[op].elements == counted(100 + 3 * 100));
+	}
+}
+
+TEST_CASE("stats: timers only run when they're enabled") {
+	auto const x = comp6771::euclidean_vector(1 << 20, 1.0);
+	auto const r = recorder();
+	CHECK(comp6771::dot(x, x) == static_cast<double>(1 << 20));
+	auto const nanoseconds = r.recorded()[operation::dot].nanoseconds;
+	if constexpr (comp6771::stats::timers_enabled) {
+		CHECK(nanoseconds > 0);
+	}
+	else {
+		CHECK(nanoseconds == 0);
+	}
+}
+
+TEST_CASE("stats: a snapshot adds up every thread, including those that have exited") {
+	auto const x = comp6771::euclidean_vector(10, 1.0);
+	auto const r = recorder();
+	auto threads = std::vector<std::thread>();
+	for (auto t = 0; t < 4; ++t) {
+		threads.emplace_back([&x] {
+			for (auto i = 0; i < 25; ++i) {
+				static_cast<void>(comp6771::dot(x, x));
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	CHECK(r.recorded()[operation::dot].calls == counted(100));
+}
+
+TEST_CASE("stats: snapshots are written one total per line") {
+	auto const x = comp6771::euclidean_vector(1000);
+	auto const r = recorder();
+	auto const y = x;
+	auto os = std::ostringstream();
+	os << r.recorded();
+	auto const text = os.str();
+
+	auto const lines = static_cast<std::size_t>(std::ranges::count(text, '\n'));
+	CHECK(lines == comp6771::stats::counter_count + 3 * comp6771::stats::operation_count);
+	CHECK(text.starts_with("allocations " + std::to_string(counted(1)) + "\n"));
+	CHECK(text.find("\ndeep_copies " + std::to_string(counted(1)) + "\n") != std::string::npos);
+	CHECK(text.find("\ndot_calls 0\n") != std::string::npos);
+	CHECK(text.find("\nevaluate_nanoseconds 0\n") != std::string::npos);
+	CHECK(comp6771::stats::name(operation::euclidean_norm) == "euclidean_norm");
+}
@@ -80,18 +80,27 @@ TEST_CASE("copy constructor: shold copy the values in the original euclidean vec
 	CHECK(a2[3] == a1[3]);
 }
 TEST_CASE("move constructor: should move the contents from original vector to new vector") {
-	auto a1 = comp6771::euclidean_vector{1, 2, 5.3, 7.6};
-	auto const* address_of_values_a1 = std::addressof(a1[0]);
+	SECTION("heap storage is handed over") {
+		// only vectors larger than inline_capacity live on the heap
+		auto const values = std::vector<double>(comp6771::euclidean_vector::inline_capacity + 1, 5.3);
+		auto a1 = comp6771::euclidean_vector(values.begin(), values.end());
+		auto const* address_of_values_a1 = std::addressof(a1[0]);
 
-	auto a2 = comp6771::euclidean_vector(std::move(a1));
-	auto const* address_of_values_a2 = std::addressof(a2[0]);
+		auto a2 = comp6771::euclidean_vector(std::move(a1));
+		auto const* address_of_values_a2 = std::addressof(a2[0]);
 
-	CHECK(address_of_values_a1 == address_of_values_a2);
-	REQUIRE(a2.dimensions() == 4);
-	CHECK(a2[0] == 1);
-	CHECK(a2[1] == 2);
-	CHECK(a2[2] == 5.3);
-	CHECK(a2[3] == 7.6);
+		CHECK(address_of_values_a1 == address_of_values_a2);
+		CHECK(static_cast<std::vector<double>>(a2) == values);
+	}
+	SECTION("inline storage is copied") {
+		auto a1 = comp6771::euclidean_vector{1, 2, 5.3, 7.6};
+		auto a2 = comp6771::euclidean_vector(std::move(a1));
+		REQUIRE(a2.dimensions() == 4);
+		CHECK(a2[0] == 1);
+		CHECK(a2[1] == 2);
+		CHECK(a2[2] == 5.3);
+		CHECK(a2[3] == 7.6);
+	}
 }
 
 //-----------------------------------test firend operators----------------------------------------
@@ -155,7 +164,7 @@ TEST_CASE("friend: + -") {
 	SECTION("regular addition") {
 		auto const a1 = comp6771::euclidean_vector{1, 2, 3};
 		auto const a2 = comp6771::euclidean_vector{0, 0, 0};
-		auto a3 = a1 + a2;
+		comp6771::euclidean_vector a3 = a1 + a2;
 		CHECK(a1 == a3);
 		a3 = a1 + comp6771::euclidean_vector{2, 2, 2};
 		CHECK(a3 == comp6771::euclidean_vector{3, 4, 5});
@@ -163,7 +172,7 @@ TEST_CASE("friend: + -") {
 	SECTION("regular subtraction") {
 		auto const a1 = comp6771::euclidean_vector{1, 2, 3.5};
 		auto const a2 = comp6771::euclidean_vector{0, 0, 0};
-		auto a3 = a1 - a2;
+		comp6771::euclidean_vector a3 = a1 - a2;
 		CHECK(a1 == a3);
 		a3 = a1 - comp6771::euclidean_vector{2, 2, 2};
 		CHECK(a3 == comp6771::euclidean_vector{-1, 0, 1.5});
@@ -203,14 +212,14 @@ TEST_CASE("friend: + -") {
 TEST_CASE("friend: * /") {
 	SECTION("regular multiplication") {
 		auto const a1 = comp6771::euclidean_vector{1, 2.2, 3};
-		auto a2 = a1 * 0;
+		comp6771::euclidean_vector a2 = a1 * 0;
 		CHECK(a2 == comp6771::euclidean_vector{0, 0, 0});
 		a2 = a1 * 3;
 		CHECK(a2 == comp6771::euclidean_vector{3, 6.6, 9});
 	}
 	SECTION("regular division") {
 		auto const a1 = comp6771::euclidean_vector{9, 6, 3};
-		auto a2 = a1 / 0.5;
+		comp6771::euclidean_vector a2 = a1 / 0.5;
 		CHECK(a2 == comp6771::euclidean_vector{18, 12, 6});
 		a2 = a1 / 3;
 		CHECK(a2 == comp6771::euclidean_vector{3, 2, 1});
@@ -236,13 +245,23 @@ TEST_CASE("copy assignment: should copy the vector in a new memory address") {
 	CHECK(a1 == a2); // same content
 }
 TEST_CASE("move assignment: move the contents of the original vector to the new vector") {
-	auto a1 = comp6771::euclidean_vector{1, 3, -2, -9.5};
-	auto a2 = comp6771::euclidean_vector();
-	auto const* address_of_contents_a1 = std::addressof(a1[0]);
-	a2 = std::move(a1);
-	auto const* address_of_contents_a2 = std::addressof(a2[0]);
-	CHECK(address_of_contents_a1 == address_of_contents_a2); // different memory address
-	CHECK(a2 == comp6771::euclidean_vector{1, 3, -2, -9.5});
+	SECTION("heap storage is handed over") {
+		auto const dimensions = comp6771::euclidean_vector::inline_capacity + 1;
+		auto const values = std::vector<double>(dimensions, -9.5);
+		auto a1 = comp6771::euclidean_vector(values.begin(), values.end());
+		auto a2 = comp6771::euclidean_vector();
+		auto const* address_of_contents_a1 = std::addressof(a1[0]);
+		a2 = std::move(a1);
+		auto const* address_of_contents_a2 = std::addressof(a2[0]);
+		CHECK(address_of_contents_a1 == address_of_contents_a2); // same memory address
+		CHECK(static_cast<std::vector<double>>(a2) == values);
+	}
+	SECTION("inline storage is copied") {
+		auto a1 = comp6771::euclidean_vector{1, 3, -2, -9.5};
+		auto a2 = comp6771::euclidean_vector();
+		a2 = std::move(a1);
+		CHECK(a2 == comp6771::euclidean_vector{1, 3, -2, -9.5});
+	}
 }
 TEST_CASE("subscripts") {
 	SECTION("non-const [] should surpport reading and modification") {
@@ -277,12 +296,18 @@ TEST_CASE("unary +: return a copy of current object") {
 		auto const* address_of_contents_a2 = std::addressof(a2[0]);
 		CHECK(address_of_contents_a1 != address_of_contents_a2);
 	}
-	SECTION("assign + to self should change the address") {
-		auto a1 = comp6771::euclidean_vector{1, 2, 5.3, 7.6};
+	SECTION("assign + to self should change the address of heap storage") {
+		auto const values = std::vector<double>(comp6771::euclidean_vector::inline_capacity + 1, 7.6);
+		auto a1 = comp6771::euclidean_vector(values.begin(), values.end());
 		auto const* address_of_contents_orig = std::addressof(a1[0]);
 		a1 = +a1;
 		auto const* address_of_contents_new = std::addressof(a1[0]);
 		CHECK(address_of_contents_orig != address_of_contents_new);
+		CHECK(static_cast<std::vector<double>>(a1) == values);
+	}
+	SECTION("assign + to self keeps the values of inline storage") {
+		auto a1 = comp6771::euclidean_vector{1, 2, 5.3, 7.6};
+		a1 = +a1;
 		CHECK(a1 == comp6771::euclidean_vector{1, 2, 5.3, 7.6});
 	}
 }
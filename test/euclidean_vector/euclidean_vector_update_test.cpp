@@ -0,0 +1,109 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include "allocation_counter.hpp"
+#include "vector_factory.hpp"
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cmath>
+
+namespace {
+	using comp6771::test::make_vector;
+
+	auto same_bits(comp6771::euclidean_vector const& x, comp6771::euclidean_vector const& y)
+	   -> bool {
+		return std::ranges::equal(x.magnitudes(), y.magnitudes());
+	}
+} // namespace
+
+TEST_CASE("updates: give the same values as the operator chains they replace") {
+	auto const dimensions = GENERATE(1, 7, 33, 1000);
+	auto const x = make_vector(dimensions, 1.0);
+	// kept away from zero so that it can be divided by
+	auto const original =
+	   comp6771::euclidean_vector(dimensions, [](int i) { return 2.0 + std::sin(2.0 + i); });
+	auto v = original;
+
+	SECTION("axpy") {
+		v.axpy(-0.5, x);
+		CHECK(v == comp6771::euclidean_vector(original + x * -0.5));
+	}
+	SECTION("axpby") {
+		v.axpby(3.0, x, 0.25);
+		CHECK(v == comp6771::euclidean_vector(x * 3.0 + original * 0.25));
+	}
+	SECTION("lerp") {
+		v.lerp(x, 0.25);
+		CHECK(v == comp6771::euclidean_vector(original * 0.75 + x * 0.25));
+		auto end = original;
+		CHECK(same_bits(end.lerp(x, 1.0), x));
+		auto start = original;
+		CHECK(same_bits(start.lerp(x, 0.0), original));
+	}
+	SECTION("normalize") {
+		v.normalize();
+		CHECK(same_bits(v, comp6771::unit(original)));
+		CHECK(comp6771::euclidean_norm(v) == Approx(1.0));
+	}
+	SECTION("scale_add") {
+		v.scale_add(2.0, -1.0);
+		auto const ones = comp6771::euclidean_vector(dimensions, 1.0);
+		CHECK(v == comp6771::euclidean_vector(original * 2.0 - ones));
+	}
+	SECTION("hadamard and divide") {
+		v.hadamard(x);
+		for (auto i = 0; i < dimensions; ++i) {
+			CHECK(v[i] == original[i] * x[i]);
+		}
+		v.divide(original);
+		for (auto i = 0; i < dimensions; ++i) {
+			CHECK(v[i] == Approx(x[i]));
+		}
+	}
+	SECTION("x may be the vector itself") {
+		v.axpy(1.0, v);
+		CHECK(same_bits(v, comp6771::euclidean_vector(original * 2.0)));
+		v.hadamard(v);
+		CHECK(v == comp6771::euclidean_vector(dimensions, [&original](int i) {
+			      return 4 * original[i] * original[i];
+		      }));
+	}
+}
+
+TEST_CASE("updates: never allocate, and keep the cached norm right") {
+	auto v = make_vector(1000, 0.0);
+	auto const x = make_vector(1000, 1.0);
+	auto const counter = comp6771::test::allocation_counter();
+	v.axpy(0.5, x).axpby(1.0, x, 0.5).lerp(x, 0.5).scale_add(2.0, 1.0).hadamard(x).divide(x);
+	v.normalize();
+	CHECK(counter.count() == 0);
+
+	// every update throws the cached norm away, or keeps it right
+	auto w = make_vector(1000, 0.0);
+	auto const stale = comp6771::euclidean_norm(w);
+	w.axpy(1.0, x);
+	CHECK(comp6771::euclidean_norm(w) != stale);
+	CHECK(comp6771::euclidean_norm(w.normalize()) == Approx(1.0));
+	w.scale_add(3.0, 0.0);
+	CHECK(comp6771::euclidean_norm(w) == Approx(3.0));
+}
+
+TEST_CASE("updates: throw the existing exceptions") {
+	auto v = comp6771::euclidean_vector{1.0, 2.0};
+	auto const longer = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+	auto const mismatch = Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not match");
+	CHECK_THROWS_MATCHES(v.axpy(1.0, longer), comp6771::euclidean_vector_error, mismatch);
+	CHECK_THROWS_MATCHES(v.axpby(1.0, longer, 1.0), comp6771::euclidean_vector_error, mismatch);
+	CHECK_THROWS_MATCHES(v.lerp(longer, 0.5), comp6771::euclidean_vector_error, mismatch);
+	CHECK_THROWS_MATCHES(v.hadamard(longer), comp6771::euclidean_vector_error, mismatch);
+	CHECK_THROWS_MATCHES(v.divide(longer), comp6771::euclidean_vector_error, mismatch);
+	CHECK(v == comp6771::euclidean_vector{1.0, 2.0});
+
+	CHECK_THROWS_MATCHES(comp6771::euclidean_vector(0).normalize(),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("euclidean_vector with no dimensions does not "
+	                                              "have a unit vector"));
+	CHECK_THROWS_MATCHES(comp6771::euclidean_vector(2).normalize(),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("euclidean_vector with zero euclidean normal does "
+	                                              "not have a unit vector"));
+}
@@ -0,0 +1,260 @@
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include "allocation_counter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("views refer to external memory") {
+	auto buffer = std::vector<double>{1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+	auto const v1 = comp6771::euclidean_vector_view(std::span(buffer).subspan(0, 3));
+	auto const v2 = comp6771::euclidean_vector_view(buffer.data() + 3, 3);
+
+	CHECK(v1.dimensions() == 3);
+	CHECK(v1.data() == buffer.data());
+	CHECK(v2[0] == 4.0);
+	CHECK_THROWS_MATCHES(v2.at(3),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Index X is not valid for this euclidean_vector "
+	                                              "object"));
+
+	v1[0] = 10.0;
+	CHECK(buffer[0] == 10.0);
+
+	// copying a view copies the reference, not the magnitudes
+	auto const v3 = v1;
+	CHECK(v3.data() == v1.data());
+	CHECK(comp6771::euclidean_vector_view().dimensions() == 0);
+}
+
+TEST_CASE("views of euclidean_vectors") {
+	auto a1 = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+	auto const view = comp6771::euclidean_vector_view(a1);
+	auto const const_view = comp6771::const_euclidean_vector_view(a1);
+	view[1] = 5.0;
+	CHECK(a1[1] == 5.0);
+	CHECK(const_view[1] == 5.0);
+
+	STATIC_REQUIRE(std::is_same_v<decltype(const_view[0]), double const&>);
+	STATIC_REQUIRE(not std::is_constructible_v<comp6771::euclidean_vector_view,
+	                                           comp6771::euclidean_vector const&>);
+	STATIC_REQUIRE(std::is_convertible_v<comp6771::euclidean_vector_view,
+	                                     comp6771::const_euclidean_vector_view>);
+	STATIC_REQUIRE(not std::is_convertible_v<comp6771::const_euclidean_vector_view,
+	                                         comp6771::euclidean_vector_view>);
+}
+
+TEST_CASE("writes through a view discard the vector's cached norm") {
+	auto a1 = comp6771::euclidean_vector{3.0, 4.0};
+	auto const view = comp6771::euclidean_vector_view(a1);
+	auto const other = comp6771::euclidean_vector{3.0, 4.0};
+	CHECK(comp6771::euclidean_norm(a1) == 5.0);
+
+	view[0] = 0.0;
+	CHECK(comp6771::euclidean_norm(a1) == 4.0);
+	view *= 2.0;
+	CHECK(comp6771::euclidean_norm(a1) == 8.0);
+	view /= 2.0;
+	CHECK(comp6771::euclidean_norm(a1) == 4.0);
+	view += other;
+	CHECK(comp6771::euclidean_norm(a1) == Approx(std::sqrt(73.0)));
+	view -= other;
+	CHECK(comp6771::euclidean_norm(a1) == 4.0);
+	view += other * 2.0;
+	CHECK(comp6771::euclidean_norm(a1) == Approx(std::sqrt(180.0)));
+	std::ranges::fill(view, 1.0);
+	CHECK(comp6771::euclidean_norm(a1) == Approx(std::sqrt(2.0)));
+	view.magnitudes()[1] = 0.0;
+	CHECK(comp6771::euclidean_norm(a1) == 1.0);
+}
+
+TEST_CASE("utility functions take views and vectors interchangeably") {
+	auto buffer = std::array{3.0, 4.0, 1.0, 2.0};
+	auto const view = comp6771::const_euclidean_vector_view(buffer.data(), 2);
+	auto const owned = comp6771::euclidean_vector{1.0, 2.0};
+
+	CHECK(comp6771::euclidean_norm(view) == Approx(5.0));
+	CHECK(comp6771::unit(view) == comp6771::euclidean_vector{0.6, 0.8});
+	CHECK(comp6771::dot(view, owned) == Approx(11.0));
+	CHECK(comp6771::dot(owned, view) == Approx(11.0));
+	CHECK(comp6771::dot(view, view) == Approx(25.0));
+	CHECK(comp6771::dot(owned, owned) == Approx(5.0));
+
+	auto const longer = comp6771::const_euclidean_vector_view(buffer.data(), 3);
+	CHECK_THROWS_MATCHES(comp6771::dot(view, longer),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not match"));
+	CHECK_THROWS_MATCHES(comp6771::euclidean_norm(comp6771::const_euclidean_vector_view()),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("euclidean_vector with no dimensions does not "
+	                                              "have a norm"));
+	auto zeros = std::array{0.0, 0.0};
+	CHECK_THROWS_MATCHES(comp6771::unit(comp6771::euclidean_vector_view(zeros)),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("euclidean_vector with zero euclidean normal does "
+	                                              "not have a unit vector"));
+}
+
+TEST_CASE("distances and similarities are computed without temporaries") {
+	// long enough that a temporary couldn't live in the small buffer
+	auto const a = comp6771::euclidean_vector(100, [](int i) { return std::sin(i); });
+	auto const b = comp6771::euclidean_vector(100, [](int i) { return std::cos(i); });
+	auto const counter = comp6771::test::allocation_counter();
+	auto const d = comp6771::distance(a, b);
+	auto const d2 = comp6771::squared_distance(a, b);
+	auto const l1 = comp6771::manhattan_distance(a, b);
+	auto const cosine = comp6771::cosine_similarity(a, b);
+	CHECK(counter.count() == 0);
+
+	CHECK(d == Approx(comp6771::euclidean_norm(a - b)));
+	CHECK(d2 == Approx(d * d));
+	auto expected_l1 = 0.0;
+	for (auto i = 0; i < a.dimensions(); ++i) {
+		expected_l1 += std::abs(a[i] - b[i]);
+	}
+	CHECK(l1 == Approx(expected_l1));
+	CHECK(cosine
+	      == Approx(comp6771::dot(a, b)
+	                / (comp6771::euclidean_norm(a) * comp6771::euclidean_norm(b))));
+
+	auto const small = comp6771::euclidean_vector{3.0, 4.0};
+	auto const origin = comp6771::euclidean_vector{0.0, 0.0};
+	CHECK(comp6771::distance(small, origin) == 5.0);
+	CHECK(comp6771::manhattan_distance(small, origin) == 7.0);
+	auto const opposite = comp6771::euclidean_vector(small * -2.0);
+	CHECK(comp6771::cosine_similarity(small, opposite) == Approx(-1.0));
+
+	CHECK_THROWS_MATCHES(comp6771::distance(a, small),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not match"));
+	CHECK_THROWS_MATCHES(comp6771::cosine_similarity(small, origin),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("euclidean_vector with zero euclidean normal does "
+	                                              "not have a unit vector"));
+}
+
+TEST_CASE("batch distances score a query against every candidate") {
+	auto const query = comp6771::euclidean_vector{1.0, 2.0, 2.0};
+	auto const candidates = std::vector<comp6771::euclidean_vector>{
+	   comp6771::euclidean_vector{1.0, 2.0, 2.0},
+	   comp6771::euclidean_vector{0.0, 0.0, 1.0},
+	   comp6771::euclidean_vector{-2.0, -4.0, -4.0},
+	};
+
+	auto const distances = comp6771::distance(query, candidates);
+	auto const squared = comp6771::squared_distance(query, candidates);
+	auto const manhattan = comp6771::manhattan_distance(query, candidates);
+	auto const cosines = comp6771::cosine_similarity(query, candidates);
+	REQUIRE(distances.size() == candidates.size());
+	for (auto i = std::size_t{0}; i < candidates.size(); ++i) {
+		CHECK(distances[i] == comp6771::distance(query, candidates[i]));
+		CHECK(squared[i] == comp6771::squared_distance(query, candidates[i]));
+		CHECK(manhattan[i] == comp6771::manhattan_distance(query, candidates[i]));
+		CHECK(cosines[i] == comp6771::cosine_similarity(query, candidates[i]));
+	}
+	CHECK(cosines[2] == Approx(-1.0));
+
+	SECTION("into a caller's buffer") {
+		auto result = std::vector<double>(candidates.size());
+		auto const counter = comp6771::test::allocation_counter();
+		comp6771::manhattan_distance(query, candidates, result);
+		CHECK(counter.count() == 0);
+		CHECK(result == manhattan);
+
+		auto too_short = std::vector<double>(2);
+		CHECK_THROWS_MATCHES(comp6771::distance(query, candidates, too_short),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Size of result does not match the number "
+		                                              "of candidates"));
+	}
+
+	SECTION("a mismatched candidate is caught before anything is written") {
+		auto mixed = candidates;
+		mixed.emplace_back(2);
+		auto result = std::vector<double>(mixed.size(), -1.0);
+		CHECK_THROWS_AS(comp6771::squared_distance(query, mixed, result),
+		                comp6771::euclidean_vector_error);
+		CHECK(std::ranges::count(result, -1.0) == 4);
+	}
+
+	SECTION("a zero candidate is caught before anything is written") {
+		auto mixed = candidates;
+		mixed.emplace_back(3);
+		auto result = std::vector<double>(mixed.size(), -1.0);
+		CHECK_THROWS_MATCHES(comp6771::cosine_similarity(query, mixed, result),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("euclidean_vector with zero euclidean normal "
+		                                              "does not have a unit vector"));
+		CHECK(std::ranges::count(result, -1.0) == 4);
+		auto const none = std::span<comp6771::euclidean_vector const>();
+		CHECK(comp6771::cosine_similarity(comp6771::euclidean_vector(3), none).empty());
+	}
+}
+
+TEST_CASE("arithmetic operators mix views and vectors") {
+	auto buffer = std::array{1.0, 2.0, 3.0};
+	auto const view = comp6771::const_euclidean_vector_view(buffer);
+	auto const owned = comp6771::euclidean_vector{4.0, 5.0, 6.0};
+
+	CHECK(comp6771::euclidean_vector(view + owned) == comp6771::euclidean_vector{5.0, 7.0, 9.0});
+	CHECK(owned - view == comp6771::euclidean_vector{3.0, 3.0, 3.0});
+	CHECK(view * 2.0 + view / 2.0 == comp6771::euclidean_vector{2.5, 5.0, 7.5});
+	CHECK(-view == comp6771::euclidean_vector{-1.0, -2.0, -3.0});
+	CHECK(view == comp6771::euclidean_vector{1.0, 2.0, 3.0});
+	CHECK(view != owned);
+	CHECK(fmt::format("{}", view) == "[1 2 3]");
+
+	auto a1 = comp6771::euclidean_vector(3);
+	a1 = view;
+	CHECK(a1 == view);
+	a1 += view;
+	CHECK(a1 == comp6771::euclidean_vector{2.0, 4.0, 6.0});
+
+	// an explicit conversion copies the magnitudes
+	auto const copy = comp6771::euclidean_vector(view);
+	buffer[0] = 100.0;
+	CHECK(copy[0] == 1.0);
+	STATIC_REQUIRE(
+	   not std::is_convertible_v<comp6771::const_euclidean_vector_view, comp6771::euclidean_vector>);
+}
+
+TEST_CASE("compound operators write through mutable views") {
+	auto buffer = std::vector<double>{1.0, 2.0, 3.0, 4.0};
+	auto const front = comp6771::euclidean_vector_view(buffer.data(), 2);
+	auto const back = comp6771::const_euclidean_vector_view(buffer.data() + 2, 2);
+
+	front += back;
+	CHECK(buffer == std::vector<double>{4.0, 6.0, 3.0, 4.0});
+	front -= comp6771::euclidean_vector{1.0, 1.0};
+	CHECK(buffer == std::vector<double>{3.0, 5.0, 3.0, 4.0});
+	front *= 2.0;
+	CHECK(buffer == std::vector<double>{6.0, 10.0, 3.0, 4.0});
+	front /= 2.0;
+	CHECK(buffer == std::vector<double>{3.0, 5.0, 3.0, 4.0});
+	front += back * 2.0 - back;
+	CHECK(buffer == std::vector<double>{6.0, 9.0, 3.0, 4.0});
+	front -= back + back;
+	CHECK(buffer == std::vector<double>{0.0, 1.0, 3.0, 4.0});
+
+	CHECK_THROWS_MATCHES(front /= 0.0,
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Invalid vector division by 0"));
+	auto const longer = comp6771::euclidean_vector(3);
+	CHECK_THROWS_MATCHES(front += longer,
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not match"));
+}
+
+TEST_CASE("views are borrowed sized ranges") {
+	STATIC_REQUIRE(std::ranges::contiguous_range<comp6771::euclidean_vector_view>);
+	STATIC_REQUIRE(std::ranges::sized_range<comp6771::const_euclidean_vector_view>);
+	STATIC_REQUIRE(std::ranges::borrowed_range<comp6771::euclidean_vector_view>);
+}
@@ -0,0 +1,95 @@
+#include "comp6771/fixed_euclidean_vector.hpp"
+
+#include "allocation_counter.hpp"
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+namespace {
+	template<typename L, typename R>
+	concept addable = requires(L l, R r) {
+		l + r;
+	};
+
+	template<typename L, typename R>
+	concept dottable = requires(L l, R r) {
+		dot(l, r);
+	};
+} // namespace
+
+// Everything below the norm is evaluated by the compiler.
+TEST_CASE("fixed_euclidean_vector: usable in constant expressions") {
+	using vec3 = comp6771::fixed_euclidean_vector<3>;
+	constexpr auto a1 = vec3(1, 2, 3);
+	constexpr auto a2 = vec3(1.5);
+
+	static_assert(vec3::dimensions() == 3);
+	static_assert(vec3() == vec3(0, 0, 0));
+	static_assert(a1[2] == 3);
+	static_assert(a1 + a2 == vec3(2.5, 3.5, 4.5));
+	static_assert(a1 - a2 == vec3(-0.5, 0.5, 1.5));
+	static_assert(a1 * 2 == vec3(2, 4, 6));
+	static_assert(a1 / 2 == vec3(0.5, 1, 1.5));
+	static_assert(-a1 == vec3(-1, -2, -3));
+	static_assert(a1 != a2);
+	static_assert(dot(a1, a2) == 9);
+	static_assert(a1.at(1) == 2);
+	static_assert([] {
+		auto v = vec3(1, 1, 1);
+		v += vec3(1, 2, 3);
+		v *= 2;
+		v.at(0) = 0;
+		return v;
+	}() == vec3(0, 6, 8));
+	SUCCEED();
+}
+
+TEST_CASE("fixed_euclidean_vector: mixing dimensions doesn't compile") {
+	using comp6771::fixed_euclidean_vector;
+	static_assert(addable<fixed_euclidean_vector<3>, fixed_euclidean_vector<3>>);
+	static_assert(not addable<fixed_euclidean_vector<3>, fixed_euclidean_vector<4>>);
+	static_assert(not addable<fixed_euclidean_vector<3>, comp6771::euclidean_vector>);
+	static_assert(dottable<fixed_euclidean_vector<2>, fixed_euclidean_vector<2>>);
+	static_assert(not dottable<fixed_euclidean_vector<2>, fixed_euclidean_vector<3>>);
+	static_assert(not std::is_constructible_v<fixed_euclidean_vector<3>, double, double>);
+	static_assert(sizeof(fixed_euclidean_vector<4>) == 4 * sizeof(double));
+	SUCCEED();
+}
+
+TEST_CASE("fixed_euclidean_vector: runtime operations") {
+	using vec2 = comp6771::fixed_euclidean_vector<2>;
+	auto const counter = comp6771::test::allocation_counter();
+	auto a1 = vec2(3, 4);
+	CHECK(comp6771::euclidean_norm(a1) == 5);
+	CHECK(comp6771::unit(a1) == vec2(0.6, 0.8));
+	a1 /= 0.5;
+	CHECK(a1 == vec2(6, 8));
+	CHECK(counter.count() == 0);
+
+	CHECK_THROWS_MATCHES(a1 /= 0,
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Invalid vector division by 0"));
+	CHECK_THROWS_MATCHES(comp6771::unit(vec2()),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("euclidean_vector with zero euclidean normal does "
+	                                              "not have a unit vector"));
+	CHECK_THROWS_AS(a1.at(2), comp6771::euclidean_vector_error);
+	CHECK_THROWS_AS(comp6771::euclidean_norm(comp6771::fixed_euclidean_vector<0>()),
+	                comp6771::euclidean_vector_error);
+	CHECK(fmt::format("{}", a1) == "[6 8]");
+	CHECK(fmt::format("{}", comp6771::fixed_euclidean_vector<0>()) == "[]");
+}
+
+TEST_CASE("fixed_euclidean_vector: explicit conversions to and from euclidean_vector") {
+	using vec3 = comp6771::fixed_euclidean_vector<3>;
+	auto const dynamic = comp6771::euclidean_vector{1, 2, 3};
+	auto const fixed = vec3(dynamic);
+	CHECK(fixed == vec3(1, 2, 3));
+	CHECK(static_cast<comp6771::euclidean_vector>(fixed) == dynamic);
+	static_assert(not std::is_convertible_v<comp6771::euclidean_vector, vec3>);
+	static_assert(not std::is_convertible_v<vec3, comp6771::euclidean_vector>);
+
+	CHECK_THROWS_MATCHES(vec3(comp6771::euclidean_vector{1, 2}),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not match"));
+}
@@ -0,0 +1,172 @@
+#include "comp6771/shared_euclidean_vector.hpp"
+
+#include "vector_factory.hpp"
+
+#include <catch2/catch.hpp>
+#include <functional>
+#include <memory_resource>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+	using comp6771::test::make_vector;
+
+	auto shares_buffer(comp6771::shared_euclidean_vector const& x,
+	                   comp6771::shared_euclidean_vector const& y) -> bool {
+		return x.magnitudes().data() == y.magnitudes().data();
+	}
+} // namespace
+
+TEST_CASE("shared_euclidean_vector copies share one buffer") {
+	auto const original = make_vector(100, 0.0);
+	auto v = original;
+	auto const* const storage = v.magnitudes().data();
+	auto const a = comp6771::shared_euclidean_vector(std::move(v));
+	CHECK(a.magnitudes().data() == storage);
+	CHECK(a.use_count() == 1);
+
+	auto b = a;
+	auto c = comp6771::shared_euclidean_vector();
+	c = +b;
+	CHECK(shares_buffer(a, b));
+	CHECK(shares_buffer(a, c));
+	CHECK(a.use_count() == 3);
+	CHECK(a == c);
+	CHECK(c.vector() == original);
+	CHECK(comp6771::euclidean_norm(b.vector()) == Approx(comp6771::euclidean_norm(original)));
+
+	auto const& alias = c;
+	c = alias;
+	CHECK(a.use_count() == 3);
+	{
+		auto const d = std::move(c);
+		CHECK(c.dimensions() == 0);
+		CHECK(c.use_count() == 0);
+		CHECK(a.use_count() == 3);
+	}
+	CHECK(a.use_count() == 2);
+	b = comp6771::shared_euclidean_vector(comp6771::euclidean_vector{1.0, 2.0});
+	CHECK(a.use_count() == 1);
+	CHECK(a.vector() == original);
+}
+
+TEST_CASE("shared_euclidean_vector detaches on the first write") {
+	auto const original = make_vector(100, 0.0);
+	auto const a = comp6771::shared_euclidean_vector(original);
+	auto b = a;
+	auto const ones = comp6771::euclidean_vector(100, 1.0);
+
+	using write = std::function<void(comp6771::shared_euclidean_vector&)>;
+	auto const [name, write_to] = GENERATE_COPY(
+	   std::pair<char const*, write>("operator[]", [](auto& x) { x[3] = 42.0; }),
+	   std::pair<char const*, write>("at", [](auto& x) { x.at(3) = 42.0; }),
+	   std::pair<char const*, write>("magnitudes", [](auto& x) { x.magnitudes()[3] = 42.0; }),
+	   std::pair<char const*, write>("+=", [ones](auto& x) { x += ones; }),
+	   std::pair<char const*, write>("-=", [ones](auto& x) { x -= ones; }),
+	   std::pair<char const*, write>("+= shared", [](auto& x) { x += x; }),
+	   std::pair<char const*, write>("-= shared", [](auto& x) { x -= x; }),
+	   std::pair<char const*, write>("*=", [](auto& x) { x *= 2.0; }),
+	   std::pair<char const*, write>("/=", [](auto& x) { x /= 2.0; }));
+	CAPTURE(name);
+
+	write_to(b);
+	CHECK(not shares_buffer(a, b));
+	CHECK(a.use_count() == 1);
+	CHECK(b.use_count() == 1);
+	CHECK(a.vector() == original);
+	CHECK(b != a);
+
+	// b has the buffer to itself now, so further writes happen in place
+	auto const* const storage = b.magnitudes().data();
+	write_to(b);
+	CHECK(b.magnitudes().data() == storage);
+}
+
+TEST_CASE("shared_euclidean_vector detaches into the same memory_resource") {
+	auto arena = std::pmr::monotonic_buffer_resource();
+	auto const a = comp6771::shared_euclidean_vector(comp6771::euclidean_vector(100, 1.5, &arena));
+	auto b = a;
+	b[0] = 2.5;
+	CHECK(not shares_buffer(a, b));
+	CHECK(b.vector().get_allocator().resource() == &arena);
+	CHECK(a.vector().get_allocator().resource() == &arena);
+}
+
+TEST_CASE("shared_euclidean_vector writes keep the shared cached norm right") {
+	auto const a = comp6771::shared_euclidean_vector(comp6771::euclidean_vector{3.0, 4.0});
+	CHECK(comp6771::euclidean_norm(a.vector()) == 5.0);
+	auto b = a;
+	b *= 2.0;
+	CHECK(comp6771::euclidean_norm(b.vector()) == 10.0);
+	b[0] = 0.0;
+	CHECK(comp6771::euclidean_norm(b.vector()) == 8.0);
+	CHECK(comp6771::euclidean_norm(a.vector()) == 5.0);
+}
+
+TEST_CASE("shared_euclidean_vector throws before detaching") {
+	auto const a = comp6771::shared_euclidean_vector(comp6771::euclidean_vector{1.0, 2.0});
+	auto b = a;
+	auto const longer = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+	auto const mismatch = Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not match");
+	CHECK_THROWS_MATCHES(b += longer, comp6771::euclidean_vector_error, mismatch);
+	CHECK_THROWS_MATCHES(b -= longer, comp6771::euclidean_vector_error, mismatch);
+	CHECK_THROWS_MATCHES(b /= 0.0,
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Invalid vector division by 0"));
+	CHECK_THROWS_MATCHES(b.at(2),
+	                     comp6771::euclidean_vector_error,
+	                     Catch::Matchers::Message("Index X is not valid for this euclidean_vector "
+	                                              "object"));
+	CHECK(shares_buffer(a, b));
+	CHECK(a.use_count() == 2);
+}
+
+TEST_CASE("a moved-from shared_euclidean_vector can be written to") {
+	auto a = comp6771::shared_euclidean_vector(comp6771::euclidean_vector{1.0, 2.0});
+	auto const b = std::move(a);
+	CHECK(a.magnitudes().empty());
+	a *= 2.0;
+	CHECK(a.dimensions() == 0);
+	CHECK(a.use_count() == 1);
+	a = b;
+	CHECK(a == b);
+}
+
+TEST_CASE("shared_euclidean_vector copies can be read and written from different threads") {
+	auto const original = make_vector(10'000, 0.0);
+	auto const shared = comp6771::shared_euclidean_vector(original);
+	auto const expected = std::accumulate(original.magnitudes().begin(),
+	                                      original.magnitudes().end(),
+	                                      0.0);
+
+	auto constexpr thread_count = 8;
+	// not std::vector<bool>, whose elements can't be written by different threads
+	auto results = std::vector<int>(thread_count);
+	auto threads = std::vector<std::thread>();
+	for (auto t = 0; t < thread_count; ++t) {
+		threads.emplace_back([&shared, &results, &expected, t] {
+			auto ok = true;
+			for (auto i = 0; i < 100; ++i) {
+				auto copy = shared;
+				auto const readable = std::as_const(copy).magnitudes();
+				ok = ok and std::accumulate(readable.begin(), readable.end(), 0.0) == expected;
+				// odd threads write, and so detach, while even ones only read
+				if (t % 2 == 1) {
+					copy[0] += 1.0;
+					ok = ok and copy.use_count() == 1;
+				}
+			}
+			results[static_cast<std::size_t>(t)] = ok ? 1 : 0;
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	for (auto const ok : results) {
+		CHECK(ok == 1);
+	}
+	CHECK(shared.use_count() == 1);
+	CHECK(shared.vector() == original);
+}
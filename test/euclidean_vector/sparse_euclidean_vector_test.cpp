@@ -0,0 +1,156 @@
+#include "comp6771/sparse_euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_memory.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace {
+	// every stride-th magnitude of a vector of the given dimensions, starting at offset
+	auto make_sparse(int dimensions, int stride, int offset) -> comp6771::sparse_euclidean_vector {
+		auto indices = std::vector<int>();
+		auto values = std::vector<double>();
+		for (auto i = offset; i < dimensions; i += stride) {
+			indices.push_back(i);
+			values.push_back(std::sin(i) + 2.0);
+		}
+		return comp6771::sparse_euclidean_vector(dimensions, indices, values);
+	}
+} // namespace
+
+TEST_CASE("sparse_euclidean_vector construction and conversion") {
+	SECTION("from a euclidean_vector and back") {
+		auto const dense = comp6771::euclidean_vector{0.0, 1.5, 0.0, 0.0, -2.0, 0.0};
+		auto const sparse = comp6771::sparse_euclidean_vector(dense);
+		CHECK(sparse.dimensions() == 6);
+		CHECK(sparse.non_zeros() == 2);
+		CHECK(std::vector<int>(sparse.indices().begin(), sparse.indices().end())
+		      == std::vector<int>{1, 4});
+		CHECK(sparse[4] == -2.0);
+		CHECK(sparse[3] == 0.0);
+		CHECK(static_cast<comp6771::euclidean_vector>(sparse) == dense);
+		CHECK_THROWS_MATCHES(sparse.at(6),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Index X is not valid for this "
+		                                              "euclidean_vector object"));
+	}
+
+	SECTION("from indices and values") {
+		auto const indices = std::vector<int>{2, 5, 9};
+		auto const values = std::vector<double>{1.0, 2.0, 3.0};
+		auto const sparse = comp6771::sparse_euclidean_vector(10, indices, values);
+		CHECK(sparse.at(9) == 3.0);
+		CHECK(sparse.at(8) == 0.0);
+
+		auto const unsorted = std::vector<int>{2, 9, 5};
+		CHECK_THROWS_MATCHES(comp6771::sparse_euclidean_vector(10, unsorted, values),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Indices of a sparse_euclidean_vector must be "
+		                                              "strictly increasing"));
+		CHECK_THROWS_MATCHES(comp6771::sparse_euclidean_vector(9, indices, values),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Index X is not valid for this "
+		                                              "euclidean_vector object"));
+		CHECK_THROWS_AS(comp6771::sparse_euclidean_vector(10, indices, std::span(values).first(2)),
+		                comp6771::euclidean_vector_error);
+	}
+
+	SECTION("copy and move") {
+		auto pool = comp6771::pmr::pool_resource();
+		auto v1 = comp6771::sparse_euclidean_vector(make_sparse(100, 7, 3), &pool);
+		CHECK(v1.get_allocator().resource() == &pool);
+		auto const v2 = v1;
+		CHECK(v2 == v1);
+		CHECK(v2.get_allocator().resource() != &pool);
+
+		auto v3 = std::move(v1);
+		CHECK(v3 == v2);
+		CHECK(v1.dimensions() == 0); // NOLINT(bugprone-use-after-move)
+		CHECK(v1.non_zeros() == 0); // NOLINT(bugprone-use-after-move)
+	}
+}
+
+TEST_CASE("sparse_euclidean_vector comparison") {
+	auto const dense = comp6771::euclidean_vector{0.0, 1.0, 0.0, 3.0};
+	auto const sparse = comp6771::sparse_euclidean_vector(dense);
+	CHECK(sparse == dense);
+	CHECK(dense == sparse);
+	CHECK(sparse != comp6771::euclidean_vector{0.0, 1.0, 0.0, 3.1});
+	CHECK(sparse != comp6771::euclidean_vector{0.0, 1.0, 0.0});
+
+	// an explicitly stored zero, and differences within epsilon, still compare equal
+	auto const indices = std::vector<int>{0, 1, 3};
+	auto const values = std::vector<double>{0.0, 1.00000001, 3.0};
+	auto const explicit_zero = comp6771::sparse_euclidean_vector(4, indices, values);
+	CHECK(explicit_zero == sparse);
+	CHECK(sparse == explicit_zero);
+	CHECK(explicit_zero == dense);
+	CHECK(explicit_zero != comp6771::sparse_euclidean_vector(4));
+}
+
+TEST_CASE("sparse_euclidean_vector utility functions") {
+	auto const dimensions = 1000;
+	// the first pair have similar numbers of non-zeros, so dot merges them; the second pair are
+	// far enough apart that it gallops
+	auto const stride = GENERATE(3, 97);
+	auto const x = make_sparse(dimensions, 2, 1);
+	auto const y = make_sparse(dimensions, stride, 0);
+	auto const dense_x = static_cast<comp6771::euclidean_vector>(x);
+	auto const dense_y = static_cast<comp6771::euclidean_vector>(y);
+
+	SECTION("dot") {
+		auto const expected = comp6771::dot(dense_x, dense_y);
+		CHECK(comp6771::dot(x, y) == Approx(expected));
+		CHECK(comp6771::dot(y, x) == Approx(expected));
+		CHECK(comp6771::dot(x, dense_y) == Approx(expected));
+		CHECK(comp6771::dot(dense_x, y) == Approx(expected));
+		CHECK_THROWS_MATCHES(comp6771::dot(x, comp6771::sparse_euclidean_vector(dimensions + 1)),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not "
+		                                              "match"));
+	}
+
+	SECTION("euclidean_norm") {
+		CHECK(comp6771::euclidean_norm(x) == Approx(comp6771::euclidean_norm(dense_x)));
+		CHECK_THROWS_MATCHES(comp6771::euclidean_norm(comp6771::sparse_euclidean_vector()),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("euclidean_vector with no dimensions does not "
+		                                              "have a norm"));
+	}
+
+	SECTION("sparse += sparse") {
+		auto sum = x;
+		sum += y;
+		CHECK(sum == comp6771::euclidean_vector(dense_x + dense_y));
+		sum -= y;
+		CHECK(sum == dense_x);
+		sum -= x;
+		CHECK(sum == comp6771::euclidean_vector(dimensions));
+
+		auto twice = x;
+		twice += twice;
+		CHECK(twice == comp6771::euclidean_vector(dense_x * 2));
+		twice /= 2;
+		CHECK(twice == x);
+		CHECK_THROWS_AS(twice += comp6771::sparse_euclidean_vector(2),
+		                comp6771::euclidean_vector_error);
+	}
+
+	SECTION("dense += sparse") {
+		auto dense = dense_x;
+		auto const expected = comp6771::euclidean_vector(dense_x + dense_y);
+		CHECK(comp6771::euclidean_norm(dense) > 0); // caches the norm
+		dense += y;
+		CHECK(dense == expected);
+		CHECK(comp6771::euclidean_norm(dense) == Approx(comp6771::euclidean_norm(expected)));
+
+		auto view = comp6771::euclidean_vector_view(dense);
+		view -= y;
+		CHECK(dense == dense_x);
+		CHECK_THROWS_MATCHES(dense += comp6771::sparse_euclidean_vector(2),
+		                     comp6771::euclidean_vector_error,
+		                     Catch::Matchers::Message("Dimensions of LHS(X) and RHS(Y) do not "
+		                                              "match"));
+	}
+}